@@ -0,0 +1,26 @@
+dnl
+dnl Check for zstd
+dnl
+
+AC_ARG_WITH([zstd], AS_HELP_STRING([--without-zstd],[do not build with libzstd for zstd content compression]),
+            [ with_zstd=${withval} ], [ with_zstd=yes ])
+if test "x$with_zstd" != "xno"; then
+  PKG_CHECK_EXISTS([libzstd],[zstd_found=yes],[zstd_found=no])
+  if test x"$zstd_found" = xyes; then
+    PKG_CHECK_MODULES([libzstd],[libzstd],[zstd_found=yes])
+    ZSTD_CFLAGS="`$PKG_CONFIG --cflags libzstd`"
+    ZSTD_LIBS="`$PKG_CONFIG --libs libzstd`"
+  fi
+fi
+
+if test x"$zstd_found" = xyes; then
+  AC_DEFINE(HAVE_ZSTD,,[define if building with zstd])
+  USE_ZSTD=yes
+  opt_features_yes="$opt_features_yes\n   * zstd content compression via libzstd"
+else
+  opt_features_no="$opt_features_no\n   * zstd content compression via libzstd"
+fi
+
+AC_SUBST(ZSTD_CFLAGS)
+AC_SUBST(ZSTD_LIBS)
+AC_SUBST(USE_ZSTD)
@@ -163,6 +163,7 @@ class Target
       when :intl             then c(:LIBINTL_LIBS)
       when :cmark            then c(:CMARK_LIBS)
       when :dvdread          then c(:DVDREAD_LIBS)
+      when :zstd             then c(:ZSTD_LIBS)
       when :boost_filesystem then c(:BOOST_FILESYSTEM_LIB)
       when :boost_system     then c(:BOOST_SYSTEM_LIB)
       when :pugixml          then c?(:PUGIXML_INTERNAL) ? [ '-Llib/pugixml/src', '-lpugixml' ] : c(:PUGIXML_LIBS)
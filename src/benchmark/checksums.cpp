@@ -0,0 +1,175 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for the checksum algorithms
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/checksums/base.h"
+#include "common/checksums/batch.h"
+#include "common/thread_pool.h"
+
+namespace {
+
+using algorithm_e = mtx::checksum::algorithm_e;
+
+void
+BM_checksum(::benchmark::State &state,
+            algorithm_e algorithm) {
+  auto data = mtx::benchmark::random_data(state.range(0), 42);
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::checksum::calculate(algorithm, *data));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+// Checksums of large buffers such as whole attachments or frames are
+// usually calculated in pieces, e.g. while reading from a file.
+void
+BM_checksum_incremental(::benchmark::State &state,
+                        algorithm_e algorithm) {
+  auto data       = mtx::benchmark::random_data(8 * 1024 * 1024, 42);
+  auto chunk_size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    auto worker = mtx::checksum::for_algorithm(algorithm);
+
+    for (auto pos = 0u; pos < data->get_size(); pos += chunk_size)
+      worker->add(data->get_buffer() + pos, std::min(chunk_size, data->get_size() - pos));
+
+    ::benchmark::DoNotOptimize(worker->finish().get_result());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+// Large buffers split up over the number of threads given as the
+// argument.
+void
+BM_checksum_parallel(::benchmark::State &state,
+                     algorithm_e algorithm) {
+  auto data = mtx::benchmark::random_data(64 * 1024 * 1024, 42);
+  mtx::thread_pool_c pool{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::checksum::for_algorithm(algorithm)->add_parallel(*data, pool).finish().get_result());
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+// Frame-sized pieces of a larger buffer as mkvinfo sees them when
+// checksumming every frame: a mix of small audio & larger video frames.
+std::vector<std::pair<std::size_t, std::size_t>> const &
+frames() {
+  static auto s_frames = []() {
+    std::vector<std::pair<std::size_t, std::size_t>> frames;
+    auto state = 4711u;
+
+    for (auto pos = std::size_t{}; pos < 16 * 1024 * 1024;) {
+      state     = state * 1103515245u + 12345u;
+      auto size = (frames.size() % 3) ? 300 + (state >> 16) % 1500 : 5000 + (state >> 8) % 60000;
+      size      = std::min<std::size_t>(size, 16 * 1024 * 1024 - pos);
+
+      frames.emplace_back(pos, size);
+      pos += size;
+    }
+
+    return frames;
+  }();
+
+  return s_frames;
+}
+
+void
+BM_checksum_frames_inline(::benchmark::State &state,
+                          algorithm_e algorithm) {
+  auto data = mtx::benchmark::random_data(16 * 1024 * 1024, 42);
+
+  for (auto _ : state)
+    for (auto const &[pos, size] : frames())
+      ::benchmark::DoNotOptimize(mtx::checksum::calculate(algorithm, data->get_buffer() + pos, size));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+// The argument is the number of threads; 0 means no thread pool.
+void
+BM_checksum_frames_batch(::benchmark::State &state,
+                         algorithm_e algorithm) {
+  auto data = mtx::benchmark::random_data(16 * 1024 * 1024, 42);
+  auto pool = state.range(0) ? std::make_unique<mtx::thread_pool_c>(state.range(0)) : std::unique_ptr<mtx::thread_pool_c>{};
+
+  for (auto _ : state) {
+    mtx::checksum::batch_c batch{algorithm, pool.get()};
+
+    for (auto const &[pos, size] : frames())
+      batch.add(data->get_buffer() + pos, size);
+
+    ::benchmark::DoNotOptimize(batch.get_results());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+void
+register_benchmarks() {
+  std::vector<std::pair<std::string, algorithm_e>> algorithms{
+    { "adler32",       algorithm_e::adler32       },
+    { "crc8_atm",      algorithm_e::crc8_atm      },
+    { "crc16_ansi",    algorithm_e::crc16_ansi    },
+    { "crc16_ccitt",   algorithm_e::crc16_ccitt   },
+    { "crc16_002d",    algorithm_e::crc16_002d    },
+    { "crc32_ieee",    algorithm_e::crc32_ieee    },
+    { "crc32_ieee_le", algorithm_e::crc32_ieee_le },
+    { "md5",           algorithm_e::md5           },
+  };
+
+  for (auto const &[name, algorithm] : algorithms) {
+    ::benchmark::RegisterBenchmark(fmt::format("BM_checksum/{0}", name).c_str(), BM_checksum, algorithm)
+      ->Arg(188)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+    ::benchmark::RegisterBenchmark(fmt::format("BM_checksum_incremental/{0}", name).c_str(), BM_checksum_incremental, algorithm)
+      ->Arg(1024)->Arg(64 * 1024);
+  }
+
+  ::benchmark::RegisterBenchmark("BM_checksum_parallel/crc32_ieee_le", BM_checksum_parallel, algorithm_e::crc32_ieee_le)
+    ->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+  for (auto const &[name, algorithm] : std::vector<std::pair<std::string, algorithm_e>>{ { "adler32", algorithm_e::adler32 }, { "md5", algorithm_e::md5 } }) {
+    ::benchmark::RegisterBenchmark(fmt::format("BM_checksum_frames_inline/{0}", name).c_str(), BM_checksum_frames_inline, algorithm)
+      ->UseRealTime();
+
+    ::benchmark::RegisterBenchmark(fmt::format("BM_checksum_frames_batch/{0}", name).c_str(), BM_checksum_frames_batch, algorithm)
+      ->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+  }
+
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".mkv", ".mka", ".ts", ".m2ts", ".mp4" })) {
+    ::benchmark::RegisterBenchmark(mtx::benchmark::recorded_name("BM_checksum/crc32_ieee_le", file_name).c_str(), [file_name](::benchmark::State &state) {
+      auto data = mtx::benchmark::read_file(file_name);
+
+      for (auto _ : state)
+        ::benchmark::DoNotOptimize(mtx::checksum::calculate(algorithm_e::crc32_ieee_le, *data));
+
+      state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+    });
+  }
+}
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  register_benchmarks();
+  return mtx::benchmark::run(argc, argv);
+}
@@ -0,0 +1,285 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for the content compression methods
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/compression.h"
+#include "common/endian.h"
+#include "common/strings/editing.h"
+
+namespace {
+
+using frames_t = std::vector<memory_cptr>;
+
+struct method_t {
+  std::string name;
+  compression_method_e method;
+  compression_parameters_t parameters;
+};
+
+std::vector<method_t>
+methods() {
+  std::vector<method_t> list{
+    { "zlib", COMPRESSION_ZLIB, {} },
+  };
+
+#if defined(HAVE_ZSTD)
+  list.push_back({ "zstd",      COMPRESSION_ZSTD, {}           });
+  list.push_back({ "zstd_19",   COMPRESSION_ZSTD, { 19, false } });
+  list.push_back({ "zstd_dict", COMPRESSION_ZSTD, { {}, true }  });
+#endif
+
+  return list;
+}
+
+void
+put_pgs_run(std::vector<uint8_t> &data,
+            uint8_t color,
+            unsigned int length) {
+  if ((1 == length) && color) {
+    data.push_back(color);
+    return;
+  }
+
+  data.push_back(0x00);
+
+  if (length < 64)
+    data.push_back((color ? 0x80 : 0x00) | length);
+  else {
+    data.push_back((color ? 0xc0 : 0x40) | (length >> 8));
+    data.push_back(length & 0xff);
+  }
+
+  if (color)
+    data.push_back(color);
+}
+
+// Display sets of HDMV PGS subtitles, each one consisting of a
+// presentation composition segment and an object definition segment
+// with a run-length encoded bitmap of two lines of glyph-like shapes.
+frames_t
+create_pgs_frames(unsigned int num_frames) {
+  constexpr auto width  = 960u;
+  constexpr auto height = 110u;
+
+  std::mt19937 generator{3141};
+  frames_t frames;
+
+  for (auto frame_idx = 0u; frame_idx < num_frames; ++frame_idx) {
+    std::vector<uint8_t> bitmap(width * height, 0);
+    auto num_glyphs = 20u + generator() % 40;
+
+    for (auto glyph_idx = 0u; glyph_idx < num_glyphs; ++glyph_idx) {
+      auto line  = glyph_idx % 2;
+      auto left  = 40 + (glyph_idx / 2) * 28;
+      auto shape = generator();
+
+      for (auto y = 0u; y < 44; ++y)
+        for (auto x = 0u; x < 22; ++x) {
+          auto set = (shape >> ((y / 6) * 4 + (x / 6))) & 1;
+          if (set)
+            bitmap[(line * 55 + 5 + y) * width + left + x] = (x == 0) || (x == 21) || (y == 0) || (y == 43) ? 2 : 1;
+        }
+    }
+
+    std::vector<uint8_t> ods{ 0x15, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0xc0 };
+    for (auto y = 0u; y < height; ++y) {
+      auto row = &bitmap[y * width];
+
+      for (auto x = 0u; x < width;) {
+        auto length = 1u;
+        while (((x + length) < width) && (row[x + length] == row[x]) && (length < 0x3fff))
+          ++length;
+
+        put_pgs_run(ods, row[x], length);
+        x += length;
+      }
+
+      ods.insert(ods.end(), { 0x00, 0x00 });
+    }
+
+    put_uint16_be(&ods[1], ods.size() - 3);
+
+    std::vector<uint8_t> frame{ 0x16, 0x00, 0x13, 0x07, 0x80, 0x04, 0x38, 0x10, static_cast<uint8_t>(frame_idx >> 8), static_cast<uint8_t>(frame_idx), 0x80, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x03, 0xc0, 0x03, 0xc8 };
+    frame.insert(frame.end(), ods.begin(), ods.end());
+    frame.insert(frame.end(), { 0x80, 0x00, 0x00 });
+
+    frames.emplace_back(memory_c::clone(frame.data(), frame.size()));
+  }
+
+  return frames;
+}
+
+// SSA/ASS events the way they're stored in Matroska blocks.
+frames_t
+create_ssa_frames(unsigned int num_frames) {
+  static std::vector<std::string> const s_words{
+    "the", "you", "I", "to", "a", "and", "what", "is", "it", "that", "of", "in", "we", "me", "this", "don't", "know", "he", "have", "your",
+    "right", "here", "not", "for", "be", "on", "no", "just", "can", "was", "with", "all", "there", "are", "okay", "going", "get", "come",
+  };
+
+  std::mt19937 generator{2718};
+  frames_t frames;
+
+  for (auto frame_idx = 0u; frame_idx < num_frames; ++frame_idx) {
+    auto text      = fmt::format("{0},0,{1},,0,0,0,,", frame_idx, frame_idx % 5 ? "Default" : "Sign");
+    auto num_words = 3 + generator() % 12;
+
+    if (!(frame_idx % 7))
+      text += "{\\i1}";
+
+    for (auto word_idx = 0u; word_idx < num_words; ++word_idx) {
+      text += word_idx ? " " : "";
+      text += s_words[generator() % s_words.size()];
+      if (word_idx == (num_words / 2))
+        text += generator() % 2 ? ",\\N" : "";
+    }
+
+    text += generator() % 3 ? "." : "?";
+
+    frames.emplace_back(memory_c::clone(text.data(), text.size()));
+  }
+
+  return frames;
+}
+
+// Every display set of a recorded PGS file, i.e. all segments up to
+// and including the end segment without the "PG" & timestamp headers.
+frames_t
+read_pgs_frames(std::string const &file_name) {
+  auto data = mtx::benchmark::read_file(file_name);
+  auto ptr  = data->get_buffer();
+  auto size = data->get_size();
+  std::vector<uint8_t> frame;
+  frames_t frames;
+
+  for (auto pos = 0u; (pos + 13) <= size;) {
+    if ((ptr[pos] != 'P') || (ptr[pos + 1] != 'G'))
+      break;
+
+    auto segment_size = 3u + get_uint16_be(&ptr[pos + 11]);
+    if ((pos + 10 + segment_size) > size)
+      break;
+
+    frame.insert(frame.end(), &ptr[pos + 10], &ptr[pos + 10 + segment_size]);
+    if (0x80 == ptr[pos + 10]) {
+      frames.emplace_back(memory_c::clone(frame.data(), frame.size()));
+      frame.clear();
+    }
+
+    pos += 10 + segment_size;
+  }
+
+  return frames;
+}
+
+frames_t
+read_ssa_frames(std::string const &file_name) {
+  auto data = mtx::benchmark::read_file(file_name);
+  frames_t frames;
+
+  for (auto const &line : mtx::string::split(data->to_string(), "\n")) {
+    if (!balg::istarts_with(line, "Dialogue:"))
+      continue;
+
+    auto text = balg::trim_right_copy(line.substr(9));
+    frames.emplace_back(memory_c::clone(text.data(), text.size()));
+  }
+
+  return frames;
+}
+
+int64_t
+total_size(frames_t const &frames) {
+  int64_t size{};
+
+  for (auto const &frame : frames)
+    size += frame->get_size();
+
+  return size;
+}
+
+// The compressor is created anew for each iteration so that training
+// the dictionary is part of the measurement.
+void
+BM_compress(::benchmark::State &state,
+            frames_t const &frames,
+            method_t const &method) {
+  int64_t compressed_size{};
+
+  for (auto _ : state) {
+    auto compressor = compressor_c::create(method.method);
+    compressor->set_parameters(method.parameters);
+    compressed_size = 0;
+
+    for (auto const &frame : frames)
+      compressed_size += compressor->compress(frame)->get_size();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * total_size(frames));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * frames.size());
+  state.counters["ratio"] = static_cast<double>(compressed_size) / total_size(frames);
+}
+
+void
+BM_decompress(::benchmark::State &state,
+              frames_t const &frames,
+              method_t const &method) {
+  auto compressor = compressor_c::create(method.method);
+  compressor->set_parameters(method.parameters);
+
+  frames_t compressed;
+  for (auto const &frame : frames)
+    compressed.emplace_back(compressor->compress(frame));
+
+  for (auto _ : state)
+    for (auto const &frame : compressed)
+      ::benchmark::DoNotOptimize(compressor->decompress(frame));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * total_size(frames));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * frames.size());
+}
+
+void
+register_benchmarks(std::string const &name,
+                    frames_t const &frames) {
+  if (frames.empty())
+    return;
+
+  for (auto const &method : methods()) {
+    ::benchmark::RegisterBenchmark(fmt::format("BM_compress/{0}/{1}",   method.name, name).c_str(), BM_compress,   frames, method)->Unit(::benchmark::kMillisecond);
+    ::benchmark::RegisterBenchmark(fmt::format("BM_decompress/{0}/{1}", method.name, name).c_str(), BM_decompress, frames, method)->Unit(::benchmark::kMillisecond);
+  }
+}
+
+void
+register_benchmarks() {
+  register_benchmarks("pgs", create_pgs_frames(500));
+  register_benchmarks("ssa", create_ssa_frames(2000));
+
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".sup" }))
+    register_benchmarks(mtx::benchmark::recorded_name("pgs", file_name), read_pgs_frames(file_name));
+
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".ass", ".ssa" }))
+    register_benchmarks(mtx::benchmark::recorded_name("ssa", file_name), read_ssa_frames(file_name));
+}
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  register_benchmarks();
+  return mtx::benchmark::run(argc, argv);
+}
@@ -0,0 +1,86 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for writing the cues
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <matroska/KaxSegment.h>
+
+#include "benchmark/helpers.h"
+#include "common/doc_type_version_handler.h"
+#include "common/ebml.h"
+#include "common/mm_null_io.h"
+#include "merge/cues.h"
+#include "merge/output_control.h"
+
+namespace {
+
+// Adds cue points for the number of tracks given as the second
+// argument, one every 500 ms per track, just like mkvmerge does for
+// audio tracks. Points of different tracks are added in slightly
+// mixed order.
+void
+add_cue_points(cues_c &cues,
+               std::size_t num_points,
+               std::size_t num_tracks) {
+  for (auto idx = 0u; idx < num_points; ++idx) {
+    auto track_idx = idx % num_tracks;
+    auto point_idx = idx / num_tracks;
+    auto timestamp = (point_idx * 500 + (track_idx ? 20 - track_idx : 0)) * 1'000'000ull;
+
+    libmatroska::KaxCuePoint point;
+    get_child<libmatroska::KaxCueTime>(point).SetValue(timestamp / g_timestamp_scale);
+
+    auto &positions = get_child<libmatroska::KaxCueTrackPositions>(point);
+    get_child<libmatroska::KaxCueTrack>(positions).SetValue(track_idx + 1);
+    get_child<libmatroska::KaxCueClusterPosition>(positions).SetValue(point_idx * 1'500'000ull);
+
+    cues.add(point);
+  }
+}
+
+void
+BM_cues_write(::benchmark::State &state) {
+  auto num_points = static_cast<std::size_t>(state.range(0));
+  auto num_tracks = static_cast<std::size_t>(state.range(1));
+
+  g_cue_writing_requested    = true;
+  g_kax_segment              = std::make_unique<libmatroska::KaxSegment>();
+  g_doc_type_version_handler = std::make_unique<mtx::doc_type_version_handler_c>();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+
+    mm_null_io_c out{"null"};
+    libmatroska::KaxSeekHead seek_head;
+    cues_c cues;
+
+    g_kax_segment->WriteHead(out, 8);
+    add_cue_points(cues, num_points, num_tracks);
+
+    state.ResumeTiming();
+
+    cues.write(out, seek_head);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * num_points);
+}
+
+BENCHMARK(BM_cues_write)->Args({ 10'000, 1 })->Args({ 100'000, 1 })->Args({ 100'000, 4 })->Args({ 1'000'000, 2 })->Unit(::benchmark::kMillisecond);
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  return mtx::benchmark::run(argc, argv);
+}
@@ -0,0 +1,158 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for reading EBML elements
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/kax_file.h"
+#include "common/mm_mem_io.h"
+#include "common/vint.h"
+
+namespace {
+
+class benchmark_kax_file_c: public kax_file_c {
+public:
+  benchmark_kax_file_c(mm_io_c &in)
+    : kax_file_c{in}
+  {
+  }
+
+  using kax_file_c::read_one_element;
+};
+
+void
+put_id(std::vector<uint8_t> &data,
+       uint32_t id) {
+  auto num_bytes = id > 0xffffff ? 4 : id > 0xffff ? 3 : id > 0xff ? 2 : 1;
+
+  for (auto idx = num_bytes; idx > 0; --idx)
+    data.push_back((id >> ((idx - 1) * 8)) & 0xff);
+}
+
+// Sizes are always coded with eight bytes so that they can be
+// written before the content is known.
+void
+put_size(std::vector<uint8_t> &data,
+         uint64_t size) {
+  data.push_back(0x01);
+  for (auto shift = 48; shift >= 0; shift -= 8)
+    data.push_back((size >> shift) & 0xff);
+}
+
+// Level 1 clusters of a single track with a cluster timestamp and
+// SimpleBlocks of the size given as the argument each, i.e. the
+// layout mkvmerge writes.
+memory_cptr
+create_clusters(std::size_t block_size) {
+  constexpr auto num_clusters       = 200u;
+  constexpr auto blocks_per_cluster = 50u;
+
+  auto payload = mtx::benchmark::random_data(block_size, 1234);
+  std::vector<uint8_t> data;
+
+  for (auto cluster_idx = 0u; cluster_idx < num_clusters; ++cluster_idx) {
+    std::vector<uint8_t> content;
+
+    put_id(content, 0xe7);      // ClusterTimestamp
+    put_size(content, 4);
+    for (auto shift = 24; shift >= 0; shift -= 8)
+      content.push_back(((cluster_idx * 1000) >> shift) & 0xff);
+
+    for (auto block_idx = 0u; block_idx < blocks_per_cluster; ++block_idx) {
+      put_id(content, 0xa3);    // SimpleBlock
+      put_size(content, block_size + 4);
+      content.push_back(0x81);  // track number 1
+      content.push_back(((block_idx * 20) >> 8) & 0xff);
+      content.push_back((block_idx * 20) & 0xff);
+      content.push_back(!block_idx ? 0x80 : 0x00);
+      content.insert(content.end(), payload->get_buffer(), payload->get_buffer() + block_size);
+    }
+
+    put_id(data, 0x1f43b675);   // Cluster
+    put_size(data, content.size());
+    data.insert(data.end(), content.begin(), content.end());
+  }
+
+  return memory_c::clone(data.data(), data.size());
+}
+
+int64_t
+read_all_elements(::benchmark::State &state,
+                  memory_cptr const &data,
+                  uint64_t start_position) {
+  int64_t num_elements{};
+
+  for (auto _ : state) {
+    mm_mem_io_c in{*data};
+    benchmark_kax_file_c file{in};
+
+    in.setFilePointer(start_position);
+
+    while (auto element = file.read_one_element()) {
+      ::benchmark::DoNotOptimize(element);
+      ++num_elements;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * (data->get_size() - start_position));
+  state.counters["elements"] = ::benchmark::Counter(num_elements, ::benchmark::Counter::kIsRate);
+
+  return num_elements;
+}
+
+void
+BM_read_one_element(::benchmark::State &state) {
+  read_all_elements(state, create_clusters(state.range(0)), 0);
+}
+
+// Reads all level 1 elements of a recorded Matroska file starting at
+// the segment's data.
+void
+BM_read_one_element_recorded(::benchmark::State &state,
+                             std::string const &file_name) {
+  auto data = mtx::benchmark::read_file(file_name);
+  mm_mem_io_c in{*data};
+
+  if (vint_c::read_ebml_id(in).m_value != 0x1a45dfa3) {
+    state.SkipWithError("not a Matroska file");
+    return;
+  }
+
+  in.skip(vint_c::read(in).m_value);
+
+  if (vint_c::read_ebml_id(in).m_value != 0x18538067) {
+    state.SkipWithError("no segment found");
+    return;
+  }
+
+  vint_c::read(in);
+
+  read_all_elements(state, data, in.getFilePointer());
+}
+
+BENCHMARK(BM_read_one_element)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+void
+register_benchmarks() {
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".mkv", ".mka", ".mks", ".webm" }))
+    ::benchmark::RegisterBenchmark(mtx::benchmark::recorded_name("BM_read_one_element", file_name).c_str(), BM_read_one_element_recorded, file_name);
+}
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  register_benchmarks();
+  return mtx::benchmark::run(argc, argv);
+}
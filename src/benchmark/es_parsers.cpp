@@ -0,0 +1,176 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for the AVC/HEVC elementary stream parsers
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/avc/es_parser.h"
+#include "common/hevc/es_parser.h"
+
+namespace {
+
+using mtx::benchmark::put_signed_golomb;
+using mtx::benchmark::put_unsigned_golomb;
+
+void
+append_nalu(std::vector<uint8_t> &stream,
+            mtx::bits::writer_c &w) {
+  // rbsp_stop_one_bit & alignment
+  w.put_bit(true);
+  w.byte_align();
+
+  auto nalu = w.get_buffer();
+
+  stream.insert(stream.end(), { 0x00, 0x00, 0x00, 0x01 });
+  stream.insert(stream.end(), nalu->get_buffer(), nalu->get_buffer() + nalu->get_size());
+}
+
+// A baseline profile AVC stream with 320x240 pixels, picture order
+// count type 0 and one IDR frame followed by 29 P frames per group of
+// pictures. The slice data is random but free of zero bytes so that
+// no emulation prevention is needed.
+memory_cptr
+create_avc_stream(unsigned int num_frames) {
+  std::vector<uint8_t> stream;
+
+  {
+    mtx::bits::writer_c w;
+    w.put_bits(8, 0x67);        // nal_ref_idc 3, nal_unit_type 7 (SPS)
+    w.put_bits(8, 66);          // profile_idc: baseline
+    w.put_bits(8, 0xc0);        // constraint_set0/1_flag
+    w.put_bits(8, 30);          // level_idc
+    put_unsigned_golomb(w, 0);  // seq_parameter_set_id
+    put_unsigned_golomb(w, 12); // log2_max_frame_num_minus4
+    put_unsigned_golomb(w, 0);  // pic_order_cnt_type
+    put_unsigned_golomb(w, 12); // log2_max_pic_order_cnt_lsb_minus4
+    put_unsigned_golomb(w, 1);  // max_num_ref_frames
+    w.put_bit(false);           // gaps_in_frame_num_value_allowed_flag
+    put_unsigned_golomb(w, 19); // pic_width_in_mbs_minus1
+    put_unsigned_golomb(w, 14); // pic_height_in_map_units_minus1
+    w.put_bit(true);            // frame_mbs_only_flag
+    w.put_bit(true);            // direct_8x8_inference_flag
+    w.put_bit(false);           // frame_cropping_flag
+    w.put_bit(false);           // vui_parameters_present_flag
+    append_nalu(stream, w);
+  }
+
+  {
+    mtx::bits::writer_c w;
+    w.put_bits(8, 0x68);        // nal_ref_idc 3, nal_unit_type 8 (PPS)
+    put_unsigned_golomb(w, 0);  // pic_parameter_set_id
+    put_unsigned_golomb(w, 0);  // seq_parameter_set_id
+    w.put_bit(false);           // entropy_coding_mode_flag
+    w.put_bit(false);           // bottom_field_pic_order_in_frame_present_flag
+    put_unsigned_golomb(w, 0);  // num_slice_groups_minus1
+    put_unsigned_golomb(w, 0);  // num_ref_idx_l0_default_active_minus1
+    put_unsigned_golomb(w, 0);  // num_ref_idx_l1_default_active_minus1
+    w.put_bit(false);           // weighted_pred_flag
+    w.put_bits(2, 0);           // weighted_bipred_idc
+    put_signed_golomb(w, 0);    // pic_init_qp_minus26
+    put_signed_golomb(w, 0);    // pic_init_qs_minus26
+    put_signed_golomb(w, 0);    // chroma_qp_index_offset
+    w.put_bit(true);            // deblocking_filter_control_present_flag
+    w.put_bit(false);           // constrained_intra_pred_flag
+    w.put_bit(false);           // redundant_pic_cnt_present_flag
+    append_nalu(stream, w);
+  }
+
+  auto slice_data = mtx::benchmark::random_data(20000, 815, 1);
+
+  for (auto frame = 0u; frame < num_frames; ++frame) {
+    auto frame_in_gop = frame % 30;
+    auto is_idr       = !frame_in_gop;
+
+    mtx::bits::writer_c w;
+    w.put_bits(8, is_idr ? 0x65 : 0x41);     // nal_ref_idc, nal_unit_type 5 (IDR) or 1
+    put_unsigned_golomb(w, 0);               // first_mb_in_slice
+    put_unsigned_golomb(w, is_idr ? 7 : 5);  // slice_type: I or P
+    put_unsigned_golomb(w, 0);               // pic_parameter_set_id
+    w.put_bits(16, frame_in_gop);            // frame_num
+    if (is_idr)
+      put_unsigned_golomb(w, frame / 30);    // idr_pic_id
+    w.put_bits(16, frame_in_gop * 2);        // pic_order_cnt_lsb
+    w.byte_align();
+
+    auto data_size = is_idr ? 20000u : 2000u + (frame_in_gop * 97) % 1500;
+    for (auto idx = 0u; idx < data_size; ++idx)
+      w.put_bits(8, slice_data->get_buffer()[idx]);
+
+    append_nalu(stream, w);
+  }
+
+  return memory_c::clone(stream.data(), stream.size());
+}
+
+// Feeds the whole stream in pieces of the size given as the argument
+// just like the elementary stream readers do.
+template<typename Tparser>
+void
+parse_stream(::benchmark::State &state,
+             memory_cptr const &stream) {
+  auto chunk_size = static_cast<std::size_t>(state.range(0));
+  int64_t num_frames{};
+
+  for (auto _ : state) {
+    Tparser parser;
+
+    for (auto pos = 0u; pos < stream->get_size(); pos += chunk_size) {
+      auto size = std::min(chunk_size, stream->get_size() - pos);
+      parser.add_bytes(memory_c::clone(stream->get_buffer() + pos, size));
+
+      while (parser.frame_available()) {
+        parser.get_frame();
+        ++num_frames;
+      }
+    }
+
+    parser.flush();
+
+    while (parser.frame_available()) {
+      parser.get_frame();
+      ++num_frames;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * stream->get_size());
+  state.counters["frames"] = ::benchmark::Counter(num_frames, ::benchmark::Counter::kIsRate);
+}
+
+void
+BM_avc_es_parser(::benchmark::State &state) {
+  parse_stream<mtx::avc::es_parser_c>(state, create_avc_stream(300));
+}
+
+BENCHMARK(BM_avc_es_parser)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(1024 * 1024);
+
+void
+register_benchmarks() {
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".h264", ".264", ".avc" }))
+    ::benchmark::RegisterBenchmark(mtx::benchmark::recorded_name("BM_avc_es_parser", file_name).c_str(), [file_name](::benchmark::State &state) {
+      parse_stream<mtx::avc::es_parser_c>(state, mtx::benchmark::read_file(file_name));
+    })->Arg(64 * 1024);
+
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".h265", ".265", ".hevc" }))
+    ::benchmark::RegisterBenchmark(mtx::benchmark::recorded_name("BM_hevc_es_parser", file_name).c_str(), [file_name](::benchmark::State &state) {
+      parse_stream<mtx::hevc::es_parser_c>(state, mtx::benchmark::read_file(file_name));
+    })->Arg(64 * 1024);
+}
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  register_benchmarks();
+  return mtx::benchmark::run(argc, argv);
+}
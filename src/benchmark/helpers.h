@@ -0,0 +1,116 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   helper functions for the benchmarks
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "common/bit_writer.h"
+#include "common/mm_file_io.h"
+
+// All synthetic inputs are generated from fixed seeds so that results
+// of different runs & commits can be compared with each other. Recorded
+// inputs are read from the directory named by the environment variable
+// MTX_BENCHMARK_DATA_DIR; benchmarks for them are registered in
+// addition to the synthetic ones.
+namespace mtx::benchmark {
+
+inline memory_cptr
+random_data(std::size_t size,
+            uint32_t seed,
+            uint8_t min_value = 0) {
+  auto data = memory_c::alloc(size);
+  auto ptr  = data->get_buffer();
+  std::mt19937 generator{seed};
+  std::uniform_int_distribution<unsigned int> distribution{min_value, 255};
+
+  for (auto idx = 0u; idx < size; ++idx)
+    ptr[idx] = distribution(generator);
+
+  return data;
+}
+
+inline void
+put_unsigned_golomb(mtx::bits::writer_c &w,
+                    uint64_t value) {
+  auto num_bits = 0u;
+
+  for (auto tmp = value + 1; tmp > 1; tmp >>= 1)
+    ++num_bits;
+
+  w.put_bits(num_bits, 0);
+  w.put_bits(num_bits + 1, value + 1);
+}
+
+inline void
+put_signed_golomb(mtx::bits::writer_c &w,
+                  int64_t value) {
+  put_unsigned_golomb(w, value > 0 ? value * 2 - 1 : -value * 2);
+}
+
+inline std::vector<std::string>
+find_recorded_inputs(std::vector<std::string> const &extensions) {
+  std::vector<std::string> file_names;
+
+  auto dir = getenv("MTX_BENCHMARK_DATA_DIR");
+  if (!dir || !*dir)
+    return file_names;
+
+  boost::system::error_code ec;
+
+  for (boost::filesystem::recursive_directory_iterator it{dir, ec}, end; !ec && (it != end); it.increment(ec)) {
+    if (!boost::filesystem::is_regular_file(it->path()))
+      continue;
+
+    auto extension = balg::to_lower_copy(it->path().extension().string());
+    if (std::find(extensions.begin(), extensions.end(), extension) != extensions.end())
+      file_names.emplace_back(it->path().string());
+  }
+
+  std::sort(file_names.begin(), file_names.end());
+
+  return file_names;
+}
+
+inline memory_cptr
+read_file(std::string const &file_name) {
+  mm_file_io_c in{file_name};
+  return in.read(in.get_size());
+}
+
+inline std::string
+recorded_name(std::string const &prefix,
+              std::string const &file_name) {
+  return fmt::format("{0}/recorded:{1}", prefix, boost::filesystem::path{file_name}.filename().string());
+}
+
+inline int
+run(int argc,
+    char **argv) {
+  mtx_common_init("mtxbenchmark", argv[0]);
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+
+  return 0;
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for the buffered I/O classes
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/mm_mem_io.h"
+#include "common/mm_null_io.h"
+#include "common/mm_proxy_io.h"
+#include "common/mm_read_buffer_io.h"
+#include "common/mm_write_buffer_io.h"
+
+namespace {
+
+constexpr std::size_t s_total_size = 32 * 1024 * 1024;
+
+// Reads the whole input in pieces of the size given as the argument,
+// e.g. 188 bytes for MPEG transport stream packets.
+void
+read_all(::benchmark::State &state,
+         mm_io_cptr const &in) {
+  auto read_size = static_cast<std::size_t>(state.range(0));
+  auto buffer    = memory_c::alloc(read_size);
+  auto total     = in->get_size();
+
+  for (auto _ : state) {
+    in->setFilePointer(0);
+
+    for (auto pos = 0ll; pos < total; pos += read_size)
+      ::benchmark::DoNotOptimize(in->read(buffer->get_buffer(), read_size));
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * total);
+}
+
+void
+BM_read_buffer_io(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_total_size, 1);
+  auto in   = std::make_shared<mm_read_buffer_io_c>(std::make_shared<mm_mem_io_c>(*data));
+
+  read_all(state, in);
+}
+
+void
+BM_read_buffer_io_recorded(::benchmark::State &state,
+                           std::string const &file_name) {
+  auto in = std::make_shared<mm_read_buffer_io_c>(std::make_shared<mm_file_io_c>(file_name));
+
+  read_all(state, in);
+}
+
+// Writes pieces of the size given as the first argument to a write
+// buffer discarding everything. The second argument is the number of
+// buffers used for asynchronous writing.
+void
+BM_write_buffer_io(::benchmark::State &state) {
+  auto write_size = static_cast<std::size_t>(state.range(0));
+  auto data       = mtx::benchmark::random_data(write_size, 2);
+
+  for (auto _ : state) {
+    auto out = std::make_shared<mm_write_buffer_io_c>(std::make_shared<mm_null_io_c>("null"), 5 * 1024 * 1024, state.range(1));
+
+    for (auto written = 0u; written < s_total_size; written += write_size)
+      out->write(data->get_buffer(), write_size);
+
+    out->close();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_total_size);
+}
+
+BENCHMARK(BM_read_buffer_io)->Arg(4)->Arg(188)->Arg(4 * 1024)->Arg(64 * 1024);
+BENCHMARK(BM_write_buffer_io)->Args({ 4, 0 })->Args({ 188, 0 })->Args({ 64 * 1024, 0 })->Args({ 188, 4 })->Args({ 64 * 1024, 4 });
+
+void
+register_benchmarks() {
+  for (auto const &file_name : mtx::benchmark::find_recorded_inputs({ ".mkv", ".mka", ".ts", ".m2ts", ".mp4" }))
+    ::benchmark::RegisterBenchmark(mtx::benchmark::recorded_name("BM_read_buffer_io", file_name).c_str(), BM_read_buffer_io_recorded, file_name)
+      ->Arg(188)->Arg(64 * 1024);
+}
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  register_benchmarks();
+  return mtx::benchmark::run(argc, argv);
+}
@@ -0,0 +1,75 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for the MPEG NALU/RBSP conversion functions
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/mpeg.h"
+
+namespace {
+
+constexpr std::size_t s_size = 256 * 1024;
+
+// Random data in which every 'distance'th byte pair is zero. The
+// pairs are followed by 0x03 for NALUs, i.e. they're emulation
+// prevention sequences, or by an arbitrary byte for RBSPs.
+memory_cptr
+create_data(std::size_t distance,
+            bool nalu) {
+  auto data = mtx::benchmark::random_data(s_size, 4711, 1);
+  auto ptr  = data->get_buffer();
+
+  if (!distance)
+    return data;
+
+  for (auto pos = distance; (pos + 3) <= s_size; pos += distance) {
+    ptr[pos]     = 0x00;
+    ptr[pos + 1] = 0x00;
+    ptr[pos + 2] = nalu ? 0x03 : (ptr[pos + 2] & 0x03);
+  }
+
+  return data;
+}
+
+void
+BM_nalu_to_rbsp(::benchmark::State &state) {
+  auto data = create_data(state.range(0), true);
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::mpeg::nalu_to_rbsp(data));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+void
+BM_rbsp_to_nalu(::benchmark::State &state) {
+  auto data = create_data(state.range(0), false);
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::mpeg::rbsp_to_nalu(data));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * data->get_size());
+}
+
+// The argument is the distance between two zero byte pairs; 0 means
+// that there are none.
+BENCHMARK(BM_nalu_to_rbsp)->Arg(0)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+BENCHMARK(BM_rbsp_to_nalu)->Arg(0)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  return mtx::benchmark::run(argc, argv);
+}
@@ -0,0 +1,105 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for PCM byte swapping and channel remapping
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/bluray/lpcm.h"
+#include "common/bswap.h"
+
+namespace {
+
+// 40 ms of 48 kHz audio with eight 32-bit channels, the largest
+// packets the PCM packetizer creates for Blu-ray LPCM.
+constexpr std::size_t s_size = 48 * 40 * 8 * 4;
+
+void
+BM_swap_buffer(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+  auto size = s_size / state.range(0) * state.range(0);
+
+  for (auto _ : state)
+    mtx::bytes::swap_buffer(data->get_buffer(), data->get_buffer(), size, state.range(0));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+void
+BM_swap_buffer_scalar(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+  auto size = s_size / state.range(0) * state.range(0);
+
+  for (auto _ : state)
+    mtx::bytes::swap_buffer_scalar(data->get_buffer(), data->get_buffer(), size, state.range(0));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+// Arguments: bytes per channel, number of channels
+void
+BM_remap_channels(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+  auto size = s_size / (state.range(0) * state.range(1)) * (state.range(0) * state.range(1));
+
+  for (auto _ : state)
+    mtx::bluray::lpcm::remap_channels(data->get_buffer(), size, state.range(0), state.range(1));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+void
+BM_remap_channels_scalar(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+  auto size = s_size / (state.range(0) * state.range(1)) * (state.range(0) * state.range(1));
+
+  for (auto _ : state)
+    mtx::bluray::lpcm::remap_channels_scalar(data->get_buffer(), size, state.range(0), state.range(1));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+// Arguments: bytes per channel, number of input channels; the last one is removed
+void
+BM_remove_channels(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::bluray::lpcm::remove_channels(data->get_buffer(), s_size, state.range(0), state.range(1), state.range(1) - 1));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+void
+BM_remove_channels_scalar(::benchmark::State &state) {
+  auto data = mtx::benchmark::random_data(s_size, 4711);
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(mtx::bluray::lpcm::remove_channels_scalar(data->get_buffer(), s_size, state.range(0), state.range(1), state.range(1) - 1));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+BENCHMARK(BM_swap_buffer)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(BM_swap_buffer_scalar)->Arg(2)->Arg(3)->Arg(4);
+BENCHMARK(BM_remap_channels)->Args({ 2, 6 })->Args({ 3, 6 })->Args({ 3, 8 })->Args({ 4, 8 });
+BENCHMARK(BM_remap_channels_scalar)->Args({ 2, 6 })->Args({ 3, 6 })->Args({ 3, 8 })->Args({ 4, 8 });
+BENCHMARK(BM_remove_channels)->Args({ 2, 8 })->Args({ 3, 8 });
+BENCHMARK(BM_remove_channels_scalar)->Args({ 2, 8 })->Args({ 3, 8 });
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  return mtx::benchmark::run(argc, argv);
+}
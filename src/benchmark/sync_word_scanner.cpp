@@ -0,0 +1,123 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   benchmarks for searching the sync words of audio frame headers
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "benchmark/helpers.h"
+#include "common/aac.h"
+#include "common/ac3.h"
+#include "common/dts.h"
+#include "common/mp3.h"
+#include "common/sync_word_scanner.h"
+
+namespace {
+
+// The amount of data file type probing examines.
+constexpr std::size_t s_size = 128 * 1024;
+
+mtx::sync_word_scanner_c const s_scanner{
+  { 0x0b77, 0xffff, 2, 0 },
+  { 0x770b, 0xffff, 2, 0 },
+};
+
+// Random data without any valid frame, i.e. the worst case for
+// probing and for resyncing after damaged parts of a stream.
+memory_cptr const &
+garbage() {
+  static auto s_data = mtx::benchmark::random_data(s_size, 4711);
+  return s_data;
+}
+
+void
+BM_scan(::benchmark::State &state) {
+  auto const &data = garbage();
+
+  for (auto _ : state)
+    for (auto pos = s_scanner.find(data->get_buffer(), s_size); pos != mtx::sync_word_scanner_c::npos; pos = s_scanner.find(data->get_buffer(), s_size, pos + 1))
+      ::benchmark::DoNotOptimize(pos);
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+void
+BM_scan_scalar(::benchmark::State &state) {
+  auto const &data = garbage();
+
+  for (auto _ : state)
+    for (auto pos = s_scanner.find_scalar(data->get_buffer(), s_size); pos != mtx::sync_word_scanner_c::npos; pos = s_scanner.find_scalar(data->get_buffer(), s_size, pos + 1))
+      ::benchmark::DoNotOptimize(pos);
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+void
+BM_ac3_parser_resync(::benchmark::State &state) {
+  auto const &data = garbage();
+
+  for (auto _ : state) {
+    mtx::ac3::parser_c parser;
+    parser.add_bytes(data->get_buffer(), s_size);
+    parser.flush();
+    ::benchmark::DoNotOptimize(parser.frame_available());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+template<typename Tfunction>
+void
+probe(::benchmark::State &state,
+      Tfunction const &find_consecutive_frames) {
+  auto const &data = garbage();
+
+  for (auto _ : state)
+    ::benchmark::DoNotOptimize(find_consecutive_frames(data->get_buffer(), s_size));
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * s_size);
+}
+
+void
+BM_ac3_probe(::benchmark::State &state) {
+  probe(state, [](uint8_t const *buffer, std::size_t size) { return mtx::ac3::parser_c{}.find_consecutive_frames(buffer, size, 8); });
+}
+
+void
+BM_aac_probe(::benchmark::State &state) {
+  probe(state, [](uint8_t const *buffer, std::size_t size) { return mtx::aac::parser_c::find_consecutive_frames(buffer, size, 8); });
+}
+
+void
+BM_dts_probe(::benchmark::State &state) {
+  probe(state, [](uint8_t const *buffer, std::size_t size) { return mtx::dts::find_consecutive_headers(buffer, size, 8); });
+}
+
+void
+BM_mp3_probe(::benchmark::State &state) {
+  probe(state, [](uint8_t const *buffer, std::size_t size) { return find_consecutive_mp3_headers(buffer, size, 8); });
+}
+
+BENCHMARK(BM_scan);
+BENCHMARK(BM_scan_scalar);
+BENCHMARK(BM_ac3_parser_resync);
+BENCHMARK(BM_ac3_probe);
+BENCHMARK(BM_aac_probe);
+BENCHMARK(BM_dts_probe);
+BENCHMARK(BM_mp3_probe);
+
+}
+
+int
+main(int argc,
+     char **argv) {
+  return mtx::benchmark::run(argc, argv);
+}
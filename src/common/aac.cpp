@@ -25,9 +25,20 @@
 #include "common/list_utils.h"
 #include "common/mp4.h"
 #include "common/strings/formatting.h"
+#include "common/sync_word_scanner.h"
 
 namespace mtx::aac {
 
+// Positions at which an ADTS or LOAS/LATM header may start. Only the
+// first two bytes are required for the ADTS parser to reject a
+// position, hence the shorter patterns.
+static mtx::sync_word_scanner_c const s_adts_scanner{ { ADTS_SYNC_WORD >> 8, ADTS_SYNC_WORD_MASK >> 8, 2, 0 } };
+static mtx::sync_word_scanner_c const s_loas_scanner{ { LOAS_SYNC_WORD >> 8, LOAS_SYNC_WORD_MASK >> 8, 2, 0 } };
+static mtx::sync_word_scanner_c const s_any_header_scanner{
+  { ADTS_SYNC_WORD, ADTS_SYNC_WORD_MASK, 3, 0 },
+  { LOAS_SYNC_WORD, LOAS_SYNC_WORD_MASK, 3, 0 },
+};
+
 // See ISO/IEC 14496-3, table 1.16 — Sampling Frequency Index
 static std::array<unsigned int, 16> const s_sampling_freq = {
   96000, 88200, 64000, 48000, 44100, 32000,
@@ -863,6 +874,19 @@ parser_c::parse() {
       m_garbage_size += num_bytes;
       if (!m_num_frames_found && m_require_frame_at_first_byte)
         break;
+
+      // Decoding would fail at each position up to the next sync word
+      // or until too few bytes are left for a header.
+      if ((m_multiplex_type == adts_multiplex) || (m_multiplex_type == loas_latm_multiplex)) {
+        auto adts           = m_multiplex_type == adts_multiplex;
+        auto last_position  = buffer_size - std::min<size_t>(buffer_size, adts ? 1 : 2);
+        auto next_position  = std::max<size_t>(std::min((adts ? s_adts_scanner : s_loas_scanner).find(buffer, buffer_size, position), last_position), position);
+        auto num_skipped    = next_position - position;
+
+        position                 += num_skipped;
+        m_parsed_stream_position += num_skipped;
+        m_garbage_size           += num_skipped;
+      }
     }
 
     if (m_abort_after_num_frames && (m_num_frames_found >= m_abort_after_num_frames))
@@ -899,16 +923,15 @@ parser_c::find_consecutive_frames(uint8_t const *buffer,
                                   size_t num_required_frames) {
   static auto s_debug = debugging_option_c{"aac_consecutive_frames"};
 
-  for (int base = 0; (base + 8) < static_cast<int>(buffer_size); ++base) {
+  for (auto base = s_any_header_scanner.find(buffer, buffer_size);
+       (base != mtx::sync_word_scanner_c::npos) && ((base + 8) < buffer_size);
+       base = s_any_header_scanner.find(buffer, buffer_size, base + 1)) {
     mxdebug_if(s_debug, fmt::format("Starting search for {1} headers with base {0}, buffer size {2}\n", base, num_required_frames, buffer_size));
 
-    auto value = get_uint24_be(&buffer[base]);
     // Speeding up checks by using shortcuts here instead of going
-    // through the parser for each byte position: check for supported
-    // header types (ADTS and LOAS/LATM).
-    if (   ((value & mtx::aac::ADTS_SYNC_WORD_MASK) != mtx::aac::ADTS_SYNC_WORD)
-        && ((value & mtx::aac::LOAS_SYNC_WORD_MASK) != mtx::aac::LOAS_SYNC_WORD))
-      continue;
+    // through the parser for each byte position: only positions with
+    // supported header types (ADTS and LOAS/LATM) are considered.
+    auto value = get_uint24_be(&buffer[base]);
 
     if ((value & mtx::aac::LOAS_SYNC_WORD_MASK) == mtx::aac::LOAS_SYNC_WORD) {
       // Check for second LOAS header right after the current one.
@@ -27,10 +27,25 @@
 #include "common/endian.h"
 #include "common/math.h"
 #include "common/strings/formatting.h"
+#include "common/sync_word_scanner.h"
 
 namespace mtx::ac3 {
 
 namespace {
+// Headers can only be decoded at positions starting with the sync
+// word in either byte order. The parser additionally skips the
+// 0x0110 markers found in some streams.
+mtx::sync_word_scanner_c const s_sync_word_scanner{
+  { SYNC_WORD,                       0xffff, 2, 0 },
+  { mtx::bytes::swap_16(SYNC_WORD),  0xffff, 2, 0 },
+};
+
+mtx::sync_word_scanner_c const s_parser_scanner{
+  { SYNC_WORD,                       0xffff, 2, 0 },
+  { mtx::bytes::swap_16(SYNC_WORD),  0xffff, 2, 0 },
+  { 0x0110,                          0xffff, 2, 0 },
+};
+
 uint64_t s_acmod_to_channel_layout[8] = {
   mtx::channels::front_left | mtx::channels::front_right,
                                                            mtx::channels::front_center,
@@ -320,7 +335,7 @@ frame_c::find_in(memory_cptr const &buffer) {
 int
 frame_c::find_in(uint8_t const *buffer,
                  std::size_t buffer_size) {
-  for (int offset = 0; offset < static_cast<int>(buffer_size); ++offset)
+  for (auto offset = s_sync_word_scanner.find(buffer, buffer_size); offset != mtx::sync_word_scanner_c::npos; offset = s_sync_word_scanner.find(buffer, buffer_size, offset + 1))
     if (decode_header(&buffer[offset], buffer_size - offset))
       return offset;
   return -1;
@@ -464,8 +479,10 @@ parser_c::parse(bool end_of_stream) {
       buffer_to_decode = &buffer[position];
 
     if (!frame.decode_header(buffer_to_decode, 18)) {
-      ++position;
-      ++m_garbage_size;
+      // Everything up to the next candidate is garbage.
+      auto next_position = std::min(s_parser_scanner.find(buffer, buffer_size, position + 1), buffer_size - 18);
+      m_garbage_size    += next_position - position;
+      position           = next_position;
       continue;
     }
 
@@ -517,8 +534,11 @@ parser_c::find_consecutive_frames(uint8_t const *buffer,
       position += 16;
 
     frame_c first_frame;
-    while (((position + 8) < buffer_size) && !first_frame.decode_header(&buffer[position], buffer_size - position))
-      ++position;
+    for (position = s_sync_word_scanner.find(buffer, buffer_size, position);
+         (position != mtx::sync_word_scanner_c::npos) && ((position + 8) < buffer_size);
+         position = s_sync_word_scanner.find(buffer, buffer_size, position + 1))
+      if (first_frame.decode_header(&buffer[position], buffer_size - position))
+        break;
 
     mxdebug_if(s_debug, fmt::format("First frame at {0} valid {1}\n", position, first_frame.m_valid));
 
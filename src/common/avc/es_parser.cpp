@@ -164,7 +164,7 @@ es_parser_c::handle_slice_nalu(memory_cptr const &nalu,
   }
 
   mtx::xyzvc::slice_info_t si;
-  if (!parse_slice(nalu, si))   // no conversion to RBSP; the bit reader takes care of it
+  if (!parse_slice(nalu, si))
     return;
 
   if (NALU_TYPE_IDR_SLICE == si.nalu_type)
@@ -314,7 +314,7 @@ es_parser_c::handle_pps_nalu(memory_cptr const &nalu) {
       break;
 
   if (m_pps_info_list.size() == i) {
-    m_pps_list.push_back(nalu);
+    m_pps_list.push_back(nalu->clone());
     m_pps_info_list.push_back(pps_info);
 
     if (m_configuration_record_ready)
@@ -327,7 +327,7 @@ es_parser_c::handle_pps_nalu(memory_cptr const &nalu) {
       cleanup(m_frames_out);
 
     m_pps_info_list[i] = pps_info;
-    m_pps_list[i]      = nalu;
+    m_pps_list[i]      = nalu->clone();
 
     if (m_configuration_record_ready)
       m_configuration_record_changed = true;
@@ -433,8 +433,8 @@ bool
 es_parser_c::parse_slice(memory_cptr const &nalu,
                          mtx::xyzvc::slice_info_t &si) {
   try {
-    mtx::bits::reader_c r(nalu->get_buffer(), nalu->get_size());
-    r.enable_rbsp_mode();
+    auto rbsp = mtx::mpeg::nalu_to_rbsp(nalu, mtx::xyzvc::SLICE_HEADER_PREFIX_SIZE);
+    mtx::bits::reader_c r(rbsp->get_buffer(), rbsp->get_size());
 
     si.clear();
 
@@ -13,6 +13,8 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
+
 #include <QRegularExpression>
 
 #include "common/iana_language_subtag_registry.h"
@@ -25,6 +27,9 @@ std::optional<QRegularExpression> s_bcp47_re, s_bcp47_grandfathered_re;
 
 void
 init_re() {
+  static std::mutex s_mutex;
+  std::lock_guard<std::mutex> lock{s_mutex};
+
   if (s_bcp47_re)
     return;
 
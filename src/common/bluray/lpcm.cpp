@@ -0,0 +1,320 @@
+/*
+  mkvmerge -- utility for splicing together matroska files
+  from component media subtypes
+
+  Distributed under the GPL v2
+  see the file COPYING for details
+  or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+  Blu-ray LPCM channel layout conversion
+
+  Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <array>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define MTX_LPCM_SSSE3
+# include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# define MTX_LPCM_NEON
+# include <arm_neon.h>
+#endif
+
+#include "common/bluray/lpcm.h"
+
+namespace mtx::bluray::lpcm {
+
+namespace {
+
+using remap_function_t  = void (*)(uint8_t *buffer, std::size_t num_bytes);
+using remove_function_t = std::size_t (*)(uint8_t *buffer, std::size_t num_bytes);
+
+// The Blu-ray channel that ends up at each position of the
+// WAVEFORMATEXTENSIBLE order. The first three channels never move.
+constexpr std::size_t s_first_moved_channel = 3;
+
+template<std::size_t NumChannels>
+constexpr std::array<std::size_t, NumChannels> s_channel_order{};
+
+template<>
+constexpr std::array<std::size_t, 6> s_channel_order<6>{ 0, 1, 2, 5, 3, 4 };       // FL FR FC LFE BL BR
+
+template<>
+constexpr std::array<std::size_t, 7> s_channel_order<7>{ 0, 1, 2, 4, 5, 3, 6 };    // FL FR FC BL BR SL SR
+
+template<>
+constexpr std::array<std::size_t, 8> s_channel_order<8>{ 0, 1, 2, 7, 4, 5, 3, 6 }; // FL FR FC LFE BL BR SL SR
+
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+void
+remap_frames(uint8_t *buffer,
+             std::size_t num_bytes) {
+  constexpr auto frame_size = BytesPerChannel * NumChannels;
+
+  for (std::size_t pos = 0; (pos + frame_size) <= num_bytes; pos += frame_size) {
+    uint8_t frame[frame_size];
+    std::memcpy(frame, &buffer[pos], frame_size);
+
+    for (auto channel = s_first_moved_channel; channel < NumChannels; ++channel)
+      std::memcpy(&buffer[pos + channel * BytesPerChannel], &frame[s_channel_order<NumChannels>[channel] * BytesPerChannel], BytesPerChannel);
+  }
+}
+
+template<std::size_t BytesPerChannel, std::size_t NumInputChannels>
+std::size_t
+remove_last_channel(uint8_t *buffer,
+                    std::size_t num_bytes) {
+  constexpr auto input_frame_size  = BytesPerChannel * NumInputChannels;
+  constexpr auto output_frame_size = BytesPerChannel * (NumInputChannels - 1);
+
+  std::size_t input_pos = 0, output_pos = 0;
+
+  for (; (input_pos + input_frame_size) <= num_bytes; input_pos += input_frame_size, output_pos += output_frame_size)
+    std::memmove(&buffer[output_pos], &buffer[input_pos], output_frame_size);
+
+  return output_pos;
+}
+
+#if defined(MTX_LPCM_SSSE3) || defined(MTX_LPCM_NEON)
+// The vectorized versions permute the 16 bytes starting at the first
+// moved channel of each frame with a single shuffle. Bytes of the
+// following frame are stored unchanged; the next window is loaded
+// before the current one is stored as they may overlap. This requires
+// all moved channels to fit into those 16 bytes.
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+constexpr bool s_fits_into_vector = ((NumChannels - s_first_moved_channel) * BytesPerChannel) <= 16;
+
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+constexpr std::array<uint8_t, 16>
+create_shuffle_mask() {
+  std::array<uint8_t, 16> mask{};
+
+  for (std::size_t idx = 0; idx < 16; ++idx) {
+    auto channel = s_first_moved_channel + idx / BytesPerChannel;
+    mask[idx]    = channel < NumChannels ? (s_channel_order<NumChannels>[channel] - s_first_moved_channel) * BytesPerChannel + idx % BytesPerChannel : idx;
+  }
+
+  return mask;
+}
+#endif
+
+#if defined(MTX_LPCM_SSSE3)
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+__attribute__((target("ssse3")))
+void
+remap_frames_ssse3(uint8_t *buffer,
+                   std::size_t num_bytes) {
+  static constexpr auto s_shuffle_mask = create_shuffle_mask<BytesPerChannel, NumChannels>();
+  constexpr auto frame_size            = BytesPerChannel * NumChannels;
+  constexpr auto window_offset         = BytesPerChannel * s_first_moved_channel;
+
+  auto mask = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s_shuffle_mask.data()));
+  auto pos  = std::size_t{};
+
+  if ((window_offset + 16) <= num_bytes) {
+    auto window = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&buffer[window_offset]));
+
+    for (; (pos + frame_size + window_offset + 16) <= num_bytes; pos += frame_size) {
+      auto next_window = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&buffer[pos + frame_size + window_offset]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&buffer[pos + window_offset]), _mm_shuffle_epi8(window, mask));
+      window = next_window;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&buffer[pos + window_offset]), _mm_shuffle_epi8(window, mask));
+    pos += frame_size;
+  }
+
+  remap_frames<BytesPerChannel, NumChannels>(&buffer[pos], num_bytes - pos);
+}
+
+#elif defined(MTX_LPCM_NEON)
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+void
+remap_frames_neon(uint8_t *buffer,
+                  std::size_t num_bytes) {
+  static constexpr auto s_shuffle_mask = create_shuffle_mask<BytesPerChannel, NumChannels>();
+  constexpr auto frame_size            = BytesPerChannel * NumChannels;
+  constexpr auto window_offset         = BytesPerChannel * s_first_moved_channel;
+
+  auto mask = vld1q_u8(s_shuffle_mask.data());
+  auto pos  = std::size_t{};
+
+  if ((window_offset + 16) <= num_bytes) {
+    auto window = vld1q_u8(&buffer[window_offset]);
+
+    for (; (pos + frame_size + window_offset + 16) <= num_bytes; pos += frame_size) {
+      auto next_window = vld1q_u8(&buffer[pos + frame_size + window_offset]);
+      vst1q_u8(&buffer[pos + window_offset], vqtbl1q_u8(window, mask));
+      window = next_window;
+    }
+
+    vst1q_u8(&buffer[pos + window_offset], vqtbl1q_u8(window, mask));
+    pos += frame_size;
+  }
+
+  remap_frames<BytesPerChannel, NumChannels>(&buffer[pos], num_bytes - pos);
+}
+#endif
+
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+remap_function_t
+determine_remap_function() {
+#if defined(MTX_LPCM_SSSE3)
+  if constexpr (s_fits_into_vector<BytesPerChannel, NumChannels>) {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("ssse3"))
+      return remap_frames_ssse3<BytesPerChannel, NumChannels>;
+  }
+
+#elif defined(MTX_LPCM_NEON)
+  if constexpr (s_fits_into_vector<BytesPerChannel, NumChannels>)
+    return remap_frames_neon<BytesPerChannel, NumChannels>;
+#endif
+
+  return remap_frames<BytesPerChannel, NumChannels>;
+}
+
+template<std::size_t BytesPerChannel, std::size_t NumChannels>
+void
+remap_frames_fastest(uint8_t *buffer,
+                     std::size_t num_bytes) {
+  static auto const s_function = determine_remap_function<BytesPerChannel, NumChannels>();
+  s_function(buffer, num_bytes);
+}
+
+template<std::size_t BytesPerChannel>
+remap_function_t
+find_remap_function(std::size_t num_channels) {
+  return 6 == num_channels ? remap_frames_fastest<BytesPerChannel, 6>
+       : 7 == num_channels ? remap_frames_fastest<BytesPerChannel, 7>
+       : 8 == num_channels ? remap_frames_fastest<BytesPerChannel, 8>
+       :                     nullptr;
+}
+
+remap_function_t
+find_remap_function(std::size_t bytes_per_channel,
+                    std::size_t num_channels) {
+  return 2 == bytes_per_channel ? find_remap_function<2>(num_channels)
+       : 3 == bytes_per_channel ? find_remap_function<3>(num_channels)
+       : 4 == bytes_per_channel ? find_remap_function<4>(num_channels)
+       :                          nullptr;
+}
+
+template<std::size_t BytesPerChannel>
+remove_function_t
+find_remove_function(std::size_t num_input_channels) {
+  return 2 == num_input_channels ? remove_last_channel<BytesPerChannel, 2>
+       : 4 == num_input_channels ? remove_last_channel<BytesPerChannel, 4>
+       : 6 == num_input_channels ? remove_last_channel<BytesPerChannel, 6>
+       : 8 == num_input_channels ? remove_last_channel<BytesPerChannel, 8>
+       :                           nullptr;
+}
+
+remove_function_t
+find_remove_function(std::size_t bytes_per_channel,
+                     std::size_t num_input_channels) {
+  return 2 == bytes_per_channel ? find_remove_function<2>(num_input_channels)
+       : 3 == bytes_per_channel ? find_remove_function<3>(num_input_channels)
+       : 4 == bytes_per_channel ? find_remove_function<4>(num_input_channels)
+       :                          nullptr;
+}
+
+} // anonymous namespace
+
+std::size_t
+remove_channels_scalar(uint8_t *buffer,
+                       std::size_t num_bytes,
+                       std::size_t bytes_per_channel,
+                       std::size_t num_input_channels,
+                       std::size_t num_output_channels) {
+  auto end_ptr                    = buffer + num_bytes;
+  auto input_ptr                  = buffer;
+  auto output_ptr                 = buffer;
+  auto input_bytes_per_iteration  = bytes_per_channel * num_input_channels;
+  auto output_bytes_per_iteration = bytes_per_channel * num_output_channels;
+
+  while ((input_ptr + input_bytes_per_iteration) <= end_ptr) {
+    if (input_ptr != output_ptr)
+      std::memmove(output_ptr, input_ptr, output_bytes_per_iteration);
+
+    input_ptr  += input_bytes_per_iteration;
+    output_ptr += output_bytes_per_iteration;
+  }
+
+  return output_ptr - buffer;
+}
+
+std::size_t
+remove_channels(uint8_t *buffer,
+                std::size_t num_bytes,
+                std::size_t bytes_per_channel,
+                std::size_t num_input_channels,
+                std::size_t num_output_channels) {
+  auto function = (num_output_channels + 1) == num_input_channels ? find_remove_function(bytes_per_channel, num_input_channels) : nullptr;
+
+  return function ? function(buffer, num_bytes) : remove_channels_scalar(buffer, num_bytes, bytes_per_channel, num_input_channels, num_output_channels);
+}
+
+void
+remap_channels_scalar(uint8_t *buffer,
+                      std::size_t num_bytes,
+                      std::size_t bytes_per_channel,
+                      std::size_t num_channels) {
+  if ((num_channels < 6) || (num_channels > 8))
+    return;
+
+  auto start_ptr = buffer;
+  auto end_ptr   = buffer + num_bytes;
+  auto remap_mem = std::vector<uint8_t>(bytes_per_channel * 5);
+  auto remap_buf = remap_mem.data();
+
+  while (start_ptr != end_ptr) {
+    start_ptr += bytes_per_channel * 3;
+
+    if (num_channels == 6) {
+      // post-remap order: FL FR FC LFE BL BR
+      memcpy(remap_buf,                     start_ptr,                         bytes_per_channel * 3);
+      memcpy(start_ptr,                     remap_buf + bytes_per_channel * 2, bytes_per_channel);
+      memcpy(start_ptr + bytes_per_channel, remap_buf,                         bytes_per_channel * 2);
+
+      start_ptr += bytes_per_channel * 3;
+
+    } else if (num_channels == 7) {
+      // post-remap order: FL FR FC BL BR SL SR
+      memcpy(remap_buf,                         start_ptr,                     bytes_per_channel * 3);
+      memcpy(start_ptr,                         remap_buf + bytes_per_channel, bytes_per_channel * 2);
+      memcpy(start_ptr + bytes_per_channel * 2, remap_buf,                     bytes_per_channel);
+
+      start_ptr += bytes_per_channel * 4;
+
+    } else {
+      // post-remap order: FL FR FC LFE BL BR SL SR
+      memcpy(remap_buf,                         start_ptr,                         bytes_per_channel * 5);
+      memcpy(start_ptr,                         remap_buf + bytes_per_channel * 4, bytes_per_channel);
+      // BL and BR stay at the same place
+      memcpy(start_ptr + bytes_per_channel * 3, remap_buf,                         bytes_per_channel);
+      memcpy(start_ptr + bytes_per_channel * 4, remap_buf + bytes_per_channel * 3, bytes_per_channel);
+
+      start_ptr += bytes_per_channel * 5;
+    }
+  }
+}
+
+void
+remap_channels(uint8_t *buffer,
+               std::size_t num_bytes,
+               std::size_t bytes_per_channel,
+               std::size_t num_channels) {
+  auto function = find_remap_function(bytes_per_channel, num_channels);
+
+  if (function)
+    function(buffer, num_bytes);
+  else
+    remap_channels_scalar(buffer, num_bytes, bytes_per_channel, num_channels);
+}
+
+}
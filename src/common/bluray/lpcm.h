@@ -0,0 +1,34 @@
+/*
+  mkvmerge -- utility for splicing together matroska files
+  from component media subtypes
+
+  Distributed under the GPL v2
+  see the file COPYING for details
+  or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+  Blu-ray LPCM channel layout conversion
+
+  Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+namespace mtx::bluray::lpcm {
+
+// Blu-ray LPCM streams with an odd number of channels carry an
+// additional, unused channel. Removes all channels beyond
+// num_output_channels from each sample frame in place and returns the
+// new number of bytes.
+std::size_t remove_channels(uint8_t *buffer, std::size_t num_bytes, std::size_t bytes_per_channel, std::size_t num_input_channels, std::size_t num_output_channels);
+std::size_t remove_channels_scalar(uint8_t *buffer, std::size_t num_bytes, std::size_t bytes_per_channel, std::size_t num_input_channels, std::size_t num_output_channels);
+
+// Reorders the channels of each sample frame in place from the
+// Blu-ray order into the WAVEFORMATEXTENSIBLE order. Only six, seven
+// and eight channels need remapping. num_bytes must be a multiple of
+// the sample frame size.
+void remap_channels(uint8_t *buffer, std::size_t num_bytes, std::size_t bytes_per_channel, std::size_t num_channels);
+void remap_channels_scalar(uint8_t *buffer, std::size_t num_bytes, std::size_t bytes_per_channel, std::size_t num_channels);
+
+}
@@ -11,13 +11,153 @@
 
 #include "common/common_pch.h"
 
+#include <array>
 #include <stdexcept>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define MTX_BSWAP_SSSE3
+# include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# define MTX_BSWAP_NEON
+# include <arm_neon.h>
+#endif
+
 #include "common/bswap.h"
 #include "common/endian.h"
 
 namespace mtx::bytes {
 
+namespace {
+
+using swap_function_t = void (*)(uint8_t const *src, uint8_t *dst, std::size_t num_bytes);
+
+template<std::size_t WordLength>
+void
+swap_words(uint8_t const *src,
+           uint8_t *dst,
+           std::size_t num_bytes) {
+  for (std::size_t idx = 0; idx < num_bytes; idx += WordLength) {
+    uint8_t word[WordLength];
+    std::memcpy(word, &src[idx], WordLength);
+
+    for (std::size_t byte_idx = 0; byte_idx < WordLength; ++byte_idx)
+      dst[idx + byte_idx] = word[WordLength - 1 - byte_idx];
+  }
+}
+
+#if defined(MTX_BSWAP_SSSE3) || defined(MTX_BSWAP_NEON)
+// Each step of the vectorized versions swaps as many whole words as
+// fit into 16 bytes. The remaining bytes of the vector are stored
+// unchanged and overwritten by the next step. The next vector is
+// loaded before the current one is stored so that overlapping steps
+// don't have to wait for the store.
+template<std::size_t WordLength>
+constexpr std::size_t s_step = 16 / WordLength * WordLength;
+
+template<std::size_t WordLength>
+constexpr std::array<uint8_t, 16>
+create_shuffle_mask() {
+  std::array<uint8_t, 16> mask{};
+
+  for (std::size_t idx = 0; idx < 16; ++idx)
+    mask[idx] = idx < s_step<WordLength> ? (idx / WordLength) * WordLength + WordLength - 1 - idx % WordLength : idx;
+
+  return mask;
+}
+#endif
+
+#if defined(MTX_BSWAP_SSSE3)
+template<std::size_t WordLength>
+__attribute__((target("ssse3")))
+void
+swap_words_ssse3(uint8_t const *src,
+                 uint8_t *dst,
+                 std::size_t num_bytes) {
+  static constexpr auto s_shuffle_mask = create_shuffle_mask<WordLength>();
+
+  auto mask = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s_shuffle_mask.data()));
+  auto idx  = std::size_t{};
+
+  if (num_bytes >= 16) {
+    auto words = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+
+    for (; (idx + s_step<WordLength> + 16) <= num_bytes; idx += s_step<WordLength>) {
+      auto next_words = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&src[idx + s_step<WordLength>]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[idx]), _mm_shuffle_epi8(words, mask));
+      words = next_words;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[idx]), _mm_shuffle_epi8(words, mask));
+    idx += s_step<WordLength>;
+  }
+
+  swap_words<WordLength>(&src[idx], &dst[idx], num_bytes - idx);
+}
+
+#elif defined(MTX_BSWAP_NEON)
+template<std::size_t WordLength>
+void
+swap_words_neon(uint8_t const *src,
+                uint8_t *dst,
+                std::size_t num_bytes) {
+  static constexpr auto s_shuffle_mask = create_shuffle_mask<WordLength>();
+
+  auto mask = vld1q_u8(s_shuffle_mask.data());
+  auto idx  = std::size_t{};
+
+  if (num_bytes >= 16) {
+    auto words = vld1q_u8(src);
+
+    for (; (idx + s_step<WordLength> + 16) <= num_bytes; idx += s_step<WordLength>) {
+      auto next_words = vld1q_u8(&src[idx + s_step<WordLength>]);
+      vst1q_u8(&dst[idx], vqtbl1q_u8(words, mask));
+      words = next_words;
+    }
+
+    vst1q_u8(&dst[idx], vqtbl1q_u8(words, mask));
+    idx += s_step<WordLength>;
+  }
+
+  swap_words<WordLength>(&src[idx], &dst[idx], num_bytes - idx);
+}
+#endif
+
+template<std::size_t WordLength>
+swap_function_t
+determine_swap_function() {
+#if defined(MTX_BSWAP_SSSE3)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("ssse3"))
+    return swap_words_ssse3<WordLength>;
+
+#elif defined(MTX_BSWAP_NEON)
+  return swap_words_neon<WordLength>;
+#endif
+
+  return swap_words<WordLength>;
+}
+
+template<std::size_t WordLength>
+void
+swap_words_fastest(uint8_t const *src,
+                   uint8_t *dst,
+                   std::size_t num_bytes) {
+  static auto const s_function = determine_swap_function<WordLength>();
+  s_function(src, dst, num_bytes);
+}
+
+} // anonymous namespace
+
+void
+swap_buffer_scalar(uint8_t const *src,
+                   uint8_t *dst,
+                   std::size_t num_bytes,
+                   std::size_t word_length) {
+  for (int idx = 0; idx < static_cast<int>(num_bytes); idx += word_length)
+    put_uint_le(&dst[idx], get_uint_be(&src[idx], word_length), word_length);
+}
+
 void
 swap_buffer(uint8_t const *src,
             uint8_t *dst,
@@ -26,8 +166,13 @@ swap_buffer(uint8_t const *src,
   if ((num_bytes % word_length) != 0)
     throw std::invalid_argument(fmt::format(FY("The number of bytes to swap isn't divisible by {0}."), word_length));
 
-  for (int idx = 0; idx < static_cast<int>(num_bytes); idx += word_length)
-    put_uint_le(&dst[idx], get_uint_be(&src[idx], word_length), word_length);
+  switch (word_length) {
+    case 2:  swap_words_fastest<2>(src, dst, num_bytes); break;
+    case 3:  swap_words_fastest<3>(src, dst, num_bytes); break;
+    case 4:  swap_words_fastest<4>(src, dst, num_bytes); break;
+    case 8:  swap_words<8>(src, dst, num_bytes);         break;
+    default: swap_buffer_scalar(src, dst, num_bytes, word_length);
+  }
 }
 
 }
@@ -47,4 +47,8 @@ swap_64(uint64_t x) {
 
 void swap_buffer(uint8_t const *src, uint8_t *dst, std::size_t num_bytes, std::size_t word_length);
 
+// Byte-by-byte reference implementation of swap_buffer() without the
+// vectorized code paths and without argument checks.
+void swap_buffer_scalar(uint8_t const *src, uint8_t *dst, std::size_t num_bytes, std::size_t word_length);
+
 }
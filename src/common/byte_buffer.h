@@ -101,7 +101,10 @@ public:
       m_offset += num;
     m_filled -= num;
 
-    if (m_filled >= m_chunk_size)
+    // Only move the remaining data once at least a whole chunk can be
+    // reclaimed; stripping a few header bytes from a large buffer
+    // shouldn't cost a copy of all of it.
+    if (m_offset >= m_chunk_size)
       trim();
   }
 
@@ -118,6 +121,32 @@ public:
     return m_filled;
   }
 
+  std::size_t get_allocated_size() const {
+    return m_size;
+  }
+
+  // Hands the buffered data minus the first num_to_skip bytes over to
+  // the caller without copying it. The buffer continues with newly
+  // allocated storage afterwards.
+  //
+  // The result borrows the old storage & keeps it alive. It starts at
+  // offset 0 so that set_offset() & set_size() work the same way they
+  // do for freshly allocated buffers.
+  memory_cptr detach(std::size_t num_to_skip = 0) {
+    num_to_skip = std::min(num_to_skip, m_filled);
+
+    auto data = memory_c::borrow(get_buffer() + num_to_skip, m_filled - num_to_skip, m_data);
+
+    m_data   = memory_c::alloc(m_chunk_size);
+    m_size   = m_chunk_size;
+    m_offset = 0;
+    m_filled = 0;
+
+    count_alloc(m_chunk_size);
+
+    return data;
+  }
+
   void set_chunk_size(size_t chunk_size) {
     m_chunk_size = chunk_size;
     trim();
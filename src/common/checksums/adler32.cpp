@@ -44,9 +44,22 @@ adler32_c::get_result_as_uint()
 void
 adler32_c::add_impl(uint8_t const *buffer,
                     size_t size) {
-  for (auto idx = 0u; idx < size; ++idx) {
-    m_a = (m_a + buffer[idx]) % msc_mod_adler;
-    m_b = (m_b + m_a)         % msc_mod_adler;
+  // 5552 is the largest number of bytes that can be added before the
+  // sums have to be reduced modulo msc_mod_adler in order not to
+  // overflow 32 bits.
+  static constexpr std::size_t s_max_run = 5552;
+
+  while (size) {
+    auto run  = std::min(size, s_max_run);
+    size     -= run;
+
+    for (auto end = buffer + run; buffer < end; ++buffer) {
+      m_a += *buffer;
+      m_b += m_a;
+    }
+
+    m_a %= msc_mod_adler;
+    m_b %= msc_mod_adler;
   }
 }
 
@@ -136,6 +136,28 @@ base_c::add(memory_c const &buffer) {
   return *this;
 }
 
+base_c &
+base_c::add_parallel(void const *buffer,
+                     size_t size,
+                     mtx::thread_pool_c &pool) {
+  add_parallel_impl(static_cast<uint8_t const *>(buffer), size, pool);
+  return *this;
+}
+
+base_c &
+base_c::add_parallel(memory_c const &buffer,
+                     mtx::thread_pool_c &pool) {
+  add_parallel_impl(buffer.get_buffer(), buffer.get_size(), pool);
+  return *this;
+}
+
+void
+base_c::add_parallel_impl(uint8_t const *buffer,
+                          size_t size,
+                          mtx::thread_pool_c &/* pool */) {
+  add_impl(buffer, size);
+}
+
 base_c &
 base_c::finish() {
   return *this;
@@ -17,6 +17,10 @@
 
 #include "common/checksums/base_fwd.h"
 
+namespace mtx {
+class thread_pool_c;
+}
+
 namespace mtx::checksum {
 
 class base_c {
@@ -27,11 +31,18 @@ public:
   base_c &add(void const *buffer, size_t size);
   base_c &add(memory_c const &buffer);
 
+  // Algorithms whose results can be combined from the results of
+  // independent pieces (the CRCs) split large buffers up and process
+  // the pieces on the pool's threads. All others simply call add().
+  base_c &add_parallel(void const *buffer, size_t size, mtx::thread_pool_c &pool);
+  base_c &add_parallel(memory_c const &buffer, mtx::thread_pool_c &pool);
+
   virtual base_c &finish();
   virtual memory_cptr get_result() const = 0;
 
 protected:
   virtual void add_impl(uint8_t const *buffer, size_t size) = 0;
+  virtual void add_parallel_impl(uint8_t const *buffer, size_t size, mtx::thread_pool_c &pool);
 };
 
 class set_initial_value_c {
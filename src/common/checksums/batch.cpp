@@ -0,0 +1,144 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   checksum calculations – many independent buffers at once
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/checksums/batch.h"
+#include "common/thread_pool.h"
+
+namespace mtx::checksum {
+
+batch_c::batch_c(algorithm_e algorithm,
+                 mtx::thread_pool_c *pool,
+                 uint64_t initial_value,
+                 std::size_t batch_size)
+  : m_algorithm{algorithm}
+  , m_initial_value{initial_value}
+  , m_pool{pool}
+  , m_batch_size{std::max<std::size_t>(batch_size, 1)}
+{
+}
+
+batch_c::~batch_c() {
+  // The tasks still running reference the buffers, which may be freed
+  // right after the batch is destroyed.
+  for (auto &batch : m_batches)
+    if (batch.valid())
+      batch.wait();
+}
+
+void
+batch_c::set_worker_setup(std::function<void(base_c &)> const &setup) {
+  m_setup = setup;
+}
+
+std::size_t
+batch_c::add(void const *buffer,
+             std::size_t size) {
+  m_pending.push_back({ static_cast<uint8_t const *>(buffer), size });
+  m_pending_size += size;
+
+  if (m_pending_size >= m_batch_size)
+    submit_pending();
+
+  return m_num_buffers++;
+}
+
+std::size_t
+batch_c::add(memory_c const &buffer) {
+  return add(buffer.get_buffer(), buffer.get_size());
+}
+
+void
+batch_c::submit_pending() {
+  if (m_pending.empty())
+    return;
+
+  auto buffers   = std::move(m_pending);
+  m_pending      = {};
+  m_pending_size = 0;
+
+  if (!m_pool) {
+    for (auto &worker : calculate(m_algorithm, m_initial_value, m_setup, buffers))
+      m_results.emplace_back(std::move(worker));
+    return;
+  }
+
+  m_batches.emplace_back(m_pool->submit([algorithm = m_algorithm, initial_value = m_initial_value, setup = m_setup, buffers = std::move(buffers)]() {
+    return calculate(algorithm, initial_value, setup, buffers);
+  }));
+}
+
+std::vector<base_uptr>
+batch_c::calculate(algorithm_e algorithm,
+                   uint64_t initial_value,
+                   std::function<void(base_c &)> const &setup,
+                   std::vector<buffer_t> const &buffers) {
+  std::vector<base_uptr> workers;
+  workers.reserve(buffers.size());
+
+  for (auto const &buffer : buffers) {
+    workers.emplace_back(for_algorithm(algorithm, initial_value));
+    if (setup)
+      setup(*workers.back());
+    workers.back()->add(buffer.m_buffer, buffer.m_size);
+    workers.back()->finish();
+  }
+
+  return workers;
+}
+
+std::vector<base_uptr>
+batch_c::wait_for_all() {
+  submit_pending();
+
+  for (auto &batch : m_batches)
+    for (auto &worker : batch.get())
+      m_results.emplace_back(std::move(worker));
+
+  m_batches.clear();
+
+  auto results = std::move(m_results);
+  m_results.clear();
+  m_num_buffers = 0;
+
+  return results;
+}
+
+std::vector<memory_cptr>
+batch_c::get_results() {
+  auto workers = wait_for_all();
+
+  std::vector<memory_cptr> results;
+  results.reserve(workers.size());
+
+  for (auto const &worker : workers)
+    results.emplace_back(worker->get_result());
+
+  return results;
+}
+
+std::vector<uint64_t>
+batch_c::get_results_as_uint() {
+  auto workers = wait_for_all();
+
+  std::vector<uint64_t> results;
+  results.reserve(workers.size());
+
+  for (auto const &worker : workers)
+    results.emplace_back(dynamic_cast<uint_result_c &>(*worker).get_result_as_uint());
+
+  return results;
+}
+
+} // namespace mtx::checksum
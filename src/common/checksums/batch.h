@@ -0,0 +1,81 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   checksum calculations – many independent buffers at once
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include <functional>
+#include <future>
+
+#include "common/checksums/base.h"
+
+namespace mtx::checksum {
+
+// Calculates one checksum for each of many independent buffers, e.g.
+// for all the frames in a cluster. The buffers are grouped into batches
+// of roughly batch_size bytes. Each batch is processed by one task on
+// the thread pool. Without a pool the checksums are calculated on the
+// calling thread instead. The results are always returned in the order
+// the buffers were added.
+//
+// The buffers are not copied. They must stay valid until the results
+// have been retrieved.
+class batch_c {
+protected:
+  struct buffer_t {
+    uint8_t const *m_buffer{};
+    std::size_t m_size{};
+  };
+
+  algorithm_e m_algorithm;
+  uint64_t m_initial_value;
+  std::function<void(base_c &)> m_setup;
+  mtx::thread_pool_c *m_pool;
+  std::size_t m_batch_size;
+
+  std::vector<buffer_t> m_pending;
+  std::size_t m_pending_size{}, m_num_buffers{};
+  std::vector<base_uptr> m_results;
+  std::vector<std::future<std::vector<base_uptr>>> m_batches;
+
+public:
+  static constexpr std::size_t s_default_batch_size = 256 * 1024;
+
+  explicit batch_c(algorithm_e algorithm, mtx::thread_pool_c *pool = nullptr, uint64_t initial_value = 0, std::size_t batch_size = s_default_batch_size);
+  ~batch_c();
+
+  batch_c(batch_c const &) = delete;
+  batch_c &operator =(batch_c const &) = delete;
+
+  // Called for each checksum worker before data is added to it, e.g.
+  // for setting further CRC parameters.
+  void set_worker_setup(std::function<void(base_c &)> const &setup);
+
+  // Returns the index of the buffer's result.
+  std::size_t add(void const *buffer, std::size_t size);
+  std::size_t add(memory_c const &buffer);
+
+  // Wait for all outstanding batches. Afterwards the batch can be
+  // re-used for the next set of buffers.
+  std::vector<memory_cptr> get_results();
+  std::vector<uint64_t> get_results_as_uint();
+
+protected:
+  void submit_pending();
+  std::vector<base_uptr> wait_for_all();
+
+  static std::vector<base_uptr> calculate(algorithm_e algorithm, uint64_t initial_value, std::function<void(base_c &)> const &setup, std::vector<buffer_t> const &buffers);
+};
+
+} // namespace mtx::checksum
@@ -16,12 +16,171 @@
 
 #include "common/common_pch.h"
 
+#include <bit>
+#include <future>
+#include <mutex>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define MTX_CRC32_PCLMUL
+# include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+# define MTX_CRC32_ARMV8
+# include <arm_acle.h>
+#endif
+
 #include "common/bswap.h"
 #include "common/checksums/crc.h"
 #include "common/endian.h"
+#include "common/thread_pool.h"
 
 namespace mtx::checksum {
 
+namespace {
+
+using update_function_t = uint32_t (*)(uint32_t crc, uint8_t const *buffer, size_t size);
+
+inline uint32_t
+load_uint32_le(uint8_t const *buffer) {
+  uint32_t value;
+  std::memcpy(&value, buffer, sizeof(value));
+
+  if constexpr (std::endian::native == std::endian::big)
+    value = mtx::bytes::swap_32(value);
+
+  return value;
+}
+
+#if defined(MTX_CRC32_PCLMUL)
+__attribute__((target("pclmul,sse4.1")))
+inline __m128i
+load_128(uint8_t const *buffer) {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const *>(buffer));
+}
+
+// Folds the 128 bits in x over the following 128 bits in next.
+__attribute__((target("pclmul,sse4.1")))
+inline __m128i
+fold_128(__m128i x,
+         __m128i next,
+         __m128i constants) {
+  return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, constants, 0x11), next), _mm_clmulepi64_si128(x, constants, 0x00));
+}
+
+// Folding with carry-less multiplication for the bit-reflected CRC-32
+// (polynomial 0xEDB88320) as described in Intel's white paper "Fast
+// CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction". The size must be at least 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1")))
+uint32_t
+update_crc32_ieee_le_pclmul(uint32_t crc,
+                            uint8_t const *buffer,
+                            size_t size) {
+  alignas(16) static uint64_t const k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+  alignas(16) static uint64_t const k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+  alignas(16) static uint64_t const k5k0[] = { 0x0163cd6124, 0x0000000000 };
+  alignas(16) static uint64_t const poly[] = { 0x01db710641, 0x01f7011641 };
+
+  auto x1 = _mm_xor_si128(load_128(buffer), _mm_cvtsi32_si128(static_cast<int>(crc)));
+  auto x2 = load_128(buffer + 16);
+  auto x3 = load_128(buffer + 32);
+  auto x4 = load_128(buffer + 48);
+  auto x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(k1k2));
+
+  buffer += 64;
+  size   -= 64;
+
+  // Fold four blocks of 16 bytes in parallel.
+  while (size >= 64) {
+    x1 = fold_128(x1, load_128(buffer),      x0);
+    x2 = fold_128(x2, load_128(buffer + 16), x0);
+    x3 = fold_128(x3, load_128(buffer + 32), x0);
+    x4 = fold_128(x4, load_128(buffer + 48), x0);
+
+    buffer += 64;
+    size   -= 64;
+  }
+
+  // Fold the four blocks into one, then the remaining single blocks.
+  x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(k3k4));
+
+  x1 = fold_128(x1, x2, x0);
+  x1 = fold_128(x1, x3, x0);
+  x1 = fold_128(x1, x4, x0);
+
+  while (size >= 16) {
+    x1      = fold_128(x1, load_128(buffer), x0);
+    buffer += 16;
+    size   -= 16;
+  }
+
+  // Reduce 128 to 64 bits…
+  auto const mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  x0 = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(k5k0));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x00), x2);
+
+  // …and to 32 bits with a Barrett reduction.
+  x0 = _mm_load_si128(reinterpret_cast<__m128i const *>(poly));
+  x2 = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), x0, 0x10), mask32);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+update_function_t
+determine_crc32_ieee_le_hardware_function() {
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    return update_crc32_ieee_le_pclmul;
+
+  return nullptr;
+}
+
+#elif defined(MTX_CRC32_ARMV8)
+// The ARMv8 CRC32 instructions implement the bit-reflected CRC-32
+// without pre- and post-conditioning, just like the tables do.
+uint32_t
+update_crc32_ieee_le_armv8(uint32_t crc,
+                           uint8_t const *buffer,
+                           size_t size) {
+  for (; size >= 8; buffer += 8, size -= 8) {
+    uint64_t value;
+    std::memcpy(&value, buffer, sizeof(value));
+    crc = __crc32d(crc, value);
+  }
+
+  for (; size > 0; ++buffer, --size)
+    crc = __crc32b(crc, *buffer);
+
+  return crc;
+}
+
+update_function_t
+determine_crc32_ieee_le_hardware_function() {
+  return update_crc32_ieee_le_armv8;
+}
+
+#else
+update_function_t
+determine_crc32_ieee_le_hardware_function() {
+  return nullptr;
+}
+#endif
+
+update_function_t
+crc32_ieee_le_hardware_function() {
+  static auto s_function = determine_crc32_ieee_le_hardware_function();
+  return s_function;
+}
+
+} // anonymous namespace
+
 crc_base_c::table_parameters_t const crc_base_c::ms_table_parameters[6] = {
   { 0,  8,       0x07 },
   { 0, 16,     0x8005 },
@@ -40,8 +199,15 @@ crc_base_c::crc_base_c(type_e type,
   , m_xor_result{}
   , m_result_in_le{}
 {
-  if (m_table.empty())
-    init_table();
+  // The tables are shared by all instances of a type, and instances
+  // may be created on several threads at the same time. Once a table
+  // has been initialized, std::call_once() doesn't lock anymore.
+  static std::once_flag s_table_initialized[std::size(ms_table_parameters)];
+
+  std::call_once(s_table_initialized[m_type], [this]() {
+    if (m_table.empty())
+      init_table();
+  });
 }
 
 #ifdef COMP_MSC
@@ -55,7 +221,7 @@ crc_base_c::init_table() {
   if ((parameters.bits < 8) || (parameters.bits > 32) || (parameters.poly >= (1LL<<parameters.bits)))
     throw std::domain_error{"Invalid CRC parameters"};
 
-  m_table.resize(256);
+  m_table.resize(256 * ms_num_sub_tables);
 
   for (auto i = 0u; i < 256u; i++) {
     if (parameters.le) {
@@ -72,6 +238,12 @@ crc_base_c::init_table() {
     }
   }
 
+  for (auto sub_table = 1u; sub_table < ms_num_sub_tables; ++sub_table)
+    for (auto i = 0u; i < 256u; ++i) {
+      auto previous                = m_table[(sub_table - 1) * 256 + i];
+      m_table[sub_table * 256 + i] = m_table[previous & 0xff] ^ (previous >> 8);
+    }
+
   // for (auto row = 0u; row < (256u / 4); ++row)
   //   mxinfo(fmt::format("0x{0:08x} 0x{1:08x} 0x{2:08x} 0x{3:08x}\n", m_table[row * 4 + 0], m_table[row * 4 + 1], m_table[row * 4 + 2], m_table[row * 4 + 3]));
 }
@@ -121,15 +293,151 @@ crc_base_c::set_result_in_le(bool result_in_le) {
   m_result_in_le = result_in_le;
 }
 
-void
-crc_base_c::add_impl(uint8_t const *buffer,
-                     size_t size) {
+uint32_t
+crc_base_c::update_with_tables(uint32_t crc,
+                               uint8_t const *buffer,
+                               size_t size)
+  const {
+  auto t   = m_table.data();
   auto end = buffer + size;
 
+  // Slicing-by-16: the current CRC is combined with the first four
+  // bytes; each byte is then looked up in the sub-table for the number
+  // of bytes following it within the block.
+  while ((end - buffer) >= 16) {
+    auto v0 = crc ^ load_uint32_le(buffer);
+    auto v1 = load_uint32_le(buffer + 4);
+    auto v2 = load_uint32_le(buffer + 8);
+    auto v3 = load_uint32_le(buffer + 12);
+
+    crc = t[15 * 256 + (v0 & 0xff)] ^ t[14 * 256 + ((v0 >> 8) & 0xff)] ^ t[13 * 256 + ((v0 >> 16) & 0xff)] ^ t[12 * 256 + (v0 >> 24)]
+        ^ t[11 * 256 + (v1 & 0xff)] ^ t[10 * 256 + ((v1 >> 8) & 0xff)] ^ t[ 9 * 256 + ((v1 >> 16) & 0xff)] ^ t[ 8 * 256 + (v1 >> 24)]
+        ^ t[ 7 * 256 + (v2 & 0xff)] ^ t[ 6 * 256 + ((v2 >> 8) & 0xff)] ^ t[ 5 * 256 + ((v2 >> 16) & 0xff)] ^ t[ 4 * 256 + (v2 >> 24)]
+        ^ t[ 3 * 256 + (v3 & 0xff)] ^ t[ 2 * 256 + ((v3 >> 8) & 0xff)] ^ t[ 1 * 256 + ((v3 >> 16) & 0xff)] ^ t[               (v3 >> 24)];
+
+    buffer += 16;
+  }
+
+  // Slicing-by-8 for the rest.
+  if ((end - buffer) >= 8) {
+    auto v0 = crc ^ load_uint32_le(buffer);
+    auto v1 = load_uint32_le(buffer + 4);
+
+    crc = t[7 * 256 + (v0 & 0xff)] ^ t[6 * 256 + ((v0 >> 8) & 0xff)] ^ t[5 * 256 + ((v0 >> 16) & 0xff)] ^ t[4 * 256 + (v0 >> 24)]
+        ^ t[3 * 256 + (v1 & 0xff)] ^ t[2 * 256 + ((v1 >> 8) & 0xff)] ^ t[1 * 256 + ((v1 >> 16) & 0xff)] ^ t[          (v1 >> 24)];
+
+    buffer += 8;
+  }
+
   while (buffer < end) {
-    m_crc = m_table[(m_crc & 0xff) ^ *buffer] ^ (m_crc >> 8);
+    crc = t[(crc & 0xff) ^ *buffer] ^ (crc >> 8);
     ++buffer;
   }
+
+  return crc;
+}
+
+uint32_t
+crc_base_c::update(uint32_t crc,
+                   uint8_t const *buffer,
+                   size_t size)
+  const {
+  if ((m_type == crc_32_ieee_le) && (size >= 64)) {
+    if (auto hardware_function = crc32_ieee_le_hardware_function(); hardware_function) {
+#if defined(MTX_CRC32_PCLMUL)
+      // The folding code only handles multiples of 16 bytes.
+      auto folded_size  = size & ~static_cast<size_t>(15);
+      crc               = hardware_function(crc, buffer, folded_size);
+      buffer           += folded_size;
+      size             -= folded_size;
+#else
+      return hardware_function(crc, buffer, size);
+#endif
+    }
+  }
+
+  return update_with_tables(crc, buffer, size);
+}
+
+// Returns the CRC after processing num_bytes zero bytes starting with
+// the given CRC. Processing one zero byte is a linear operation on the
+// 32 bits of the CRC, therefore it can be expressed as a 32x32 matrix
+// over GF(2) whose powers are calculated by repeated squaring (see
+// zlib's crc32_combine()).
+uint32_t
+crc_base_c::advance_by_zero_bytes(uint32_t crc,
+                                  uint64_t num_bytes)
+  const {
+  using matrix_t = std::array<uint32_t, 32>;
+
+  auto multiply = [](matrix_t const &matrix, uint32_t vector) {
+    uint32_t result{};
+
+    for (auto bit = 0u; vector; ++bit, vector >>= 1)
+      if (vector & 1)
+        result ^= matrix[bit];
+
+    return result;
+  };
+
+  matrix_t op;
+  for (auto bit = 0u; bit < 32u; ++bit) {
+    auto vector = 1u << bit;
+    op[bit]     = m_table[vector & 0xff] ^ (vector >> 8);
+  }
+
+  while (num_bytes) {
+    if (num_bytes & 1)
+      crc = multiply(op, crc);
+
+    num_bytes >>= 1;
+    if (!num_bytes)
+      break;
+
+    matrix_t squared;
+    for (auto bit = 0u; bit < 32u; ++bit)
+      squared[bit] = multiply(op, op[bit]);
+    op = squared;
+  }
+
+  return crc;
+}
+
+void
+crc_base_c::add_impl(uint8_t const *buffer,
+                     size_t size) {
+  m_crc = update(m_crc, buffer, size);
+}
+
+// The CRC over the concatenation of two pieces A and B equals the CRC
+// over A advanced by as many zero bytes as B is long XORed with the CRC
+// over B started at 0. Therefore all pieces but the first one can be
+// processed independently.
+void
+crc_base_c::add_parallel_impl(uint8_t const *buffer,
+                              size_t size,
+                              mtx::thread_pool_c &pool) {
+  auto num_pieces = std::min<size_t>(pool.get_num_threads() + 1, size / ms_min_parallel_piece_size);
+
+  if (num_pieces < 2) {
+    add_impl(buffer, size);
+    return;
+  }
+
+  auto piece_size = size / num_pieces;
+  std::vector<std::pair<std::future<uint32_t>, size_t>> pieces;
+
+  for (auto idx = 1u; idx < num_pieces; ++idx) {
+    auto piece_start = buffer + idx * piece_size;
+    auto this_size   = idx == (num_pieces - 1) ? size - idx * piece_size : piece_size;
+
+    pieces.emplace_back(pool.submit([this, piece_start, this_size]() { return update(0, piece_start, this_size); }), this_size);
+  }
+
+  m_crc = update(m_crc, buffer, piece_size);
+
+  for (auto &[result, this_size] : pieces)
+    m_crc = advance_by_zero_bytes(m_crc, this_size) ^ result.get();
 }
 
 // ----------------------------------------------------------------------
@@ -40,6 +40,15 @@ protected:
 
   static table_parameters_t const ms_table_parameters[6];
 
+  // The tables contain 16 sub-tables of 256 entries each: sub-table k
+  // maps a byte to the CRC of that byte followed by k zero bytes. That
+  // way eight or 16 bytes can be processed in one step.
+  static constexpr std::size_t ms_num_sub_tables = 16;
+
+  // Buffers are only split up for add_parallel() if each piece would
+  // be at least this large.
+  static constexpr std::size_t ms_min_parallel_piece_size = 256 * 1024;
+
 protected:
   type_e m_type;
   table_t &m_table;
@@ -52,6 +61,10 @@ protected:
 
   void init_table();
 
+  uint32_t update(uint32_t crc, uint8_t const *buffer, size_t size) const;
+  uint32_t update_with_tables(uint32_t crc, uint8_t const *buffer, size_t size) const;
+  uint32_t advance_by_zero_bytes(uint32_t crc, uint64_t num_bytes) const;
+
 public:
   virtual ~crc_base_c() = default;
 
@@ -63,6 +76,7 @@ public:
 
 protected:
   virtual void add_impl(uint8_t const *buffer, size_t size);
+  virtual void add_parallel_impl(uint8_t const *buffer, size_t size, mtx::thread_pool_c &pool);
 
   virtual void set_initial_value_impl(uint64_t initial_value) ;
   virtual void set_initial_value_impl(uint8_t const *buffer, size_t size);
@@ -23,6 +23,9 @@
 # include <sys/syscall.h>
 #endif
 
+#include <atomic>
+#include <thread>
+
 #include <matroska/KaxVersion.h>
 
 #include "common/audio_emphasis.h"
@@ -92,14 +95,38 @@ mtx_common_cleanup() {
 }
 
 static std::vector<std::function<void()> > s_to_run_before_exit;
+static std::thread::id const s_main_thread_id = std::this_thread::get_id();
 
 void
 mxrun_before_exit(std::function<void()> function) {
   s_to_run_before_exit.push_back(function);
 }
 
+// The first exit code requested by mxexit() on a worker thread.
+static constexpr auto s_no_exit_requested = std::numeric_limits<int64_t>::min();
+static std::atomic<int64_t> s_exit_code_requested{s_no_exit_requested};
+
+std::optional<int>
+mxexit_requested() {
+  auto code = s_exit_code_requested.load();
+  if (code == s_no_exit_requested)
+    return {};
+  return static_cast<int>(code);
+}
+
 void
 mxexit(int code) {
+  // Tearing everything down from a worker thread would pull the rug
+  // out from under the others. Let the main thread do it instead. The
+  // request is recorded as the exception may be swallowed by the
+  // error handling of code running on the worker.
+  if (std::this_thread::get_id() != s_main_thread_id) {
+    auto expected = s_no_exit_requested;
+    s_exit_code_requested.compare_exchange_strong(expected, code);
+
+    throw mtx::exit_requested_x{code};
+  }
+
   for (auto const &function : s_to_run_before_exit)
     function();
 
@@ -105,6 +105,7 @@ constexpr auto TIMESTAMP_SCALE = 1'000'000;
 void mxrun_before_exit(std::function<void()> function);
 [[noreturn]]
 void mxexit(int code = -1);
+std::optional<int> mxexit_requested();
 
 extern unsigned int verbose;
 
@@ -19,9 +19,10 @@
 #include "common/ebml.h"
 #include "common/endian.h"
 #include "common/strings/formatting.h"
+#include "common/thread_pool.h"
 
 static const char *compression_methods[] = {
-  "unspecified", "zlib", "header_removal", "mpeg4_p2", "mpeg4_p10", "dirac", "dts", "ac3", "mp3", "analyze_header_removal", "none"
+  "unspecified", "zlib", "header_removal", "mpeg4_p2", "mpeg4_p10", "dirac", "dts", "ac3", "mp3", "analyze_header_removal", "zstd", "none"
 };
 
 static const int compression_method_map[] = {
@@ -35,6 +36,7 @@ static const int compression_method_map[] = {
   3,                            // ac3 is header removal
   3,                            // mp3 is header removal
   999999999,                    // analyze_header_removal
+  4,                            // zstd; not part of the Matroska specifications
   0                             // none
 };
 
@@ -87,6 +89,11 @@ compressor_c::create(const char *method) {
   if (!strcasecmp(method, compression_methods[COMPRESSION_ANALYZE_HEADER_REMOVAL]))
     return compressor_ptr(new analyze_header_removal_compressor_c());
 
+#if defined(HAVE_ZSTD)
+  if (!strcasecmp(method, compression_methods[COMPRESSION_ZSTD]))
+    return std::make_shared<zstd_compressor_c>();
+#endif
+
   if (!strcasecmp(method, "none"))
     return std::make_shared<compressor_c>(COMPRESSION_NONE);
 
@@ -103,3 +110,10 @@ compressor_c::create_from_file_name(std::string const &file_name) {
 
   return std::make_shared<compressor_c>(COMPRESSION_NONE);
 }
+
+mtx::thread_pool_c *
+compressor_c::get_thread_pool() {
+  static auto s_pool = 1 < mtx::thread_pool_c::default_num_threads() ? std::make_unique<mtx::thread_pool_c>() : std::unique_ptr<mtx::thread_pool_c>{};
+
+  return s_pool.get();
+}
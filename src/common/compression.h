@@ -29,6 +29,7 @@ enum compression_method_e {
   COMPRESSION_AC3,
   COMPRESSION_MP3,
   COMPRESSION_ANALYZE_HEADER_REMOVAL,
+  COMPRESSION_ZSTD,
   COMPRESSION_NONE,
   COMPRESSION_NUM = COMPRESSION_NONE
 };
@@ -47,6 +48,17 @@ namespace mtx {
   };
 }
 
+namespace mtx {
+class thread_pool_c;
+}
+
+// Settings given on the command line for compression methods that
+// support them.
+struct compression_parameters_t {
+  std::optional<int> level;
+  bool train_dictionary{};
+};
+
 class compressor_c;
 using compressor_ptr = std::shared_ptr<compressor_c>;
 
@@ -68,6 +80,22 @@ public:
     return method;
   }
 
+  // Whether or not compress() and decompress() may be called on
+  // several threads at the same time.
+  virtual bool is_thread_safe() const {
+    return false;
+  }
+
+  virtual void set_parameters(compression_parameters_t const &) {
+  }
+
+  // Compressors may learn from the first frames they compress,
+  // e.g. by training a dictionary that has to be stored in the track
+  // headers. This returns true once after that has happened;
+  // set_track_headers() must be called again then.
+  virtual bool track_headers_changed() {
+    return false;
+  }
 
   virtual memory_cptr compress(memory_cptr const &buffer) {
     return do_compress(buffer->get_buffer(), buffer->get_size());
@@ -93,6 +121,10 @@ public:
   static compressor_ptr create(const char *method);
   static compressor_ptr create_from_file_name(std::string const &file_name);
 
+  // The pool shared by everyone compressing or decompressing frames in
+  // parallel. It's a nullptr if there's only a single CPU core.
+  static mtx::thread_pool_c *get_thread_pool();
+
 protected:
   virtual memory_cptr do_compress(uint8_t const *buffer,
                                   std::size_t size) {
@@ -106,3 +138,4 @@ protected:
 
 #include "common/compression/header_removal.h"
 #include "common/compression/zlib.h"
+#include "common/compression/zstd.h"
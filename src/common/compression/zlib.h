@@ -24,6 +24,10 @@ public:
   zlib_compressor_c();
   virtual ~zlib_compressor_c();
 
+  virtual bool is_thread_safe() const override {
+    return true;
+  }
+
 protected:
   virtual memory_cptr do_compress(uint8_t const *buffer, std::size_t size) override;
   virtual memory_cptr do_decompress(uint8_t const *buffer, std::size_t size) override;
@@ -0,0 +1,217 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   zstd compressor
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#if defined(HAVE_ZSTD)
+
+#include <zdict.h>
+
+#include "common/compression/zstd.h"
+#include "common/ebml.h"
+
+namespace {
+
+// The dictionary is trained once this many frames have been
+// compressed. Only the start of large frames is used for training.
+constexpr std::size_t s_num_samples          = 128;
+constexpr std::size_t s_max_sample_size      = 64 * 1024;
+constexpr std::size_t s_max_dictionary_size  = 64 * 1024;
+
+// Creating the contexts is expensive. Each thread keeps its own so
+// that the compressor can be used on several threads at once.
+ZSTD_CCtx *
+compression_context() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> s_context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  return s_context.get();
+}
+
+ZSTD_DCtx *
+decompression_context() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> s_context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  return s_context.get();
+}
+
+}
+
+zstd_compressor_c::zstd_compressor_c()
+  : compressor_c(COMPRESSION_ZSTD)
+{
+}
+
+zstd_compressor_c::~zstd_compressor_c() {
+}
+
+void
+zstd_compressor_c::set_parameters(compression_parameters_t const &parameters) {
+  if (parameters.level)
+    m_level = *parameters.level;
+
+  m_sampling = parameters.train_dictionary && !m_dictionary;
+}
+
+void
+zstd_compressor_c::set_dictionary(memory_cptr const &dictionary) {
+  m_dictionary = dictionary;
+  m_dictionary->take_ownership();
+
+  m_cdict.reset(ZSTD_createCDict(m_dictionary->get_buffer(), m_dictionary->get_size(), m_level), ZSTD_freeCDict);
+  m_ddict.reset(ZSTD_createDDict(m_dictionary->get_buffer(), m_dictionary->get_size()),          ZSTD_freeDDict);
+
+  if (!m_cdict || !m_ddict)
+    throw mtx::compression_x(Y("The zstd dictionary could not be loaded."));
+}
+
+bool
+zstd_compressor_c::track_headers_changed() {
+  auto changed            = m_track_headers_changed;
+  m_track_headers_changed = false;
+
+  return changed;
+}
+
+void
+zstd_compressor_c::set_track_headers(libmatroska::KaxContentEncoding &c_encoding) {
+  compressor_c::set_track_headers(c_encoding);
+
+  if (m_dictionary)
+    get_child<libmatroska::KaxContentCompSettings>(get_child<libmatroska::KaxContentCompression>(c_encoding)).CopyBuffer(m_dictionary->get_buffer(), m_dictionary->get_size());
+}
+
+void
+zstd_compressor_c::add_sample(uint8_t const *buffer,
+                              std::size_t size) {
+  size = std::min(size, s_max_sample_size);
+
+  m_samples.insert(m_samples.end(), buffer, buffer + size);
+  m_sample_sizes.push_back(size);
+
+  if (m_sample_sizes.size() >= s_num_samples)
+    train_dictionary();
+}
+
+void
+zstd_compressor_c::train_dictionary() {
+  m_sampling = false;
+
+  auto dictionary = memory_c::alloc(std::min(s_max_dictionary_size, m_samples.size() / 10));
+  auto result     = ZDICT_trainFromBuffer(dictionary->get_buffer(), dictionary->get_size(), m_samples.data(), m_sample_sizes.data(), m_sample_sizes.size());
+
+  m_samples      = std::vector<uint8_t>{};
+  m_sample_sizes = std::vector<std::size_t>{};
+
+  if (ZDICT_isError(result)) {
+    mxdebug_if(m_debug, fmt::format("zstd_compressor_c: training a dictionary failed: {0}\n", ZDICT_getErrorName(result)));
+    return;
+  }
+
+  dictionary->resize(result);
+  set_dictionary(dictionary);
+
+  m_track_headers_changed = true;
+
+  mxdebug_if(m_debug, fmt::format("zstd_compressor_c: trained a dictionary of {0} bytes\n", result));
+}
+
+memory_cptr
+zstd_compressor_c::do_compress(uint8_t const *buffer,
+                               std::size_t size) {
+  auto dst     = memory_c::alloc(ZSTD_compressBound(size));
+  auto context = compression_context();
+  auto result  = m_cdict ? ZSTD_compress_usingCDict(context, dst->get_buffer(), dst->get_size(), buffer, size, m_cdict.get())
+               :           ZSTD_compressCCtx(context, dst->get_buffer(), dst->get_size(), buffer, size, m_level);
+
+  if (ZSTD_isError(result))
+    throw mtx::compression_x(fmt::format(FY("zstd compression failed: {0}\n"), ZSTD_getErrorName(result)));
+
+  dst->resize(result);
+
+  mxdebug_if(m_debug, fmt::format("zstd_compressor_c: Compression from {0} to {1}, {2}%\n", size, dst->get_size(), dst->get_size() * 100 / std::max<std::size_t>(size, 1)));
+
+  if (m_sampling)
+    add_sample(buffer, size);
+
+  return dst;
+}
+
+memory_cptr
+zstd_compressor_c::do_decompress(uint8_t const *buffer,
+                                 std::size_t size) {
+  auto context = decompression_context();
+
+  // Frames that were compressed before the dictionary had been
+  // trained don't reference it. Raw content dictionaries don't have
+  // an ID, though, and must always be used.
+  auto use_dictionary = m_ddict && (ZSTD_getDictID_fromFrame(buffer, size) || !ZSTD_getDictID_fromDDict(m_ddict.get()));
+
+  ZSTD_DCtx_reset(context, ZSTD_reset_session_only);
+  ZSTD_DCtx_refDDict(context, use_dictionary ? m_ddict.get() : nullptr);
+
+  auto content_size = ZSTD_getFrameContentSize(buffer, size);
+
+  if (ZSTD_CONTENTSIZE_ERROR == content_size)
+    throw mtx::compression_x(Y("zstd decompression failed: not a valid zstd frame\n"));
+
+  // The content size only covers the first frame. Several concatenated
+  // frames are therefore decompressed in streaming mode, too.
+  auto frame_size = ZSTD_findFrameCompressedSize(buffer, size);
+
+  if (ZSTD_isError(frame_size))
+    throw mtx::compression_x(fmt::format(FY("zstd decompression failed: {0}\n"), ZSTD_getErrorName(frame_size)));
+
+  if ((ZSTD_CONTENTSIZE_UNKNOWN != content_size) && (frame_size == size)) {
+    auto dst    = memory_c::alloc(content_size);
+    auto result = ZSTD_decompressDCtx(context, dst->get_buffer(), dst->get_size(), buffer, size);
+
+    if (ZSTD_isError(result))
+      throw mtx::compression_x(fmt::format(FY("zstd decompression failed: {0}\n"), ZSTD_getErrorName(result)));
+
+    dst->resize(result);
+
+    return dst;
+  }
+
+  // The size isn't stored in the frame, e.g. for frames written by
+  // other applications in streaming mode.
+  auto dst = memory_c::alloc(std::max<std::size_t>(size * 4, ZSTD_DStreamOutSize()));
+  ZSTD_inBuffer in{buffer, size, 0};
+  ZSTD_outBuffer out{dst->get_buffer(), dst->get_size(), 0};
+
+  while (true) {
+    auto result = ZSTD_decompressStream(context, &out, &in);
+
+    if (ZSTD_isError(result))
+      throw mtx::compression_x(fmt::format(FY("zstd decompression failed: {0}\n"), ZSTD_getErrorName(result)));
+
+    // A result of 0 marks the end of a frame. Another one may follow.
+    if ((in.pos == in.size) && !result)
+      break;
+
+    // All input has been used and there's still room for more output,
+    // but the frame isn't complete: it has been truncated.
+    if ((in.pos == in.size) && (out.pos < out.size))
+      throw mtx::compression_x(Y("zstd decompression failed: the frame is truncated\n"));
+
+    if (out.pos == out.size) {
+      dst->resize(dst->get_size() * 2);
+      out.dst  = dst->get_buffer();
+      out.size = dst->get_size();
+    }
+  }
+
+  dst->resize(out.pos);
+
+  return dst;
+}
+
+#endif  // HAVE_ZSTD
@@ -0,0 +1,64 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   zstd compressor
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#if defined(HAVE_ZSTD)
+
+#include <zstd.h>
+
+#include "common/compression.h"
+
+class zstd_compressor_c: public compressor_c {
+protected:
+  int m_level{ZSTD_CLEVEL_DEFAULT};
+  memory_cptr m_dictionary;
+  std::shared_ptr<ZSTD_CDict> m_cdict;
+  std::shared_ptr<ZSTD_DDict> m_ddict;
+
+  // Samples for training a dictionary. Frames compressed before the
+  // dictionary is available don't reference it, and their frame
+  // headers say so.
+  bool m_sampling{}, m_track_headers_changed{};
+  std::vector<uint8_t> m_samples;
+  std::vector<std::size_t> m_sample_sizes;
+
+public:
+  zstd_compressor_c();
+  virtual ~zstd_compressor_c();
+
+  virtual bool is_thread_safe() const override {
+    return !m_sampling;
+  }
+
+  virtual void set_parameters(compression_parameters_t const &parameters) override;
+  virtual bool track_headers_changed() override;
+
+  virtual void set_dictionary(memory_cptr const &dictionary);
+  virtual memory_cptr get_dictionary() const {
+    return m_dictionary;
+  }
+
+  virtual void set_track_headers(libmatroska::KaxContentEncoding &c_encoding) override;
+
+protected:
+  virtual memory_cptr do_compress(uint8_t const *buffer, std::size_t size) override;
+  virtual memory_cptr do_decompress(uint8_t const *buffer, std::size_t size) override;
+
+  virtual void add_sample(uint8_t const *buffer, std::size_t size);
+  virtual void train_dictionary();
+};
+
+#endif  // HAVE_ZSTD
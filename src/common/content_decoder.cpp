@@ -94,6 +94,20 @@ content_decoder_c::initialize(libmatroska::KaxTrackEntry &ktentry) {
         encodings.push_back(enc);
       }
 
+    } else if (4 == enc.comp_algo) {
+#if defined(HAVE_ZSTD)
+      auto compressor = std::make_shared<zstd_compressor_c>();
+      if (enc.comp_settings && enc.comp_settings->get_size())
+        compressor->set_dictionary(enc.comp_settings);
+
+      enc.compressor = compressor;
+      encodings.push_back(enc);
+#else
+      mxwarn(fmt::format(FY("Track {0} was compressed with the algorithm '{1}' which is not supported by this build.\n"), tid, "zstd"));
+      ok = false;
+      break;
+#endif
+
     } else {
       mxwarn(fmt::format(FY("Track {0} has been compressed with an unknown/unsupported compression algorithm ({1}).\n"), tid, enc.comp_algo));
       ok = false;
@@ -117,6 +131,29 @@ content_decoder_c::reverse(memory_cptr &memory,
       memory = ce.compressor->decompress(memory);
 }
 
+// Returns true if reverse() may be called for the scope on several
+// threads at the same time and if there's anything to do at all.
+bool
+content_decoder_c::can_reverse_in_parallel(content_encoding_scope_e scope)
+  const {
+  if (!ok)
+    return false;
+
+  auto num_applicable = 0u;
+
+  for (auto const &ce : encodings) {
+    if (0 == (ce.scope & scope))
+      continue;
+
+    if (!ce.compressor->is_thread_safe())
+      return false;
+
+    ++num_applicable;
+  }
+
+  return 0 < num_applicable;
+}
+
 std::string
 content_decoder_c::descriptive_algorithm_list() {
   std::string list;
@@ -45,6 +45,7 @@ public:
 
   bool initialize(libmatroska::KaxTrackEntry &ktentry);
   void reverse(memory_cptr &data, content_encoding_scope_e scope);
+  bool can_reverse_in_parallel(content_encoding_scope_e scope) const;
   bool is_ok() {
     return ok;
   }
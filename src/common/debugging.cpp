@@ -13,6 +13,7 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
 #include <sstream>
 
 #include <ebml/EbmlDate.h>
@@ -157,9 +158,37 @@ debugging_c::hexdump(memory_c const &buffer_to_dump,
 // ------------------------------------------------------------
 
 std::vector<debugging_option_c::option_c> debugging_option_c::ms_registered_options;
+std::atomic<uint64_t> debugging_option_c::ms_cache_generation{1};
+
+// Options are registered lazily on first use, which might happen on
+// any thread.
+static std::recursive_mutex s_registered_options_mutex;
+
+bool
+debugging_option_c::determine_and_cache()
+  const {
+  std::lock_guard<std::recursive_mutex> lock{s_registered_options_mutex};
+
+  // The generation cannot change while the lock is held.
+  auto generation = ms_cache_generation.load(std::memory_order_acquire);
+  auto requested  = ms_registered_options.at(get_idx()).get();
+
+  m_cached_state.store((generation << 1) | (requested ? 1 : 0), std::memory_order_release);
+
+  return requested;
+}
+
+void
+debugging_option_c::set(std::optional<bool> requested) {
+  std::lock_guard<std::recursive_mutex> lock{s_registered_options_mutex};
+  ms_registered_options.at(get_idx()).m_requested = requested;
+  ++ms_cache_generation;
+}
 
 size_t
 debugging_option_c::register_option(std::string const &option) {
+  std::lock_guard<std::recursive_mutex> lock{s_registered_options_mutex};
+
   auto itr = std::find_if(ms_registered_options.begin(), ms_registered_options.end(), [&option](option_c const &opt) { return opt.m_option == option; });
   if (itr != ms_registered_options.end())
     return std::distance(ms_registered_options.begin(), itr);
@@ -171,8 +200,12 @@ debugging_option_c::register_option(std::string const &option) {
 
 void
 debugging_option_c::invalidate_cache() {
+  std::lock_guard<std::recursive_mutex> lock{s_registered_options_mutex};
+
   for (auto &opt : ms_registered_options)
     opt.m_requested.reset();
+
+  ++ms_cache_generation;
 }
 
 // ------------------------------------------------------------
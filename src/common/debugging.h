@@ -15,6 +15,7 @@
 
 #include "common/common_pch.h"
 
+#include <atomic>
 #include <sstream>
 #include <unordered_map>
 
@@ -61,28 +62,62 @@ class debugging_option_c {
   };
 
 protected:
+  // Only accessed while holding the registration lock.
   mutable size_t m_registered_idx;
   std::string m_option;
 
+  // The cached state is the cache generation it was determined in,
+  // shifted left by one, with the option's value in the lowest bit.
+  // It is only valid as long as the generation hasn't changed, which
+  // happens whenever options are requested or set. Zero means "not
+  // determined yet" as generations start at one.
+  mutable std::atomic<uint64_t> m_cached_state;
+
 private:
   static std::vector<option_c> ms_registered_options;
+  static std::atomic<uint64_t> ms_cache_generation;
 
 public:
   debugging_option_c(std::string const &option)
     : m_registered_idx{std::numeric_limits<size_t>::max()}
     , m_option{option}
+    , m_cached_state{}
   {
   }
 
-  operator bool() const {
-    return ms_registered_options.at(get_idx()).get();
+  debugging_option_c(debugging_option_c const &other)
+    : m_registered_idx{std::numeric_limits<size_t>::max()}
+    , m_option{other.m_option}
+    , m_cached_state{}
+  {
   }
 
-  void set(std::optional<bool> requested) {
-    ms_registered_options.at(get_idx()).m_requested = requested;
+  debugging_option_c &
+  operator =(debugging_option_c const &other) {
+    if (this != &other) {
+      m_registered_idx = std::numeric_limits<size_t>::max();
+      m_option         = other.m_option;
+      m_cached_state   = 0;
+    }
+
+    return *this;
   }
 
+  // Called for each mxdebug_if(), therefore it must not lock.
+  operator bool() const {
+    auto cached_state = m_cached_state.load(std::memory_order_acquire);
+
+    if ((cached_state >> 1) == ms_cache_generation.load(std::memory_order_acquire))
+      return cached_state & 1;
+
+    return determine_and_cache();
+  }
+
+  void set(std::optional<bool> requested);
+
 protected:
+  bool determine_and_cache() const;
+
   std::size_t get_idx() const {
     if (m_registered_idx == std::numeric_limits<size_t>::max())
       m_registered_idx = register_option(m_option);
@@ -22,6 +22,7 @@
 #include "common/endian.h"
 #include "common/list_utils.h"
 #include "common/math.h"
+#include "common/sync_word_scanner.h"
 
 // ---------------------------------------------------------------------------
 
@@ -133,20 +134,16 @@ find_sync_word(uint8_t const *buf,
     // not enough data for one header
     return -1;
 
-  unsigned int offset = 0;
-  auto sync_word      = static_cast<sync_word_e>(get_uint32_be(buf));
-  auto sync_word_ok   = false;
-
-  while ((offset + 4) < size) {
-    sync_word_ok = (sync_word_e::core == sync_word) || (sync_word_e::exss == sync_word);
-    if (sync_word_ok)
-      break;
+  static mtx::sync_word_scanner_c const s_scanner{
+    { static_cast<uint32_t>(sync_word_e::core), 0xffffffff, 4, 0 },
+    { static_cast<uint32_t>(sync_word_e::exss), 0xffffffff, 4, 0 },
+  };
 
-    sync_word = static_cast<sync_word_e>((static_cast<uint32_t>(sync_word) << 8) | buf[offset + 4]);
-    ++offset;
-  }
+  // The last possible position has never been considered; keep it
+  // that way by leaving out the last byte.
+  auto offset = s_scanner.find(buf, size - 1);
 
-  return sync_word_ok ? offset : -1;
+  return offset != mtx::sync_word_scanner_c::npos ? static_cast<int>(offset) : -1;
 }
 
 int
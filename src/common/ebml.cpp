@@ -13,6 +13,7 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
 #include <unordered_set>
 
 #include <ebml/EbmlDummy.h>
@@ -141,6 +142,9 @@ libebml::EbmlCallbacks const *
 find_ebml_callbacks(libebml::EbmlCallbacks const &base,
                     libebml::EbmlId const &id) {
   static std::unordered_map<uint32_t, libebml::EbmlCallbacks const *> s_cache;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   auto itr = s_cache.find(id.GetValue());
   if (itr != s_cache.end())
@@ -186,6 +190,9 @@ libebml::EbmlCallbacks const *
 find_ebml_callbacks(libebml::EbmlCallbacks const &base,
                     char const *debug_name) {
   static std::unordered_map<std::string, libebml::EbmlCallbacks const *> s_cache;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   auto itr = s_cache.find(debug_name);
   if (itr != s_cache.end())
@@ -228,6 +235,9 @@ libebml::EbmlCallbacks const *
 find_ebml_parent_callbacks(libebml::EbmlCallbacks const &base,
                            libebml::EbmlId const &id) {
   static std::unordered_map<uint32_t, libebml::EbmlCallbacks const *> s_cache;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   auto itr = s_cache.find(id.GetValue());
   if (itr != s_cache.end())
@@ -270,6 +280,9 @@ libebml::EbmlSemantic const *
 find_ebml_semantic(libebml::EbmlCallbacks const &base,
                    libebml::EbmlId const &id) {
   static std::unordered_map<uint32_t, libebml::EbmlSemantic const *> s_cache;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   auto itr = s_cache.find(id.GetValue());
   if (itr != s_cache.end())
@@ -428,6 +441,9 @@ find_element_in_master(libebml::EbmlMaster *master,
 static std::unordered_map<uint32_t, bool> const &
 get_deprecated_elements_by_id() {
   static std::unordered_map<uint32_t, bool> s_elements;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   if (!s_elements.empty())
     return s_elements;
@@ -774,6 +790,9 @@ must_be_present_in_master_by_id(libebml::EbmlId const &id) {
 bool
 must_be_present_in_master(libebml::EbmlId const &id) {
   static std::unordered_map<uint32_t, bool> s_must_be_present;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   auto itr = s_must_be_present.find(id.GetValue());
 
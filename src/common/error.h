@@ -37,6 +37,31 @@ public:
   }
 };
 
+// Thrown by mxexit() if it is called from any thread other than the
+// main one. Deliberately not derived from mtx::exception so that
+// handlers for mtx::exception don't catch it. Catch-all handlers that
+// may run on worker threads must rethrow it. As that cannot be
+// guaranteed for all code, mxexit() records the request, too; see
+// mxexit_requested().
+class exit_requested_x: public std::exception {
+protected:
+  int m_code;
+
+public:
+  explicit exit_requested_x(int code)
+    : m_code{code}
+  {
+  }
+
+  virtual const char *what() const throw() {
+    return "program exit requested from worker thread";
+  }
+
+  int code() const {
+    return m_code;
+  }
+};
+
 inline std::ostream &
 operator <<(std::ostream &out,
             exception const &ex) {
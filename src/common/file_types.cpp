@@ -13,6 +13,8 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
+
 #include "common/file_types.h"
 #include "common/strings/editing.h"
 
@@ -22,6 +24,9 @@ static std::vector<file_type_t> s_supported_file_types;
 
 std::vector<file_type_t> &
 file_type_t::get_supported() {
+  static std::mutex s_mutex;
+  std::lock_guard<std::mutex> lock{s_mutex};
+
   if (!s_supported_file_types.empty())
     return s_supported_file_types;
 
@@ -203,7 +203,7 @@ es_parser_c::handle_slice_nalu(memory_cptr const &nalu,
   }
 
   mtx::xyzvc::slice_info_t si;
-  if (!parse_slice(nalu, si))   // no conversion to RBSP; the bit reader takes care of it
+  if (!parse_slice(nalu, si))
     return;
 
   if (!m_pending_frame_data.empty() && si.first_slice_segment_in_pic_flag)
@@ -557,8 +557,8 @@ bool
 es_parser_c::parse_slice(memory_cptr const &nalu,
                          mtx::xyzvc::slice_info_t &si) {
   try {
-    mtx::bits::reader_c r(nalu->get_buffer(), nalu->get_size());
-    r.enable_rbsp_mode();
+    auto rbsp = mtx::mpeg::nalu_to_rbsp(nalu, mtx::xyzvc::SLICE_HEADER_PREFIX_SIZE);
+    mtx::bits::reader_c r(rbsp->get_buffer(), rbsp->get_size());
 
     unsigned int i;
 
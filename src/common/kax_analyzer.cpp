@@ -34,12 +34,14 @@
 #include "common/error.h"
 #include "common/list_utils.h"
 #include "common/kax_analyzer.h"
+#include "common/kax_analyzer_cache.h"
 #include "common/mm_io_x.h"
 #include "common/mm_file_io.h"
 #include "common/mm_proxy_io.h"
 #include "common/mm_read_buffer_io.h"
 #include "common/strings/editing.h"
 #include "common/strings/formatting.h"
+#include "common/vint.h"
 
 namespace {
 
@@ -103,10 +105,16 @@ kax_analyzer_c::~kax_analyzer_c() {
 
 void
 kax_analyzer_c::close_file() {
-  if (m_close_file) {
-    m_file.reset();
-    m_stream.reset();
-  }
+  if (!m_close_file)
+    return;
+
+  m_file.reset();
+  m_stream.reset();
+
+  // Only now that the file has been closed are its size and
+  // modification time final.
+  if (m_cache_needs_update)
+    store_layout_in_cache();
 }
 
 void
@@ -130,6 +138,8 @@ kax_analyzer_c::reopen_file() {
 
 void
 kax_analyzer_c::reopen_file_for_writing() {
+  m_cache_needs_update = m_use_cache && m_segment;
+
   if (m_file && (libebml::MODE_WRITE == m_open_mode))
     return;
 
@@ -270,6 +280,12 @@ kax_analyzer_c::set_parser_start_position(uint64_t position) {
   return *this;
 }
 
+kax_analyzer_c &
+kax_analyzer_c::set_use_cache(bool use_cache) {
+  m_use_cache = use_cache;
+  return *this;
+}
+
 kax_analyzer_c &
 kax_analyzer_c::set_doc_type_version_handler(mtx::doc_type_version_handler_c *handler) {
   m_doc_type_version_handler = handler;
@@ -358,6 +374,13 @@ kax_analyzer_c::process_internal() {
   upper_lvl_el         = 0;
   libebml::EbmlElement *l1{};
 
+  if (m_use_cache && !m_parser_start_position && use_cached_layout()) {
+    show_progress_done();
+    validate_data_structures("process_internal_cached");
+
+    return true;
+  }
+
   // In certain situations the caller doesn't way to have to pay the
   // price for full analysis. Then it can configure the parser to
   // start parsing at a certain offset. libebml::EbmlStream::FindNextElement()
@@ -416,6 +439,9 @@ kax_analyzer_c::process_internal() {
     if (parse_mode_full != m_parse_mode)
       fix_element_sizes(file_size);
 
+    if (m_use_cache && !m_parser_start_position)
+      store_layout_in_cache();
+
     return true;
   }
 
@@ -527,10 +553,12 @@ kax_analyzer_c::update_element(libebml::EbmlElement *e,
 
   } catch (kax_analyzer_c::update_element_result_e result) {
     debug_dump_elements_maybe("update_element_exception");
+    drop_cached_layout();
     return result;
 
   } catch (mtx::mm_io::exception &ex) {
     mxdebug_if(m_debug, fmt::format("I/O exception: {0}\n", ex.what()));
+    drop_cached_layout();
     return uer_error_unknown;
   }
 
@@ -567,6 +595,7 @@ kax_analyzer_c::remove_elements(libebml::EbmlId const &id) {
 
   } catch (kax_analyzer_c::update_element_result_e result) {
     debug_dump_elements_maybe("update_element_exception");
+    drop_cached_layout();
     return result;
   }
 
@@ -1763,6 +1792,92 @@ kax_analyzer_c::with_elements(const libebml::EbmlId &id,
       worker(*data);
 }
 
+bool
+kax_analyzer_c::use_cached_layout() {
+  auto entry = mtx::kax_analyzer_cache::find(m_file_name);
+
+  if (   !entry
+      || entry->m_elements.empty()
+      || (entry->m_segment_end != m_segment_end)
+      || ((parse_mode_full == m_parse_mode) && !entry->m_parsed_fully))
+    return false;
+
+  if (!cached_layout_matches_file(entry->m_elements)) {
+    mxdebug_if(m_debug, fmt::format("kax_analyzer: cached layout of '{0}' doesn't match the file\n", m_file_name));
+    mtx::kax_analyzer_cache::forget(m_file_name);
+    return false;
+  }
+
+  mxdebug_if(m_debug, fmt::format("kax_analyzer: using cached layout of '{0}' with {1} elements\n", m_file_name, entry->m_elements.size()));
+
+  m_data = std::move(entry->m_elements);
+
+  return true;
+}
+
+// Spot-checks the IDs and sizes of all elements that aren't clusters
+// as well as the first and the last cluster.
+bool
+kax_analyzer_c::cached_layout_matches_file(std::vector<kax_analyzer_data_cptr> const &elements) {
+  auto cluster_id    = EBML_ID(libmatroska::KaxCluster);
+  auto first_cluster = std::find_if(elements.begin(),  elements.end(),  [&cluster_id](auto const &e) { return e->m_id == cluster_id; });
+  auto last_cluster  = std::find_if(elements.rbegin(), elements.rend(), [&cluster_id](auto const &e) { return e->m_id == cluster_id; });
+
+  try {
+    for (auto itr = elements.begin(), end = elements.end(); itr != end; ++itr) {
+      auto &element = **itr;
+
+      if ((element.m_id == cluster_id) && (itr != first_cluster) && (itr != last_cluster.base() - 1))
+        continue;
+
+      if ((element.m_pos + 2) > m_segment_end)
+        return false;
+
+      m_file->setFilePointer(element.m_pos);
+
+      auto id   = vint_c::read_ebml_id(*m_file);
+      auto size = vint_c::read(*m_file);
+
+      if (!id.is_valid() || (id.m_value != element.m_id.GetValue()))
+        return false;
+
+      // In fast mode the sizes of elements only found via meta seeks
+      // extend up to the next known element.
+      if (element.m_size_known && (!size.is_valid() || (static_cast<int64_t>(id.m_coded_size + size.m_coded_size + size.m_value) > element.m_size)))
+        return false;
+    }
+
+  } catch (mtx::mm_io::exception &) {
+    return false;
+  }
+
+  return true;
+}
+
+void
+kax_analyzer_c::store_layout_in_cache() {
+  m_cache_needs_update = false;
+
+  if (m_data.empty())
+    return;
+
+  mtx::kax_analyzer_cache::entry_t entry;
+  entry.m_parsed_fully = parse_mode_full == m_parse_mode;
+  entry.m_segment_end  = m_segment_end;
+  entry.m_elements     = m_data;
+
+  mtx::kax_analyzer_cache::store(m_file_name, entry);
+}
+
+void
+kax_analyzer_c::drop_cached_layout() {
+  if (!m_use_cache)
+    return;
+
+  m_cache_needs_update = false;
+  mtx::kax_analyzer_cache::forget(m_file_name);
+}
+
 void
 kax_analyzer_c::determine_webm() {
   auto doc_type = find_child<libebml::EDocType>(*m_ebml_head);
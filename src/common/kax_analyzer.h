@@ -118,6 +118,7 @@ private:
   std::optional<uint64_t> m_parser_start_position;
   bool m_is_webm{};
   mtx::doc_type_version_handler_c *m_doc_type_version_handler{};
+  bool m_use_cache{}, m_cache_needs_update{};
 
 public:                         // Static functions
   static bool probe(std::string file_name);
@@ -153,6 +154,7 @@ public:
   virtual kax_analyzer_c &set_throw_on_error(bool throw_on_error);
   virtual kax_analyzer_c &set_parser_start_position(uint64_t position);
   virtual kax_analyzer_c &set_doc_type_version_handler(mtx::doc_type_version_handler_c *handler);
+  virtual kax_analyzer_c &set_use_cache(bool use_cache);
 
   virtual bool process();
 
@@ -217,6 +219,11 @@ protected:
 
   virtual void determine_webm();
 
+  virtual bool use_cached_layout();
+  virtual bool cached_layout_matches_file(std::vector<kax_analyzer_data_cptr> const &elements);
+  virtual void store_layout_in_cache();
+  virtual void drop_cached_layout();
+
 protected:
   virtual bool process_internal();
 };
@@ -0,0 +1,268 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   a cache of level 1 element layouts determined by kax_analyzer_c
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <filesystem>
+#include <mutex>
+
+#include "common/checksums/base.h"
+#include "common/fs_sys_helpers.h"
+#include "common/json.h"
+#include "common/kax_analyzer_cache.h"
+#include "common/mm_file_io.h"
+#include "common/mm_io_x.h"
+#include "common/path.h"
+
+namespace mtx::kax_analyzer_cache {
+
+namespace {
+
+debugging_option_c s_debug{"kax_analyzer_cache"};
+
+constexpr int s_format_version      = 1;
+constexpr std::size_t s_header_size = 64 * 1024;
+
+std::mutex s_mutex;
+std::unordered_map<std::string, entry_t> s_entries;
+bool s_persistent_storage_enabled{};
+
+std::string
+normalize_file_name(std::string const &file_name) {
+  boost::system::error_code ec;
+  auto path = boost::filesystem::absolute(mtx::fs::to_path(file_name), ec);
+
+  return (ec ? mtx::fs::to_path(file_name) : path).lexically_normal().string();
+}
+
+entry_t
+deep_copy(entry_t const &entry) {
+  auto copy = entry;
+
+  for (auto &element : copy.m_elements)
+    element = std::make_shared<kax_analyzer_data_c>(*element);
+
+  return copy;
+}
+
+// boost::filesystem only offers a resolution of one second.
+int64_t
+get_modification_time(std::string const &file_name) {
+  std::error_code ec;
+  auto modification_time = std::filesystem::last_write_time(std::filesystem::path{mtx::fs::to_path(file_name).native()}, ec);
+
+  return ec ? -1 : static_cast<int64_t>(modification_time.time_since_epoch().count());
+}
+
+bool
+determine_file_properties(std::string const &file_name,
+                          entry_t &entry) {
+  try {
+    mm_file_io_c file{file_name, libebml::MODE_READ};
+
+    entry.m_file_size         = file.get_size();
+    entry.m_modification_time = get_modification_time(file_name);
+
+    auto header = memory_c::alloc(std::min<uint64_t>(s_header_size, entry.m_file_size));
+    header->set_size(file.read(header->get_buffer(), header->get_size()));
+
+    entry.m_header_checksum = mtx::checksum::calculate_as_hex_string(mtx::checksum::algorithm_e::md5, *header);
+
+    return -1 != entry.m_modification_time;
+
+  } catch (mtx::mm_io::exception &) {
+  }
+
+  return false;
+}
+
+bool
+matches_file(entry_t const &entry,
+             entry_t const &actual) {
+  return (entry.m_file_size         == actual.m_file_size)
+      && (entry.m_modification_time == actual.m_modification_time)
+      && (entry.m_header_checksum   == actual.m_header_checksum);
+}
+
+nlohmann::json
+to_json(entry_t const &entry) {
+  auto elements = nlohmann::json::array();
+
+  for (auto const &element : entry.m_elements)
+    elements.push_back(nlohmann::json::array({ element->m_id.GetValue(), element->m_id.GetLength(), element->m_pos, element->m_size, element->m_size_known }));
+
+  return nlohmann::json{
+    { "version",           s_format_version          },
+    { "file_size",         entry.m_file_size         },
+    { "modification_time", entry.m_modification_time },
+    { "header_checksum",   entry.m_header_checksum   },
+    { "parsed_fully",      entry.m_parsed_fully      },
+    { "segment_end",       entry.m_segment_end       },
+    { "elements",          elements                  },
+  };
+}
+
+std::optional<entry_t>
+from_json(nlohmann::json const &json) {
+  if (json.value("version", 0) != s_format_version)
+    return {};
+
+  entry_t entry;
+
+  entry.m_file_size         = json.at("file_size").get<uint64_t>();
+  entry.m_modification_time = json.at("modification_time").get<int64_t>();
+  entry.m_header_checksum   = json.at("header_checksum").get<std::string>();
+  entry.m_parsed_fully      = json.at("parsed_fully").get<bool>();
+  entry.m_segment_end       = json.at("segment_end").get<uint64_t>();
+
+  for (auto const &element : json.at("elements")) {
+    auto id = create_ebml_id_from(element.at(0).get<uint32_t>(), element.at(1).get<std::size_t>());
+    entry.m_elements.emplace_back(kax_analyzer_data_c::create(id, element.at(2).get<uint64_t>(), element.at(3).get<int64_t>(), element.at(4).get<bool>()));
+  }
+
+  return entry;
+}
+
+std::optional<entry_t>
+load_persistent(std::string const &file_name) {
+  auto cache_file_name = get_cache_file_name(file_name);
+
+  try {
+    if (!boost::filesystem::is_regular_file(cache_file_name))
+      return {};
+
+    auto content = mm_file_io_c::slurp(cache_file_name.string());
+    return from_json(mtx::json::parse(content->to_string()));
+
+  } catch (std::exception const &ex) {
+    mxdebug_if(s_debug, fmt::format("load_persistent: reading '{0}' failed: {1}\n", cache_file_name.string(), ex.what()));
+  }
+
+  return {};
+}
+
+void
+store_persistent(std::string const &file_name,
+                 entry_t const &entry) {
+  auto cache_file_name = get_cache_file_name(file_name);
+  auto temp_file_name  = cache_file_name;
+  temp_file_name      += ".tmp";
+
+  try {
+    {
+      mm_file_io_c out{temp_file_name.string(), libebml::MODE_CREATE};
+      out.puts(mtx::json::dump(to_json(entry)));
+    }
+
+    boost::filesystem::rename(temp_file_name, cache_file_name);
+
+  } catch (std::exception const &ex) {
+    mxdebug_if(s_debug, fmt::format("store_persistent: writing '{0}' failed: {1}\n", cache_file_name.string(), ex.what()));
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(temp_file_name, ec);
+  }
+}
+
+} // anonymous namespace
+
+void
+enable_persistent_storage(bool enable) {
+  std::lock_guard<std::mutex> lock{s_mutex};
+  s_persistent_storage_enabled = enable;
+}
+
+bool
+is_persistent_storage_enabled() {
+  std::lock_guard<std::mutex> lock{s_mutex};
+  return s_persistent_storage_enabled;
+}
+
+boost::filesystem::path
+get_cache_file_name(std::string const &file_name) {
+  auto normalized = normalize_file_name(file_name);
+  auto checksum   = mtx::checksum::calculate_as_hex_string(mtx::checksum::algorithm_e::md5, normalized.c_str(), normalized.size());
+
+  return mtx::sys::get_application_data_folder() / "cache" / "kax_analyzer" / (checksum + ".json");
+}
+
+std::optional<entry_t>
+find(std::string const &file_name) {
+  auto normalized = normalize_file_name(file_name);
+
+  std::optional<entry_t> entry;
+
+  {
+    std::lock_guard<std::mutex> lock{s_mutex};
+
+    auto itr = s_entries.find(normalized);
+    if (itr != s_entries.end())
+      entry = deep_copy(itr->second);
+  }
+
+  if (!entry && is_persistent_storage_enabled())
+    entry = load_persistent(file_name);
+
+  if (!entry) {
+    mxdebug_if(s_debug, fmt::format("find: no entry for '{0}'\n", normalized));
+    return {};
+  }
+
+  entry_t actual;
+
+  if (!determine_file_properties(file_name, actual) || !matches_file(*entry, actual)) {
+    mxdebug_if(s_debug, fmt::format("find: entry for '{0}' is outdated\n", normalized));
+    forget(file_name);
+    return {};
+  }
+
+  mxdebug_if(s_debug, fmt::format("find: entry for '{0}' with {1} elements is up to date\n", normalized, entry->m_elements.size()));
+
+  return entry;
+}
+
+void
+store(std::string const &file_name,
+      entry_t const &entry) {
+  auto normalized = normalize_file_name(file_name);
+  auto copy       = deep_copy(entry);
+
+  if (!determine_file_properties(file_name, copy))
+    return;
+
+  mxdebug_if(s_debug, fmt::format("store: entry for '{0}' with {1} elements\n", normalized, copy.m_elements.size()));
+
+  if (is_persistent_storage_enabled())
+    store_persistent(file_name, copy);
+
+  std::lock_guard<std::mutex> lock{s_mutex};
+  s_entries[normalized] = std::move(copy);
+}
+
+void
+forget(std::string const &file_name) {
+  auto normalized = normalize_file_name(file_name);
+
+  {
+    std::lock_guard<std::mutex> lock{s_mutex};
+    s_entries.erase(normalized);
+  }
+
+  if (!is_persistent_storage_enabled())
+    return;
+
+  boost::system::error_code ec;
+  boost::filesystem::remove(get_cache_file_name(file_name), ec);
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   definitions for the cache of level 1 element layouts determined by kax_analyzer_c
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include "common/kax_analyzer.h"
+
+namespace mtx::kax_analyzer_cache {
+
+// The layout of a file's level 1 elements as determined by
+// kax_analyzer_c along with the file's properties used for telling
+// whether or not the layout is still valid.
+struct entry_t {
+  uint64_t m_file_size{};
+  int64_t m_modification_time{};
+  std::string m_header_checksum;
+  bool m_parsed_fully{};
+  uint64_t m_segment_end{};
+  std::vector<kax_analyzer_data_cptr> m_elements;
+};
+
+// Entries are always kept in memory for the lifetime of the
+// process. If enabled they're additionally stored in files in the
+// application data folder so that later runs can use them, too.
+void enable_persistent_storage(bool enable);
+bool is_persistent_storage_enabled();
+
+// Returns a copy of the entry for the file if its size, modification
+// time and header checksum still match.
+std::optional<entry_t> find(std::string const &file_name);
+
+// Stores a copy of the entry after having determined the file's
+// current size, modification time and header checksum. The file must
+// have been closed after the last modification.
+void store(std::string const &file_name, entry_t const &entry);
+
+void forget(std::string const &file_name);
+
+boost::filesystem::path get_cache_file_name(std::string const &file_name);
+
+}
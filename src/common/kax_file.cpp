@@ -52,6 +52,9 @@ kax_file_c::read_next_level1_element(uint32_t wanted_id,
 
     return element;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (mtx::mm_io::exception &e) {
     mxwarn(fmt::format("{0} {1} {2}\n",
                        fmt::format(FY("{0}: an exception occurred (message: {1}; type: {2})."), "kax_file_c::read_next_level1_element()", fmt::format("{0} / {1}", e.what(), e.error()), typeid(e).name()),
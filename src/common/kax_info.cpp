@@ -47,8 +47,10 @@
 #include "common/avc/util.h"
 #include "common/chapters/chapters.h"
 #include "common/checksums/base.h"
+#include "common/checksums/batch.h"
 #include "common/codec.h"
 #include "common/command_line.h"
+#include "common/container.h"
 #include "common/date_time.h"
 #include "common/ebml.h"
 #include "common/endian.h"
@@ -62,6 +64,7 @@
 #include "common/math.h"
 #include "common/mm_io_x.h"
 #include "common/mm_file_io.h"
+#include "common/mm_mem_io.h"
 #include "common/mm_proxy_io.h"
 #include "common/mm_read_buffer_io.h"
 #include "common/mm_write_buffer_io.h"
@@ -69,6 +72,7 @@
 #include "common/stereo_mode.h"
 #include "common/strings/editing.h"
 #include "common/strings/formatting.h"
+#include "common/thread_pool.h"
 #include "common/translation.h"
 #include "common/version.h"
 #include "common/xml/ebml_chapters_converter.h"
@@ -104,6 +108,24 @@ kax_info_c::set_retain_elements(bool enable) {
   p_func()->m_retain_elements = enable;
 }
 
+void
+kax_info_c::set_lazy_clusters(bool enable) {
+  p_func()->m_lazy_clusters = enable;
+}
+
+void
+kax_info_c::set_cluster_range(int64_t start_position,
+                              int64_t end_position) {
+  auto p             = p_func();
+  p->m_lazy_clusters = true;
+  p->m_cluster_range = std::make_pair(start_position, end_position);
+}
+
+void
+kax_info_c::set_num_threads(std::size_t num_threads) {
+  p_func()->m_num_threads = std::max<std::size_t>(num_threads, 1);
+}
+
 void
 kax_info_c::set_use_gui(bool enable) {
   p_func()->m_use_gui = enable;
@@ -596,6 +618,7 @@ kax_info_c::init_custom_element_value_formatters_and_processors() {
   add_pre(EBML_ID(libmatroska::KaxCluster), ([this, p](libebml::EbmlElement &e) -> bool {
     p->m_cluster = static_cast<libmatroska::KaxCluster *>(&e);
     init_timestamp(*p->m_cluster, find_child_value<kax_cluster_timestamp_c>(p->m_cluster), p->m_ts_scale);
+    calculate_frame_checksums(*p->m_cluster);
 
     ui_show_progress(100 * p->m_cluster->GetElementPosition() / p->m_file_size, Y("Parsing file"));
 
@@ -800,6 +823,7 @@ kax_info_c::init_custom_element_value_formatters_and_processors() {
                        : 1 == c_algo ?   "bzLib"
                        : 2 == c_algo ?   "lzo1x"
                        : 3 == c_algo ? Y("header removal")
+                       : 4 == c_algo ?   "zstd"
                        :               Y("unknown"));
   });
 
@@ -918,7 +942,7 @@ kax_info_c::post_block(libebml::EbmlElement &e) {
 
   for (int i = 0, num_frames = block.NumberFrames(); i < num_frames; ++i) {
     auto &data = block.GetBuffer(i);
-    auto adler = mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size());
+    auto adler = get_frame_checksum(data);
 
     std::string adler_str;
     if (p->m_calc_checksums)
@@ -940,6 +964,64 @@ kax_info_c::post_block(libebml::EbmlElement &e) {
   }
 }
 
+// The checksums of all frames in a cluster are calculated up front as
+// one batch. It is spread across the checksum pool if there is one,
+// e.g. with several threads when the clusters aren't read in parallel
+// chunks. The frames are still formatted sequentially, so the output
+// order doesn't change.
+void
+kax_info_c::calculate_frame_checksums(libmatroska::KaxCluster &cluster) {
+  auto p = p_func();
+
+  p->m_frame_checksums.clear();
+
+  if (!p->m_calc_checksums && !p->m_show_summary)
+    return;
+
+  mtx::checksum::batch_c batch{mtx::checksum::algorithm_e::adler32, p->m_checksum_pool.get()};
+  std::vector<libmatroska::DataBuffer const *> frames;
+
+  auto add_frames = [&batch, &frames](libmatroska::KaxInternalBlock &block) {
+    for (int idx = 0, num_frames = block.NumberFrames(); idx < num_frames; ++idx) {
+      auto &data = block.GetBuffer(idx);
+      batch.add(data.Buffer(), data.Size());
+      frames.push_back(&data);
+    }
+  };
+
+  for (auto child : cluster) {
+    if (is_type<libmatroska::KaxSimpleBlock>(*child))
+      add_frames(static_cast<libmatroska::KaxSimpleBlock &>(*child));
+
+    else if (is_type<libmatroska::KaxBlockGroup>(*child)) {
+      auto block = find_child<libmatroska::KaxBlock>(static_cast<libmatroska::KaxBlockGroup &>(*child));
+      if (block)
+        add_frames(*block);
+    }
+  }
+
+  auto checksums = batch.get_results_as_uint();
+
+  for (auto idx = 0u; idx < frames.size(); ++idx)
+    p->m_frame_checksums[frames[idx]] = checksums[idx];
+}
+
+uint32_t
+kax_info_c::get_frame_checksum(libmatroska::DataBuffer &data) {
+  auto p = p_func();
+
+  // Only shown if checksums are enabled or in summary mode.
+  if (!p->m_calc_checksums && !p->m_show_summary)
+    return 0;
+
+  auto itr = p->m_frame_checksums.find(&data);
+  if (itr != p->m_frame_checksums.end())
+    return itr->second;
+
+  // Blocks outside of a cluster, e.g. in damaged files.
+  return mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size());
+}
+
 void
 kax_info_c::show_frame_summary(libebml::EbmlElement &e) {
   auto p         = p_func();
@@ -1068,7 +1150,7 @@ kax_info_c::post_simple_block(libebml::EbmlElement &e) {
 
   for (int idx = 0; idx < num_frames; ++idx) {
     auto &data = block.GetBuffer(idx);
-    auto adler = mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size());
+    auto adler = get_frame_checksum(data);
 
     std::string adler_str;
     if (p->m_calc_checksums)
@@ -1123,24 +1205,65 @@ kax_info_c::handle_segment(libmatroska::KaxSegment &l0) {
   auto p        = p_func();
   auto l1       = std::shared_ptr<libebml::EbmlElement>{};
   auto kax_file = std::make_shared<kax_file_c>(*p->m_in);
+  auto cache_io = dynamic_cast<mm_read_buffer_io_c *>(p->m_in.get());
+  auto lazy     = p->m_lazy_clusters || p->m_process_clusters_in_parallel;
   p->m_level    = 1;
 
   kax_file->set_segment_end(l0);
 
+  p->m_seek_head_entries.clear();
+  p->m_cue_cluster_positions.clear();
+  p->m_first_cluster_position.reset();
+  p->m_segment_data_start = l0.GetDataStart();
+  p->m_segment_end        = kax_file->get_segment_end();
+
   // Prevent reporting "first timestamp after resync":
   kax_file->set_timestamp_scale(-1);
 
-  while ((l1 = kax_file->read_next_level1_element())) {
-    retain_element(l1);
+  at_scope_exit_c reset_buffer_size([cache_io]() {
+    if (cache_io)
+      cache_io->set_buffer_size();
+  });
 
-    if (is_type<libmatroska::KaxCluster>(*l1) && !p->m_continue_at_cluster && !p->m_show_summary) {
-      ui_show_element(*l1);
-      return result_e::succeeded;
+  while (true) {
+    if (lazy && (skip_clusters_via_seek_head() || skip_cluster(*kax_file))) {
+      if (p->m_abort)
+        return result_e::aborted;
+      continue;
+    }
+
+    if (cache_io)
+      cache_io->set_buffer_size();
+
+    if (!(l1 = kax_file->read_next_level1_element()))
+      break;
+
+    auto element_size = kax_file->get_element_size(*l1);
+
+    if (lazy)
+      record_level1_element(get_ebml_id(*l1).GetValue(), l1->GetElementPosition(), element_size);
+
+    // Clusters of unknown size have to be read completely in lazy mode
+    // in order to find their end. Their content is only formatted on
+    // demand, too.
+    auto is_cluster   = is_type<libmatroska::KaxCluster>(*l1);
+    auto skip_content = lazy && is_cluster && !is_in_cluster_range(l1->GetElementPosition());
+
+    if (!skip_content) {
+      retain_element(l1);
+
+      if (!lazy && is_cluster && !p->m_continue_at_cluster && !p->m_show_summary) {
+        ui_show_element(*l1);
+        return result_e::succeeded;
+      }
 
-    } else
       handle_elements_generic(*l1);
 
-    if (!p->m_in->setFilePointer2(l1->GetElementPosition() + kax_file->get_element_size(*l1)))
+      if (lazy && is_type<libmatroska::KaxSeekHead>(*l1))
+        record_seek_head_entries(static_cast<libebml::EbmlMaster &>(*l1));
+    }
+
+    if (!p->m_in->setFilePointer2(l1->GetElementPosition() + element_size))
       break;
 
     auto in_parent = !l0.IsFiniteSize()
@@ -1156,6 +1279,234 @@ kax_info_c::handle_segment(libmatroska::KaxSegment &l0) {
   return result_e::succeeded;
 }
 
+// In lazy mode only the header of a cluster is read. Its position is
+// recorded, and the whole cluster is skipped. Returns false without
+// moving the file pointer if the next element isn't a cluster of known
+// size, e.g. for all the other level 1 elements or for damaged files,
+// which are then read the normal way. Clusters in the requested range
+// are read & formatted in place.
+bool
+kax_info_c::skip_cluster(kax_file_c &kax_file) {
+  auto p        = p_func();
+  auto position = static_cast<int64_t>(p->m_in->getFilePointer());
+
+  if (kax_file.get_segment_end() && (static_cast<uint64_t>(position) >= kax_file.get_segment_end()))
+    return false;
+
+  auto id   = vint_c::read_ebml_id(*p->m_in);
+  auto size = id.is_valid() && (id.m_value == EBML_ID(libmatroska::KaxCluster).GetValue()) ? vint_c::read(*p->m_in) : vint_c{};
+  auto end  = static_cast<int64_t>(p->m_in->getFilePointer()) + size.m_value;
+
+  if (size.is_unknown() || (end > static_cast<int64_t>(p->m_file_size))) {
+    p->m_in->setFilePointer(position);
+    return false;
+  }
+
+  if (!p->m_first_cluster_position)
+    p->m_first_cluster_position = position;
+
+  record_level1_element(id.m_value, position, end - position);
+
+  if (is_in_cluster_range(position)) {
+    if (process_level1_element({ static_cast<uint32_t>(id.m_value), position, end - position }) != result_e::succeeded)
+      ui_show_error(fmt::format(FY("The cluster at position {0} could not be read."), position));
+
+    p->m_level = 1;
+    p->m_in->setFilePointer(end);
+
+    return true;
+  }
+
+  // Reading ahead would only fill the buffer with the cluster's
+  // content which is skipped anyway.
+  auto cache_io = dynamic_cast<mm_read_buffer_io_c *>(p->m_in.get());
+  if (cache_io)
+    cache_io->set_buffer_size(64);
+
+  p->m_in->setFilePointer(end);
+
+  return true;
+}
+
+// Skips all clusters at once when reaching the first one. This is only
+// possible if the seek head references level 1 elements located after
+// it, e.g. the cues or tags. Otherwise each cluster's header has to be
+// read in order to find the elements following the clusters. The
+// clusters in the requested range are located via the cues & read in
+// place.
+bool
+kax_info_c::skip_clusters_via_seek_head() {
+  auto p = p_func();
+
+  if (p->m_process_clusters_in_parallel || p->m_first_cluster_position || p->m_seek_head_entries.empty())
+    return false;
+
+  auto position = static_cast<int64_t>(p->m_in->getFilePointer());
+  auto id       = vint_c::read_ebml_id(*p->m_in);
+
+  p->m_in->setFilePointer(position);
+
+  if (!id.is_valid() || (id.m_value != EBML_ID(libmatroska::KaxCluster).GetValue()))
+    return false;
+
+  // Seek heads located after the clusters may reference further
+  // elements.
+  auto seek_heads_read = std::vector<int64_t>{};
+  auto found_new       = true;
+
+  while (found_new) {
+    found_new = false;
+
+    for (auto const &[entry_position, entry_id] : p->m_seek_head_entries) {
+      if (   (entry_id != EBML_ID(libmatroska::KaxSeekHead).GetValue())
+          || (entry_position <= position)
+          || mtx::includes(seek_heads_read, entry_position))
+        continue;
+
+      seek_heads_read.push_back(entry_position);
+
+      if (!p->m_in->setFilePointer2(entry_position))
+        continue;
+
+      auto l1 = kax_file_c{*p->m_in}.read_next_level1_element(entry_id);
+      if (l1 && (static_cast<int64_t>(l1->GetElementPosition()) == entry_position)) {
+        record_seek_head_entries(static_cast<libebml::EbmlMaster &>(*l1));
+        found_new = true;
+        break;
+      }
+    }
+  }
+
+  auto trailing = std::find_if(p->m_seek_head_entries.upper_bound(position), p->m_seek_head_entries.end(), [](auto const &entry) {
+    return entry.second != EBML_ID(libmatroska::KaxCluster).GetValue();
+  });
+
+  if (   (trailing == p->m_seek_head_entries.end())
+      || (p->m_segment_end && (static_cast<uint64_t>(trailing->first) >= p->m_segment_end))) {
+    p->m_in->setFilePointer(position);
+    return false;
+  }
+
+  p->m_first_cluster_position = position;
+
+  if (p->m_cluster_range) {
+    read_cue_cluster_positions();
+
+    auto result = process_clusters_in_range(p->m_cluster_range->first, std::min(p->m_cluster_range->second, trailing->first));
+    if (result == result_e::aborted)
+      p->m_abort = true;
+    else if (result != result_e::succeeded)
+      ui_show_error(Y("The clusters in the requested range could not be read."));
+
+    p->m_level = 1;
+  }
+
+  p->m_in->setFilePointer(trailing->first);
+
+  return true;
+}
+
+void
+kax_info_c::record_seek_head_entries(libebml::EbmlMaster &seek_head) {
+  auto p = p_func();
+
+  for (auto const &child : seek_head) {
+    if (!is_type<libmatroska::KaxSeek>(child))
+      continue;
+
+    auto &seek         = static_cast<libmatroska::KaxSeek &>(*child);
+    auto seek_position = find_child_value<libmatroska::KaxSeekPosition, int64_t>(seek, -1);
+    auto seek_id       = find_child<libmatroska::KaxSeekID>(seek);
+
+    if ((-1 == seek_position) || !seek_id || (seek_id->GetSize() > 4))
+      continue;
+
+    auto position = p->m_segment_data_start + seek_position;
+    if (position < static_cast<int64_t>(p->m_file_size))
+      p->m_seek_head_entries[position] = create_ebml_id_from(*seek_id).GetValue();
+  }
+}
+
+// Reads the cues referenced by the seek head without formatting them
+// in order to find clusters without having to read the headers of all
+// the clusters before them.
+void
+kax_info_c::read_cue_cluster_positions() {
+  auto p = p_func();
+
+  p->m_cue_cluster_positions.clear();
+
+  auto cues_entry = std::find_if(p->m_seek_head_entries.begin(), p->m_seek_head_entries.end(), [](auto const &entry) {
+    return entry.second == EBML_ID(libmatroska::KaxCues).GetValue();
+  });
+
+  if ((cues_entry == p->m_seek_head_entries.end()) || !p->m_in->setFilePointer2(cues_entry->first))
+    return;
+
+  auto l1 = kax_file_c{*p->m_in}.read_next_level1_element(cues_entry->second);
+  if (!l1 || (static_cast<int64_t>(l1->GetElementPosition()) != cues_entry->first))
+    return;
+
+  for (auto const &cue_point : static_cast<libebml::EbmlMaster &>(*l1)) {
+    if (!is_type<libmatroska::KaxCuePoint>(cue_point))
+      continue;
+
+    for (auto const &track_positions : static_cast<libmatroska::KaxCuePoint &>(*cue_point)) {
+      if (!is_type<libmatroska::KaxCueTrackPositions>(track_positions))
+        continue;
+
+      auto cluster_position = find_child_value<libmatroska::KaxCueClusterPosition, int64_t>(static_cast<libmatroska::KaxCueTrackPositions &>(*track_positions), -1);
+      if (-1 != cluster_position)
+        p->m_cue_cluster_positions.push_back(p->m_segment_data_start + cluster_position);
+    }
+  }
+
+  std::sort(p->m_cue_cluster_positions.begin(), p->m_cue_cluster_positions.end());
+  p->m_cue_cluster_positions.erase(std::unique(p->m_cue_cluster_positions.begin(), p->m_cue_cluster_positions.end()), p->m_cue_cluster_positions.end());
+}
+
+// The last known cluster position at or before the given position,
+// either from the cues or from the clusters recorded so far.
+int64_t
+kax_info_c::find_cluster_scan_start(int64_t start_position) {
+  auto p        = p_func();
+  auto position = p->m_first_cluster_position.value_or(start_position);
+  auto cue_itr  = std::upper_bound(p->m_cue_cluster_positions.begin(), p->m_cue_cluster_positions.end(), start_position);
+  if (cue_itr != p->m_cue_cluster_positions.begin())
+    position = std::max(position, *(cue_itr - 1));
+
+  for (auto const &element : p->m_level1_elements)
+    if (   (element.id       == EBML_ID(libmatroska::KaxCluster).GetValue())
+        && (element.position <= start_position))
+      position = std::max(position, element.position);
+
+  return position;
+}
+
+bool
+kax_info_c::is_in_cluster_range(int64_t position) {
+  auto p = p_func();
+
+  return p->m_cluster_range
+      && !p->m_process_clusters_in_parallel
+      && (position >= p->m_cluster_range->first)
+      && (position <  p->m_cluster_range->second);
+}
+
+void
+kax_info_c::record_level1_element(uint32_t id,
+                                  int64_t position,
+                                  int64_t size) {
+  auto p = p_func();
+
+  p->m_level1_elements.push_back({ id, position, size });
+
+  // The output of the clusters read by the worker threads has to be
+  // inserted where it would have been written by a sequential scan.
+  if (p->m_process_clusters_in_parallel)
+    p->m_level1_output_positions.push_back(p->m_out->getFilePointer());
+}
+
 bool
 kax_info_c::run_generic_pre_processors(libebml::EbmlElement &e) {
   auto p = p_func();
@@ -1240,6 +1591,7 @@ kax_info_c::reset() {
   p->m_tracks.clear();
   p->m_tracks_by_number.clear();
   p->m_track_info.clear();
+  p->m_level1_elements.clear();
   p->m_es.reset();
   p->m_in.reset();
 }
@@ -1251,6 +1603,32 @@ kax_info_c::process_file() {
   p->m_file_size = p->m_in->get_size();
   p->m_es        = std::make_shared<libebml::EbmlStream>(*p->m_in);
 
+  p->m_level1_elements.clear();
+  p->m_level1_output_positions.clear();
+
+  // When reading clusters in parallel everything else is written to a
+  // memory buffer first so that the clusters' output can be inserted
+  // at the right places later.
+  p->m_process_clusters_in_parallel = can_process_clusters_in_parallel();
+
+  auto out = p->m_out;
+  if (p->m_process_clusters_in_parallel)
+    p->m_out = std::make_shared<mm_mem_io_c>(nullptr, 0, 64 * 1024);
+
+  // Otherwise the frames' checksums of each cluster can still be
+  // calculated in parallel.
+  else if ((1 < p->m_num_threads) && !p->m_checksum_pool)
+    p->m_checksum_pool = std::make_unique<mtx::thread_pool_c>(p->m_num_threads);
+
+  at_scope_exit_c restore_output([p, out]() {
+    if (p->m_out == out)
+      return;
+
+    auto header_output = static_cast<mm_mem_io_c &>(*p->m_out).get_content();
+    p->m_out           = out;
+    p->m_out->write(header_output.data(), header_output.size());
+  });
+
   // Find the libebml::EbmlHead element. Must be the first one.
   auto l0 = ebml_element_cptr{ p->m_es->FindNextID(EBML_INFO(libebml::EbmlHead), 0xFFFFFFFFL) };
   if (!l0 || !is_type<libebml::EbmlHead>(*l0)) {
@@ -1290,10 +1668,20 @@ kax_info_c::process_file() {
 
     l0->SkipData(*p->m_es, EBML_CONTEXT(l0.get()));
 
-    if (!p->m_continue_at_cluster && !p->m_show_summary)
+    if (!p->m_continue_at_cluster && !p->m_show_summary && !p->m_lazy_clusters)
       break;
   }
 
+  if (p->m_process_clusters_in_parallel) {
+    auto header_output = std::static_pointer_cast<mm_mem_io_c>(p->m_out);
+    p->m_out           = out;
+    auto range         = p->m_cluster_range.value_or(std::make_pair(int64_t{}, std::numeric_limits<int64_t>::max()));
+    auto result        = process_clusters_in_parallel(range.first, range.second, *header_output, *out);
+    if (result != result_e::succeeded)
+      return result;
+
+  }
+
   if (!p->m_use_gui && p->m_show_track_info)
     display_track_info();
 
@@ -1361,6 +1749,242 @@ kax_info_c::abort() {
   p_func()->m_abort = true;
 }
 
+std::vector<level1_element_t> const &
+kax_info_c::get_level1_elements() {
+  return p_func()->m_level1_elements;
+}
+
+kax_info_c::result_e
+kax_info_c::process_level1_element(level1_element_t const &element) {
+  auto p = p_func();
+
+  if (!p->m_in || !p->m_in->setFilePointer2(element.position))
+    return result_e::failed;
+
+  auto kax_file = kax_file_c{*p->m_in};
+  kax_file.set_timestamp_scale(-1);
+
+  auto l1 = kax_file.read_next_level1_element(element.id);
+  if (!l1 || (static_cast<int64_t>(l1->GetElementPosition()) != element.position))
+    return result_e::failed;
+
+  retain_element(l1);
+
+  p->m_level = 1;
+  handle_elements_generic(*l1);
+
+  return p->m_abort ? result_e::aborted : result_e::succeeded;
+}
+
+// Reads & formats all clusters starting in the range [start_position,
+// end_position). The clusters are located by walking their headers
+// from the closest known cluster position, either from the cues or from
+// the clusters recorded by a lazy scan.
+kax_info_c::result_e
+kax_info_c::process_clusters_in_range(int64_t start_position,
+                                      int64_t end_position) {
+  auto p        = p_func();
+  auto position = find_cluster_scan_start(start_position);
+  auto cluster  = EBML_ID(libmatroska::KaxCluster).GetValue();
+
+  // Cue entries may point to invalid positions in damaged files.
+  if (p->m_first_cluster_position && (position != *p->m_first_cluster_position)) {
+    if (!p->m_in->setFilePointer2(position) || (vint_c::read_ebml_id(*p->m_in).m_value != cluster))
+      position = *p->m_first_cluster_position;
+  }
+
+  while (position < end_position) {
+    if (p->m_segment_end && (static_cast<uint64_t>(position) >= p->m_segment_end))
+      break;
+
+    if (!p->m_in->setFilePointer2(position))
+      break;
+
+    auto id   = vint_c::read_ebml_id(*p->m_in);
+    auto size = id.is_valid() && (id.m_value == cluster) ? vint_c::read(*p->m_in) : vint_c{};
+
+    if (!size.is_valid())
+      break;
+
+    auto element = level1_element_t{ cluster, position, static_cast<int64_t>(p->m_in->getFilePointer()) + size.m_value - position };
+
+    // Clusters of unknown size have to be read in order to find their
+    // end.
+    if (size.is_unknown()) {
+      p->m_in->setFilePointer(position);
+
+      auto kax_file = kax_file_c{*p->m_in};
+      auto l1       = kax_file.read_next_level1_element(cluster);
+      if (!l1 || (static_cast<int64_t>(l1->GetElementPosition()) != position))
+        break;
+
+      element.size = kax_file.get_element_size(*l1);
+    }
+
+    if (element.size <= 0)
+      break;
+
+    if (position >= start_position) {
+      auto result = process_level1_element(element);
+      if (result != result_e::succeeded)
+        return result;
+    }
+
+    position += element.size;
+  }
+
+  return result_e::succeeded;
+}
+
+bool
+kax_info_c::can_process_clusters_in_parallel() {
+  auto p = p_func();
+
+  // Worker threads open their own handles for the source file. The GUI
+  // reads clusters on demand anyway.
+  return (1 < p->m_num_threads)
+      && !p->m_use_gui
+      && !p->m_source_file_name.empty()
+      && (p->m_continue_at_cluster || p->m_show_summary);
+}
+
+// Reads all clusters starting in the range [start_position,
+// end_position) on worker threads. Consecutive clusters are grouped into
+// chunks of roughly s_chunk_size bytes. Chunks are processed by
+// independent kax_info_c instances. Their output is written in file
+// order, interleaved with the output of all the other elements, and the
+// track statistics are merged in file order, too, so that the result
+// matches the one of the sequential scan.
+kax_info_c::result_e
+kax_info_c::process_clusters_in_parallel(int64_t start_position,
+                                         int64_t end_position,
+                                         mm_mem_io_c &header_output,
+                                         mm_io_c &out) {
+  static debugging_option_c s_debug{"kax_info_parallel"};
+  static constexpr int64_t s_chunk_size = 16 * 1024 * 1024;
+
+  auto p             = p_func();
+  auto &elements     = p->m_level1_elements;
+  auto header_buffer = header_output.get_ro_buffer();
+  auto header_size   = header_output.getFilePointer();
+  auto header_pos    = uint64_t{};
+  auto chunks        = std::vector<std::shared_ptr<cluster_chunk_t>>{};
+  auto chunk_bytes   = int64_t{};
+  auto num_clusters  = std::size_t{};
+
+  for (auto idx = 0u; idx < elements.size(); ++idx) {
+    auto const &element = elements[idx];
+
+    if (   (element.id       != EBML_ID(libmatroska::KaxCluster).GetValue())
+        || (element.position <  start_position)
+        || (element.position >= end_position))
+      continue;
+
+    if (chunks.empty() || (chunk_bytes >= s_chunk_size)) {
+      chunks.emplace_back(std::make_shared<cluster_chunk_t>());
+      chunk_bytes = 0;
+    }
+
+    chunks.back()->m_element_indexes.push_back(idx);
+    chunk_bytes += element.size;
+    ++num_clusters;
+  }
+
+  mtx::thread_pool_c pool{std::min<std::size_t>(p->m_num_threads, std::max<std::size_t>(chunks.size(), 1))};
+
+  mxdebug_if(s_debug, fmt::format("process_clusters_in_parallel: {0} clusters in {1} chunks, {2} threads\n", num_clusters, chunks.size(), pool.get_num_threads()));
+
+  // Limit the number of chunks whose output is kept in memory.
+  auto max_in_flight = 2 * pool.get_num_threads();
+  auto in_flight     = std::deque<std::pair<std::shared_ptr<cluster_chunk_t>, std::future<void>>>{};
+  auto next_chunk    = chunks.begin();
+
+  while ((next_chunk != chunks.end()) || !in_flight.empty()) {
+    while ((next_chunk != chunks.end()) && (in_flight.size() < max_in_flight)) {
+      auto chunk = *next_chunk++;
+      in_flight.emplace_back(chunk, pool.submit([this, chunk]() { process_cluster_chunk(*chunk); }));
+    }
+
+    auto chunk = in_flight.front().first;
+    in_flight.front().second.get();
+    in_flight.pop_front();
+
+    auto output_pos = std::size_t{};
+
+    for (auto idx = 0u; idx < chunk->m_element_indexes.size(); ++idx) {
+      auto insert_at = p->m_level1_output_positions[chunk->m_element_indexes[idx]];
+
+      out.write(&header_buffer[header_pos], insert_at - header_pos);
+      out.write(&chunk->m_output[output_pos], chunk->m_output_ends[idx] - output_pos);
+
+      header_pos = insert_at;
+      output_pos = chunk->m_output_ends[idx];
+    }
+
+    for (auto const &[track_number, chunk_tinfo] : chunk->m_track_info) {
+      auto &tinfo = p->m_track_info[track_number];
+
+      tinfo.m_size   += chunk_tinfo.m_size;
+      tinfo.m_blocks += chunk_tinfo.m_blocks;
+
+      for (auto ref_idx = 0; ref_idx < 3; ++ref_idx)
+        tinfo.m_blocks_by_ref_num[ref_idx] += chunk_tinfo.m_blocks_by_ref_num[ref_idx];
+
+      if (chunk_tinfo.m_min_timestamp && (!tinfo.m_min_timestamp || (*chunk_tinfo.m_min_timestamp < *tinfo.m_min_timestamp)))
+        tinfo.m_min_timestamp = chunk_tinfo.m_min_timestamp;
+
+      if (chunk_tinfo.m_max_timestamp && (!tinfo.m_max_timestamp || (*chunk_tinfo.m_max_timestamp >= *tinfo.m_max_timestamp))) {
+        tinfo.m_max_timestamp              = chunk_tinfo.m_max_timestamp;
+        tinfo.m_add_duration_for_n_packets = chunk_tinfo.m_add_duration_for_n_packets;
+      }
+    }
+  }
+
+  out.write(&header_buffer[header_pos], header_size - header_pos);
+
+  return result_e::succeeded;
+}
+
+// Runs on a worker thread. Only reads the main instance's state which
+// isn't modified while the workers are running.
+void
+kax_info_c::process_cluster_chunk(cluster_chunk_t &chunk) {
+  auto p = p_func();
+
+  kax_info_c worker;
+  auto wp = worker.p_func();
+
+  wp->m_calc_checksums      = p->m_calc_checksums;
+  wp->m_show_summary        = p->m_show_summary;
+  wp->m_show_hexdump        = p->m_show_hexdump;
+  wp->m_show_size           = p->m_show_size;
+  wp->m_show_positions      = p->m_show_positions;
+  wp->m_show_track_info     = p->m_show_track_info;
+  wp->m_hex_positions       = p->m_hex_positions;
+  wp->m_continue_at_cluster = p->m_continue_at_cluster;
+  wp->m_show_all_elements   = p->m_show_all_elements;
+  wp->m_hexdump_max_size    = p->m_hexdump_max_size;
+  wp->m_ts_scale            = p->m_ts_scale;
+  wp->m_file_size           = p->m_file_size;
+  wp->m_tracks              = p->m_tracks;
+  wp->m_tracks_by_number    = p->m_tracks_by_number;
+
+  auto output = std::make_shared<mm_mem_io_c>(nullptr, 0, 1024 * 1024);
+  wp->m_out   = output;
+  wp->m_in    = std::make_shared<mm_read_buffer_io_c>(mm_file_io_c::open(p->m_source_file_name));
+  wp->m_es    = std::make_shared<libebml::EbmlStream>(*wp->m_in);
+
+  for (auto idx : chunk.m_element_indexes) {
+    if (worker.process_level1_element(p->m_level1_elements[idx]) != result_e::succeeded)
+      worker.ui_show_error(fmt::format(FY("The cluster at position {0} could not be read."), p->m_level1_elements[idx].position));
+
+    chunk.m_output_ends.push_back(output->getFilePointer());
+  }
+
+  chunk.m_output     = output->get_content();
+  chunk.m_track_info = std::move(wp->m_track_info);
+}
+
 void
 kax_info_c::retain_element(std::shared_ptr<libebml::EbmlElement> const &element) {
   auto p = p_func();
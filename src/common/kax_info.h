@@ -17,6 +17,8 @@
 
 #include <matroska/KaxCluster.h>
 
+class kax_file_c;
+
 namespace mtx {
 
 namespace kax_info {
@@ -30,8 +32,16 @@ public:
 };
 
 struct track_t;
+struct cluster_chunk_t;
 class private_c;
 
+// Position & total size including the header of a level 1 element
+// found while scanning a segment.
+struct level1_element_t {
+  uint32_t id{};
+  int64_t position{}, size{};
+};
+
 }
 
 class kax_info_c {
@@ -68,6 +78,9 @@ public:
   void set_source_file(mm_io_cptr const &file);
   void set_source_file_name(std::string const &file_name);
   void set_retain_elements(bool enable);
+  void set_lazy_clusters(bool enable);
+  void set_cluster_range(int64_t start_position, int64_t end_position);
+  void set_num_threads(std::size_t num_threads);
 
   void reset();
   virtual result_e open_and_process_file(std::string const &file_name);
@@ -75,6 +88,10 @@ public:
   virtual result_e process_file();
   void abort();
 
+  std::vector<kax_info::level1_element_t> const &get_level1_elements();
+  result_e process_level1_element(kax_info::level1_element_t const &element);
+  result_e process_clusters_in_range(int64_t start_position, int64_t end_position);
+
   std::string create_element_text(std::string const &text, std::optional<int64_t> position, std::optional<int64_t> size, std::optional<int64_t> data_size);
   std::string create_unknown_element_text(libebml::EbmlElement &e);
   std::string create_known_element_but_not_allowed_here_text(libebml::EbmlElement &e);
@@ -117,6 +134,8 @@ protected:
 
   void show_element(libebml::EbmlElement *l, int level, std::string const &info, std::optional<int64_t> position = {}, std::optional<int64_t> size = {});
   void show_frame_summary(libebml::EbmlElement &e);
+  void calculate_frame_checksums(libmatroska::KaxCluster &cluster);
+  uint32_t get_frame_checksum(libmatroska::DataBuffer &data);
 
   void add_track(std::shared_ptr<kax_info::track_t> const &t);
   kax_info::track_t *find_track(int tnum);
@@ -126,6 +145,17 @@ protected:
   void handle_block_group(libebml::EbmlElement *&l2, libmatroska::KaxCluster *&cluster);
   void handle_elements_generic(libebml::EbmlElement &e);
   result_e handle_segment(libmatroska::KaxSegment &l0);
+  bool skip_cluster(kax_file_c &kax_file);
+  bool skip_clusters_via_seek_head();
+  void record_seek_head_entries(libebml::EbmlMaster &seek_head);
+  void read_cue_cluster_positions();
+  int64_t find_cluster_scan_start(int64_t start_position);
+  bool is_in_cluster_range(int64_t position);
+  void record_level1_element(uint32_t id, int64_t position, int64_t size);
+
+  bool can_process_clusters_in_parallel();
+  result_e process_clusters_in_parallel(int64_t start_position, int64_t end_position, mm_mem_io_c &header_output, mm_io_c &out);
+  void process_cluster_chunk(kax_info::cluster_chunk_t &chunk);
 
   void display_track_info();
 
@@ -15,6 +15,8 @@
 
 #include "common/common_pch.h"
 
+#include "common/thread_pool.h"
+
 namespace mtx::kax_info {
 
 struct track_t {
@@ -30,12 +32,22 @@ struct track_info_t {
   std::optional<int64_t> m_min_timestamp, m_max_timestamp;
 };
 
+// A run of consecutive clusters read by one worker thread. The output
+// is collected in memory & written in file order by the main thread.
+struct cluster_chunk_t {
+  std::vector<std::size_t> m_element_indexes, m_output_ends;
+  std::string m_output;
+  std::unordered_map<unsigned int, track_info_t> m_track_info;
+};
+
 class private_c {
 public:
   std::vector<std::shared_ptr<track_t>> m_tracks;
   std::unordered_map<unsigned int, std::shared_ptr<track_t>> m_tracks_by_number;
   std::unordered_map<unsigned int, track_info_t> m_track_info;
   std::vector<std::shared_ptr<libebml::EbmlElement>> m_retained_elements;
+  std::vector<level1_element_t> m_level1_elements;
+  std::vector<uint64_t> m_level1_output_positions;
   std::unordered_map<libebml::EbmlElement *, std::shared_ptr<track_t>> m_track_by_element;
   uint64_t m_ts_scale{TIMESTAMP_SCALE}, m_file_size{};
   std::size_t m_mkvmerge_track_id{};
@@ -48,6 +60,8 @@ public:
   libmatroska::KaxCluster *m_cluster{};
   std::vector<int> m_frame_sizes;
   std::vector<uint32_t> m_frame_adlers;
+  std::unordered_map<libmatroska::DataBuffer const *, uint32_t> m_frame_checksums;
+  std::unique_ptr<mtx::thread_pool_c> m_checksum_pool;
   std::vector<std::string> m_frame_hexdumps;
   int64_t m_num_references{}, m_lf_timestamp{}, m_lf_tnum{};
   std::optional<int64_t> m_block_duration;
@@ -57,6 +71,15 @@ public:
   bool m_use_gui{}, m_calc_checksums{}, m_show_summary{}, m_show_hexdump{}, m_show_size{}, m_show_positions{}, m_show_track_info{}, m_hex_positions{}, m_retain_elements{}, m_continue_at_cluster{}, m_show_all_elements{};
   int m_hexdump_max_size{};
 
+  bool m_lazy_clusters{}, m_process_clusters_in_parallel{};
+  std::optional<std::pair<int64_t, int64_t>> m_cluster_range;
+  std::map<int64_t, uint32_t> m_seek_head_entries;
+  std::vector<int64_t> m_cue_cluster_positions;
+  std::optional<int64_t> m_first_cluster_position;
+  int64_t m_segment_data_start{};
+  uint64_t m_segment_end{};
+  std::size_t m_num_threads{1};
+
   bool m_abort{};
 
   std::unordered_map<uint32_t, std::function<std::string(libebml::EbmlElement &)>> m_custom_element_value_formatters;
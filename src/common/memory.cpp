@@ -20,19 +20,37 @@ void
 memory_c::resize(size_t new_size)
   noexcept
 {
-  if (new_size == m_size)
+  if (new_size == get_size())
     return;
 
-  if (m_is_owned) {
+  auto &pool = mtx::mem::pool_c::get();
+
+  if (m_is_owned && (new_size + m_offset <= m_capacity))
+    m_size = new_size + m_offset;
+
+  else if (m_is_owned && m_capacity) {
+    std::size_t new_capacity{};
+    auto tmp = static_cast<uint8_t *>(pool.allocate(new_size + m_offset, new_capacity));
+    std::memcpy(tmp, m_ptr, std::min(new_size + m_offset, m_size));
+    pool.release(m_ptr, m_capacity);
+
+    m_ptr      = tmp;
+    m_size     = new_size + m_offset;
+    m_capacity = new_capacity;
+
+  } else if (m_is_owned) {
     m_ptr  = static_cast<uint8_t *>(saferealloc(m_ptr, new_size + m_offset));
     m_size = new_size + m_offset;
 
   } else {
-    auto tmp = static_cast<uint8_t *>(safemalloc(new_size));
+    auto tmp = static_cast<uint8_t *>(pool.allocate(new_size, m_capacity));
     std::memcpy(tmp, m_ptr + m_offset, std::min(new_size, m_size - m_offset));
     m_ptr      = tmp;
     m_is_owned = true;
     m_size     = new_size;
+    m_offset   = 0;
+
+    m_keep_alive.reset();
   }
 }
 
@@ -18,6 +18,7 @@
 #include <ebml/EbmlBinary.h>
 
 #include "common/error.h"
+#include "common/memory_pool.h"
 
 namespace mtx {
   namespace mem {
@@ -85,23 +86,16 @@ class memory_c {
 private:
   uint8_t *m_ptr{};
   std::size_t m_size{}, m_offset{};
+  std::size_t m_capacity{}; // > 0 for buffers from the memory pool
   bool m_is_owned{};
-
-  explicit memory_c(void *ptr,
-                    std::size_t size,
-                    bool take_ownership) // allocate a new counter
-    : m_ptr{static_cast<uint8_t *>(ptr)}
-    , m_size{size}
-    , m_is_owned{take_ownership}
-  {
-  }
+  std::shared_ptr<void> m_keep_alive; // for borrowed buffers whose lifetime is managed elsewhere
 
 public:
   memory_c() {}
 
   ~memory_c() {
     if (m_is_owned && m_ptr)
-      free(m_ptr);
+      mtx::mem::pool_c::get().release(m_ptr, m_capacity);
   }
 
   memory_c(const memory_c &r) = delete;
@@ -137,18 +131,31 @@ public:
     return m_is_owned;
   }
 
+  // Buffers whose lifetime is managed via a keep-alive reference stay
+  // valid for as long as this object exists, therefore they aren't
+  // copied.
   void take_ownership() {
-    if (m_is_owned)
+    if (m_is_owned || m_keep_alive)
       return;
 
-    m_ptr       = static_cast<uint8_t *>(safememdup(get_buffer(), get_size()));
-    m_is_owned  = true;
-    m_size     -= m_offset;
-    m_offset    = 0;
+    auto size   = get_size();
+    auto buffer = static_cast<uint8_t *>(mtx::mem::pool_c::get().allocate(size, m_capacity));
+
+    if (size)
+      std::memcpy(buffer, get_buffer(), size);
+
+    m_ptr      = buffer;
+    m_is_owned = true;
+    m_size     = size;
+    m_offset   = 0;
+
+    m_keep_alive.reset();
   }
 
+  // The caller becomes responsible for free()ing the buffer.
   void lock() {
     m_is_owned = false;
+    m_capacity = 0;
   }
 
   void resize(std::size_t new_size) noexcept;
@@ -185,12 +192,29 @@ public:
 public:
   static inline memory_cptr
   take_ownership(void *buffer, std::size_t length) {
-    return memory_cptr{ new memory_c(reinterpret_cast<uint8_t *>(buffer), length, true) };
+    auto mem        = mtx::mem::make_pooled<memory_c>();
+    mem->m_ptr      = static_cast<uint8_t *>(buffer);
+    mem->m_size     = length;
+    mem->m_is_owned = true;
+    return mem;
   }
 
   static inline memory_cptr
   borrow(void *buffer, std::size_t length) {
-    return memory_cptr{ new memory_c(reinterpret_cast<uint8_t *>(buffer), length, false) };
+    auto mem    = mtx::mem::make_pooled<memory_c>();
+    mem->m_ptr  = static_cast<uint8_t *>(buffer);
+    mem->m_size = length;
+    return mem;
+  }
+
+  // The buffer stays valid for as long as keep_alive is referenced.
+  static inline memory_cptr
+  borrow(void *buffer,
+         std::size_t length,
+         std::shared_ptr<void> const &keep_alive) {
+    auto mem          = borrow(buffer, length);
+    mem->m_keep_alive = keep_alive;
+    return mem;
   }
 
   static inline memory_cptr
@@ -200,18 +224,26 @@ public:
 
   static memory_cptr
   alloc(std::size_t size) {
-    return take_ownership(safemalloc(size), size);
+    auto mem   = take_ownership(nullptr, size);
+    mem->m_ptr = static_cast<uint8_t *>(mtx::mem::pool_c::get().allocate(size, mem->m_capacity));
+    return mem;
   };
 
   static inline memory_cptr
   clone(const void *buffer,
         std::size_t size) {
-    return take_ownership(safememdup(buffer, size), size);
+    if (!buffer)
+      return take_ownership(nullptr, size);
+
+    auto mem = alloc(size);
+    if (size)
+      std::memcpy(mem->m_ptr, buffer, size);
+    return mem;
   }
 
   static inline memory_cptr
   clone(libebml::EbmlBinary const &binary) {
-    return take_ownership(safememdup(binary.GetBuffer(), binary.GetSize()), binary.GetSize());
+    return clone(binary.GetBuffer(), binary.GetSize());
   }
 
   static inline memory_cptr
@@ -0,0 +1,171 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   a thread-safe pool of size-classed memory blocks
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <bit>
+
+#include "common/memory.h"
+#include "common/memory_pool.h"
+
+namespace mtx::mem {
+
+namespace {
+debugging_option_c s_debug{"memory_pool"};
+
+// Upper limit for the amount of unused memory kept per size class.
+constexpr std::size_t s_max_cached_bytes_per_class = 4 * 1024 * 1024;
+constexpr std::size_t s_min_cached_blocks          = 2;
+constexpr std::size_t s_max_cached_blocks          = 4096;
+}
+
+pool_c::pool_c() {
+  for (auto idx = 0u; idx < num_size_classes; ++idx)
+    m_size_classes[idx].max_free_blocks = std::clamp(s_max_cached_bytes_per_class / block_size_for(idx), s_min_cached_blocks, s_max_cached_blocks);
+}
+
+pool_c::~pool_c() {
+  for (auto &size_class : m_size_classes)
+    for (auto block : size_class.free_blocks)
+      free(block);
+}
+
+pool_c &
+pool_c::get() {
+  // Never destroyed on purpose: buffers in objects with static storage
+  // duration may still be returned to the pool during program
+  // termination.
+  static auto *s_pool = new pool_c;
+  return *s_pool;
+}
+
+std::optional<unsigned int>
+pool_c::size_class_for(std::size_t size) {
+  if (size > max_block_size)
+    return {};
+
+  return std::countr_zero(std::bit_ceil(std::max(size, min_block_size))) - std::countr_zero(min_block_size);
+}
+
+std::size_t
+pool_c::block_size_for(unsigned int size_class) {
+  return min_block_size << size_class;
+}
+
+void *
+pool_c::allocate(std::size_t size,
+                 std::size_t &capacity) {
+  auto size_class_idx = size_class_for(size);
+
+  if (!size_class_idx) {
+    ++m_num_oversized;
+    capacity = 0;
+    return safemalloc(size);
+  }
+
+  auto &size_class = m_size_classes[*size_class_idx];
+  capacity         = block_size_for(*size_class_idx);
+
+  {
+    std::lock_guard<std::mutex> lock{size_class.mutex};
+
+    if (!size_class.free_blocks.empty()) {
+      auto block = size_class.free_blocks.back();
+      size_class.free_blocks.pop_back();
+      ++size_class.hits;
+
+      return block;
+    }
+  }
+
+  ++size_class.misses;
+
+  return safemalloc(capacity);
+}
+
+void
+pool_c::release(void *block,
+                std::size_t capacity)
+  noexcept {
+  if (!block)
+    return;
+
+  auto size_class_idx = capacity ? size_class_for(capacity) : std::nullopt;
+
+  if (!size_class_idx || (block_size_for(*size_class_idx) != capacity)) {
+    free(block);
+    return;
+  }
+
+  auto &size_class = m_size_classes[*size_class_idx];
+
+  try {
+    std::lock_guard<std::mutex> lock{size_class.mutex};
+
+    if (size_class.free_blocks.size() < size_class.max_free_blocks) {
+      size_class.free_blocks.push_back(block);
+      ++size_class.returned;
+
+      return;
+    }
+
+  } catch (std::bad_alloc &) {
+  }
+
+  ++size_class.discarded;
+  free(block);
+}
+
+pool_c::statistics_t
+pool_c::get_statistics(unsigned int size_class)
+  const {
+  auto &sc = m_size_classes.at(size_class);
+  return { sc.hits.load(), sc.misses.load(), sc.returned.load(), sc.discarded.load() };
+}
+
+uint64_t
+pool_c::get_num_oversized()
+  const {
+  return m_num_oversized;
+}
+
+void
+pool_c::dump_statistics()
+  const {
+  if (!s_debug)
+    return;
+
+  statistics_t total;
+
+  for (auto idx = 0u; idx < num_size_classes; ++idx) {
+    auto stats = get_statistics(idx);
+
+    total.hits      += stats.hits;
+    total.misses    += stats.misses;
+    total.returned  += stats.returned;
+    total.discarded += stats.discarded;
+
+    if (!stats.hits && !stats.misses)
+      continue;
+
+    mxdebug(fmt::format("size class {0:>7}: {1} hits, {2} misses ({3:.1f}% hit rate), {4} returned, {5} discarded\n",
+                        block_size_for(idx), stats.hits, stats.misses, 100.0 * stats.hits / (stats.hits + stats.misses), stats.returned, stats.discarded));
+  }
+
+  auto num_requests = total.hits + total.misses + get_num_oversized();
+
+  mxdebug(fmt::format("total: {0} requests, {1} hits, {2} misses, {3} too large for pooling ({4:.1f}% hit rate), {5} returned, {6} discarded\n",
+                      num_requests, total.hits, total.misses, get_num_oversized(), num_requests ? 100.0 * total.hits / num_requests : 0.0, total.returned, total.discarded));
+}
+
+}
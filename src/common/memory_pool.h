@@ -0,0 +1,114 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   a thread-safe pool of size-classed memory blocks
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace mtx::mem {
+
+// Blocks handed out by the pool are regular malloc() blocks whose size
+// is rounded up to a power of two between min_block_size and
+// max_block_size. Returning them to the pool keeps them for re-use
+// instead of freeing them; passing them to free() is valid as well.
+class pool_c {
+public:
+  static constexpr std::size_t min_block_size   = 64;
+  static constexpr std::size_t max_block_size   = 2 * 1024 * 1024;
+  static constexpr unsigned int num_size_classes = 16;
+
+  struct statistics_t {
+    uint64_t hits{}, misses{}, returned{}, discarded{};
+  };
+
+protected:
+  struct size_class_t {
+    std::mutex mutex;
+    std::vector<void *> free_blocks;
+    std::size_t max_free_blocks{};
+    std::atomic<uint64_t> hits{}, misses{}, returned{}, discarded{};
+  };
+
+  std::array<size_class_t, num_size_classes> m_size_classes;
+  std::atomic<uint64_t> m_num_oversized{};
+
+public:
+  pool_c();
+  ~pool_c();
+
+  pool_c(pool_c const &) = delete;
+  pool_c &operator =(pool_c const &) = delete;
+
+  // Sets capacity to the usable size of the returned block. It is 0 for
+  // requests larger than max_block_size which are served by malloc()
+  // directly.
+  void *allocate(std::size_t size, std::size_t &capacity);
+  void release(void *block, std::size_t capacity) noexcept;
+
+  statistics_t get_statistics(unsigned int size_class) const;
+  uint64_t get_num_oversized() const;
+  void dump_statistics() const;
+
+  static std::optional<unsigned int> size_class_for(std::size_t size);
+  static std::size_t block_size_for(unsigned int size_class);
+
+  static pool_c &get();
+};
+
+// For std::allocate_shared() & friends so that both the object and
+// the shared pointer's control block come from the pool.
+template<typename T>
+class pool_allocator_c {
+public:
+  using value_type = T;
+
+  pool_allocator_c() noexcept = default;
+
+  template<typename U>
+  pool_allocator_c(pool_allocator_c<U> const &) noexcept {
+  }
+
+  T *
+  allocate(std::size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+
+    std::size_t capacity{};
+    return static_cast<T *>(pool_c::get().allocate(n * sizeof(T), capacity));
+  }
+
+  void
+  deallocate(T *p,
+             std::size_t n)
+    noexcept {
+    auto size_class = pool_c::size_class_for(n * sizeof(T));
+    pool_c::get().release(p, size_class ? pool_c::block_size_for(*size_class) : 0);
+  }
+
+  template<typename U>
+  bool
+  operator ==(pool_allocator_c<U> const &)
+    const noexcept {
+    return true;
+  }
+};
+
+template<typename T, typename... Targs>
+std::shared_ptr<T>
+make_pooled(Targs &&... args) {
+  return std::allocate_shared<T>(pool_allocator_c<T>{}, std::forward<Targs>(args)...);
+}
+
+}
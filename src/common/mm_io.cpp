@@ -140,6 +140,11 @@ mm_io_c::read(size_t size) {
   return buffer;
 }
 
+memory_cptr
+mm_io_c::read_zero_copy(size_t size) {
+  return read(size);
+}
+
 MTX_EBML_IOCALLBACK_READ_RETURN_TYPE
 mm_io_c::read(void *buffer,
               size_t size) {
@@ -38,6 +38,9 @@ public:
   virtual void setFilePointer(int64_t offset, libebml::seek_mode mode = libebml::seek_beginning) override = 0;
   virtual bool setFilePointer2(int64_t offset, libebml::seek_mode mode = libebml::seek_beginning);
   virtual memory_cptr read(size_t size);
+  // Like read(size), but the result may refer to the source's data
+  // directly instead of being a copy, e.g. for memory-mapped files.
+  virtual memory_cptr read_zero_copy(size_t size);
   virtual MTX_EBML_IOCALLBACK_READ_RETURN_TYPE read(void *buffer, size_t size) override;
   virtual uint32_t read(std::string &buffer, size_t size, size_t offset = 0);
   virtual uint32_t read(memory_cptr const &buffer, size_t size, int offset = 0);
@@ -0,0 +1,235 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   IO callback class for memory-mapped input files
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#if !defined(SYS_WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/types.h>
+# include <unistd.h>
+#endif
+
+#include "common/mm_io_x.h"
+#include "common/mm_file_io.h"
+#include "common/mm_mmap_io.h"
+#include "common/mm_mmap_io_p.h"
+#include "common/mm_proxy_io.h"
+#include "common/mm_read_buffer_io.h"
+#if defined(SYS_APPLE)
+# include "common/fs_sys_helpers.h"
+#endif
+
+namespace {
+debugging_option_c s_debug{"mmap_io"};
+
+// Leave enough of a 32-bit address space for everything else.
+constexpr uint64_t s_max_mapping_size = sizeof(void *) >= 8 ? std::numeric_limits<std::size_t>::max() : 512 * 1024 * 1024;
+}
+
+mm_mmap_io_private_c::mapping_t::~mapping_t() {
+#if !defined(SYS_WINDOWS)
+  if (data)
+    munmap(data, size);
+#endif
+}
+
+mm_mmap_io_private_c::mm_mmap_io_private_c(std::string const &p_file_name)
+  : file_name{p_file_name}
+{
+#if defined(SYS_WINDOWS)
+  throw mtx::mm_io::open_x{std::make_error_code(std::errc::function_not_supported)};
+
+#else
+# if defined(SYS_APPLE)
+  file_name = mtx::sys::normalize_unicode_string(file_name, mtx::sys::unicode_normalization_form_e::d);
+# endif  // SYS_APPLE
+
+  auto local_path = g_cc_local_utf8->native(file_name);
+  auto fd         = ::open(local_path.c_str(), O_RDONLY);
+
+# if defined(SYS_APPLE)
+  if (fd == -1) {
+    local_path = g_cc_local_utf8->native(mtx::sys::normalize_unicode_string(file_name, mtx::sys::unicode_normalization_form_e::c));
+    fd         = ::open(local_path.c_str(), O_RDONLY);
+  }
+# endif  // SYS_APPLE
+
+  if (fd == -1)
+    throw mtx::mm_io::open_x{mtx::mm_io::make_error_code()};
+
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size <= 0) || (static_cast<uint64_t>(st.st_size) > s_max_mapping_size)) {
+    ::close(fd);
+    throw mtx::mm_io::open_x{std::make_error_code(std::errc::not_supported)};
+  }
+
+  // Private & writable so that consumers of read_zero_copy() may
+  // modify the data in place without it ever reaching the file.
+  auto size = static_cast<std::size_t>(st.st_size);
+  auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  auto code = mtx::mm_io::make_error_code();
+
+  ::close(fd);
+
+  if (data == MAP_FAILED)
+    throw mtx::mm_io::open_x{code};
+
+# if defined(POSIX_MADV_SEQUENTIAL)
+  posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+# endif
+
+  mapping       = std::make_shared<mapping_t>();
+  mapping->data = static_cast<uint8_t *>(data);
+  mapping->size = size;
+#endif  // SYS_WINDOWS
+}
+
+mm_mmap_io_c::mm_mmap_io_c(std::string const &path)
+  : mm_io_c{*new mm_mmap_io_private_c{path}}
+{
+}
+
+mm_mmap_io_c::mm_mmap_io_c(mm_mmap_io_private_c &p)
+  : mm_io_c{p}
+{
+}
+
+mm_mmap_io_c::~mm_mmap_io_c() {
+  close_mmap_io();
+}
+
+bool
+mm_mmap_io_c::is_supported() {
+#if defined(SYS_WINDOWS)
+  return false;
+#else
+  return true;
+#endif
+}
+
+mm_io_cptr
+mm_mmap_io_c::open(std::string const &path) {
+  if (is_supported()) {
+    try {
+      return std::make_shared<mm_mmap_io_c>(path);
+    } catch (mtx::mm_io::open_x &ex) {
+      mxdebug_if(s_debug, fmt::format("{0}: cannot map, falling back to regular I/O: {1}\n", path, ex.error()));
+    }
+  }
+
+  return std::make_shared<mm_read_buffer_io_c>(std::make_shared<mm_file_io_c>(path));
+}
+
+uint64_t
+mm_mmap_io_c::getFilePointer() {
+  return p_func()->pos;
+}
+
+void
+mm_mmap_io_c::setFilePointer(int64_t offset,
+                             libebml::seek_mode mode) {
+  auto p = p_func();
+
+  if (!p->mapping)
+    throw mtx::mm_io::seek_x{std::make_error_code(std::errc::bad_file_descriptor)};
+
+  int64_t new_pos
+    = libebml::seek_beginning == mode ? offset
+    : libebml::seek_end       == mode ? static_cast<int64_t>(p->mapping->size) + offset // offsets from the end are negative already
+    :                                   static_cast<int64_t>(p->pos)           + offset;
+
+  // Just like fseeko() positions beyond the end are OK.
+  if (0 > new_pos)
+    throw mtx::mm_io::seek_x{std::make_error_code(std::errc::invalid_argument)};
+
+  p->pos = new_pos;
+}
+
+int64_t
+mm_mmap_io_c::get_size() {
+  auto p = p_func();
+  return p->mapping ? p->mapping->size : 0;
+}
+
+uint32_t
+mm_mmap_io_c::_read(void *buffer,
+                    size_t size) {
+  auto p     = p_func();
+  auto avail = p->mapping && (p->pos < p->mapping->size) ? p->mapping->size - p->pos : 0;
+
+  if (size > avail) {
+    size   = avail;
+    p->eof = true;
+  }
+
+  if (size)
+    std::memcpy(buffer, p->mapping->data + p->pos, size);
+
+  p->pos += size;
+
+  return size;
+}
+
+memory_cptr
+mm_mmap_io_c::read_zero_copy(size_t size) {
+  auto p     = p_func();
+  auto avail = p->mapping && (p->pos < p->mapping->size) ? p->mapping->size - p->pos : 0;
+
+  if (size > avail) {
+    p->pos += avail;
+    p->eof  = true;
+    throw mtx::mm_io::end_of_file_x{};
+  }
+
+  auto buffer  = memory_c::borrow(p->mapping->data + p->pos, size, p->mapping);
+  p->pos      += size;
+
+  return buffer;
+}
+
+size_t
+mm_mmap_io_c::_write(const void *,
+                     size_t) {
+  throw mtx::mm_io::wrong_read_write_access_x();
+}
+
+void
+mm_mmap_io_c::close() {
+  close_mmap_io();
+}
+
+void
+mm_mmap_io_c::close_mmap_io() {
+  auto p = p_func();
+
+  p->mapping.reset();
+  p->pos = 0;
+}
+
+bool
+mm_mmap_io_c::eof() {
+  return p_func()->eof;
+}
+
+void
+mm_mmap_io_c::clear_eof() {
+  p_func()->eof = false;
+}
+
+std::string
+mm_mmap_io_c::get_file_name()
+  const {
+  return p_func()->file_name;
+}
@@ -0,0 +1,50 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   IO callback class for memory-mapped input files
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+class mm_mmap_io_private_c;
+class mm_mmap_io_c: public mm_io_c {
+protected:
+  MTX_DECLARE_PRIVATE(mm_mmap_io_private_c)
+
+  explicit mm_mmap_io_c(mm_mmap_io_private_c &p);
+
+public:
+  mm_mmap_io_c(std::string const &path);
+  virtual ~mm_mmap_io_c();
+
+  virtual uint64_t getFilePointer() override;
+  virtual void setFilePointer(int64_t offset, libebml::seek_mode mode = libebml::seek_beginning) override;
+  virtual void close() override;
+  virtual bool eof() override;
+  virtual void clear_eof() override;
+  virtual int64_t get_size() override;
+  virtual memory_cptr read_zero_copy(size_t size) override;
+
+  virtual std::string get_file_name() const override;
+
+public:
+  // Maps the file if possible. Otherwise, e.g. for pipes, files that
+  // are too big for the address space or on systems without support
+  // for mapping, a buffered mm_file_io_c is returned.
+  static mm_io_cptr open(std::string const &path);
+  static bool is_supported();
+
+protected:
+  virtual uint32_t _read(void *buffer, size_t size) override;
+  virtual size_t _write(const void *buffer, size_t size) override;
+  void close_mmap_io();
+};
@@ -0,0 +1,37 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include "common/mm_io_p.h"
+
+class mm_mmap_io_c;
+
+class mm_mmap_io_private_c : public mm_io_private_c {
+public:
+  // Shared with all buffers returned by read_zero_copy() so that they
+  // stay valid after the file has been closed.
+  struct mapping_t {
+    uint8_t *data{};
+    std::size_t size{};
+
+    ~mapping_t();
+  };
+
+  std::string file_name;
+  std::shared_ptr<mapping_t> mapping;
+  std::size_t pos{};
+  bool eof{};
+
+  explicit mm_mmap_io_private_c(std::string const &p_file_name);
+};
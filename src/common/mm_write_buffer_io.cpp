@@ -25,8 +25,9 @@ debugging_option_c s_debug_seek{"write_buffer_io|write_buffer_io_seek"}, s_debug
 }
 
 mm_write_buffer_io_c::mm_write_buffer_io_c(mm_io_cptr const &out,
-                                           std::size_t buffer_size)
-  : mm_proxy_io_c{*new mm_write_buffer_io_private_c{out, buffer_size}}
+                                           std::size_t buffer_size,
+                                           std::size_t num_async_buffers)
+  : mm_proxy_io_c{*new mm_write_buffer_io_private_c{out, buffer_size, num_async_buffers}}
 {
 }
 
@@ -36,23 +37,55 @@ mm_write_buffer_io_c::mm_write_buffer_io_c(mm_write_buffer_io_private_c &p)
 }
 
 mm_write_buffer_io_c::~mm_write_buffer_io_c() {
-  close_write_buffer_io();
+  // Exceptions must not escape from the destructor. Errors that
+  // haven't been reported to the caller yet are logged instead.
+  auto p                = p_func();
+  auto already_reported = p->write_error_reported;
+
+  try {
+    close_write_buffer_io();
+
+  } catch (std::exception &ex) {
+    if (!already_reported)
+      mxwarn(fmt::format(FY("Writing to the file failed: {0}\n"), ex.what()));
+
+  } catch (...) {
+    if (!already_reported)
+      mxwarn(Y("Writing to the file failed.\n"));
+  }
 }
 
 mm_io_cptr
 mm_write_buffer_io_c::open(const std::string &file_name,
-                           size_t buffer_size) {
-  return std::make_shared<mm_write_buffer_io_c>(std::make_shared<mm_file_io_c>(file_name, libebml::MODE_CREATE), buffer_size);
+                           size_t buffer_size,
+                           std::size_t num_async_buffers) {
+  return std::make_shared<mm_write_buffer_io_c>(std::make_shared<mm_file_io_c>(file_name, libebml::MODE_CREATE), buffer_size, num_async_buffers);
+}
+
+bool
+mm_write_buffer_io_c::writing_asynchronously()
+  const {
+  return !!p_func()->flusher;
 }
 
 uint64_t
 mm_write_buffer_io_c::getFilePointer() {
-  return mm_proxy_io_c::getFilePointer() + p_func()->fill;
+  auto p = p_func();
+
+  // The flusher thread might be moving the underlying file's position
+  // right now.
+  if (writing_asynchronously())
+    return p->flushed_position + p->queued_bytes + p->fill;
+
+  return mm_proxy_io_c::getFilePointer() + p->fill;
 }
 
 void
 mm_write_buffer_io_c::setFilePointer(int64_t offset,
                                      libebml::seek_mode mode) {
+  if (libebml::seek_end == mode)
+    wait_for_buffers_in_flight(0);
+
   int64_t new_pos
     = libebml::seek_beginning == mode ? offset
     : libebml::seek_end       == mode ? p_func()->proxy_io->get_size() + offset // offsets from the end are negative already
@@ -62,6 +95,7 @@ mm_write_buffer_io_c::setFilePointer(int64_t offset,
     return;
 
   flush_buffer();
+  wait_for_buffers_in_flight(0);
 
   if (s_debug_seek) {
     int64_t previous_pos = mm_proxy_io_c::getFilePointer();
@@ -69,11 +103,15 @@ mm_write_buffer_io_c::setFilePointer(int64_t offset,
   }
 
   mm_proxy_io_c::setFilePointer(offset, mode);
+
+  if (writing_asynchronously())
+    p_func()->flushed_position = mm_proxy_io_c::getFilePointer();
 }
 
 void
 mm_write_buffer_io_c::flush() {
   flush_buffer();
+  wait_for_buffers_in_flight(0);
   mm_proxy_io_c::flush();
 }
 
@@ -84,14 +122,30 @@ mm_write_buffer_io_c::close() {
 
 void
 mm_write_buffer_io_c::close_write_buffer_io() {
-  flush_buffer();
+  auto p     = p_func();
+  auto error = std::exception_ptr{};
+
+  try {
+    flush_buffer();
+    wait_for_buffers_in_flight(0);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
   mm_proxy_io_c::close();
+
+  // Report the error only once; closing again must not throw.
+  p->write_error = nullptr;
+
+  if (error)
+    std::rethrow_exception(error);
 }
 
 uint32_t
 mm_write_buffer_io_c::_read(void *buffer,
                             size_t size) {
   flush_buffer();
+  wait_for_buffers_in_flight(0);
   return mm_proxy_io_c::_read(buffer, size);
 }
 
@@ -104,6 +158,31 @@ mm_write_buffer_io_c::_write(const void *buffer,
   const char *buf = static_cast<const char *>(buffer);
   size_t remain   = size;
 
+  if (writing_asynchronously()) {
+    // Everything has to go through the buffers so that the flusher
+    // thread writes the data in order.
+    if (*p->write_failed)
+      wait_for_buffers_in_flight(0);
+
+    rethrow_write_error();
+
+    while (remain) {
+      avail = std::min(remain, p->size - p->fill);
+      memcpy(p->buffer + p->fill, buf, avail);
+
+      p->fill += avail;
+      remain  -= avail;
+      buf     += avail;
+
+      if (p->fill == p->size)
+        flush_buffer();
+    }
+
+    p->cached_size = -1;
+
+    return size;
+  }
+
   // whole blocks
   while (remain >= (avail = p->size - p->fill)) {
     if (p->fill) {
@@ -143,6 +222,11 @@ mm_write_buffer_io_c::flush_buffer() {
   if (!p->fill)
     return;
 
+  if (writing_asynchronously()) {
+    queue_buffer_for_writing();
+    return;
+  }
+
   size_t written = mm_proxy_io_c::_write(p->buffer, p->fill);
   size_t fill    = p->fill;
   p->fill         = 0;
@@ -155,5 +239,101 @@ mm_write_buffer_io_c::flush_buffer() {
 
 void
 mm_write_buffer_io_c::discard_buffer() {
-  p_func()->fill = 0;
+  auto p  = p_func();
+  p->fill = 0;
+
+  if (!writing_asynchronously())
+    return;
+
+  // Buffers already handed over cannot be recalled. Wait for them so
+  // that nothing is written after the file has been closed, but don't
+  // report errors anymore.
+  try {
+    wait_for_buffers_in_flight(0);
+  } catch (...) {
+  }
+
+  p->write_error = nullptr;
+}
+
+void
+mm_write_buffer_io_c::queue_buffer_for_writing() {
+  auto p = p_func();
+
+  // Writing the buffer after a failed one would put the data at the
+  // wrong position in the file. Drop it & report the error instead.
+  if (*p->write_failed || p->write_error) {
+    p->fill = 0;
+    wait_for_buffers_in_flight(0);
+    return;
+  }
+
+  if (p->free_buffers.empty())
+    wait_for_buffers_in_flight(p->buffers_in_flight.size() - 1);
+
+  auto proxy_io     = p->proxy_io;
+  auto buffer       = p->af_buffer;
+  auto fill         = p->fill;
+  auto write_failed = p->write_failed;
+  auto result       = p->flusher->submit([proxy_io, buffer, fill, write_failed]() {
+    if (*write_failed)
+      return;
+
+    try {
+      auto written = proxy_io->write(buffer->get_buffer(), fill);
+
+      mxdebug_if(s_debug_write, fmt::format("flush_buffer() asynchronously at {0} for {1} written {2}\n", proxy_io->getFilePointer() - written, fill, written));
+
+      if (written != fill)
+        throw mtx::mm_io::insufficient_space_x();
+
+    } catch (...) {
+      *write_failed = true;
+      throw;
+    }
+  });
+
+  p->buffers_in_flight.push_back({ buffer, fill, std::move(result) });
+  p->queued_bytes += fill;
+
+  p->af_buffer = p->free_buffers.back();
+  p->buffer    = p->af_buffer->get_buffer();
+  p->fill      = 0;
+
+  p->free_buffers.pop_back();
+}
+
+void
+mm_write_buffer_io_c::wait_for_buffers_in_flight(std::size_t max_remaining) {
+  auto p = p_func();
+
+  while (p->buffers_in_flight.size() > max_remaining) {
+    auto &in_flight = p->buffers_in_flight.front();
+
+    try {
+      in_flight.result.get();
+    } catch (...) {
+      if (!p->write_error)
+        p->write_error = std::current_exception();
+    }
+
+    p->flushed_position += in_flight.fill;
+    p->queued_bytes     -= in_flight.fill;
+
+    p->free_buffers.emplace_back(std::move(in_flight.buffer));
+    p->buffers_in_flight.pop_front();
+  }
+
+  rethrow_write_error();
+}
+
+void
+mm_write_buffer_io_c::rethrow_write_error() {
+  auto p = p_func();
+
+  if (!p->write_error)
+    return;
+
+  p->write_error_reported = true;
+  std::rethrow_exception(p->write_error);
 }
@@ -17,6 +17,7 @@
 #include "common/common_pch.h"
 
 #include "common/mm_io.h"
+#include "common/mm_proxy_io.h"
 
 class mm_write_buffer_io_private_c;
 class mm_write_buffer_io_c: public mm_proxy_io_c {
@@ -26,7 +27,13 @@ protected:
   explicit mm_write_buffer_io_c(mm_write_buffer_io_private_c &p);
 
 public:
-  mm_write_buffer_io_c(mm_io_cptr const &out, std::size_t buffer_size);
+  // With two or more asynchronous buffers all writing is done by a
+  // background thread while the caller fills the next buffer. Write
+  // errors are reported by the first call after they have occurred,
+  // at the latest by flush() or close(). Once a write has failed no
+  // further data is written, and every following write, seek or
+  // flush() reports the error again. The destructor only logs it.
+  mm_write_buffer_io_c(mm_io_cptr const &out, std::size_t buffer_size, std::size_t num_async_buffers = 0);
   virtual ~mm_write_buffer_io_c();
 
   virtual uint64_t getFilePointer() override;
@@ -35,11 +42,16 @@ public:
   virtual void close() override;
   virtual void discard_buffer();
 
-  static mm_io_cptr open(const std::string &file_name, size_t buffer_size);
+  static mm_io_cptr open(const std::string &file_name, size_t buffer_size, std::size_t num_async_buffers = 0);
 
 protected:
   virtual uint32_t _read(void *buffer, size_t size) override;
   virtual size_t _write(const void *buffer, size_t size) override;
   void flush_buffer();
   void close_write_buffer_io();
+
+  bool writing_asynchronously() const;
+  void queue_buffer_for_writing();
+  void wait_for_buffers_in_flight(std::size_t max_remaining);
+  void rethrow_write_error();
 };
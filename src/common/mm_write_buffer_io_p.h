@@ -13,23 +13,57 @@
 
 #include "common/common_pch.h"
 
+#include <atomic>
+#include <deque>
+#include <future>
+
 #include "common/mm_proxy_io_p.h"
+#include "common/thread_pool.h"
 
 class mm_write_buffer_io_c;
 
 class mm_write_buffer_io_private_c : public mm_proxy_io_private_c {
 public:
+  struct buffer_in_flight_t {
+    memory_cptr buffer;
+    std::size_t fill{};
+    std::future<void> result;
+  };
+
   memory_cptr af_buffer;
   uint8_t *buffer{};
   std::size_t fill{};
   std::size_t const size{};
 
+  // Only used for asynchronous writing. Full buffers are handed over
+  // to the flusher thread and written in the order they were queued.
+  std::unique_ptr<mtx::thread_pool_c> flusher;
+  std::deque<buffer_in_flight_t> buffers_in_flight;
+  std::vector<memory_cptr> free_buffers;
+  std::size_t num_buffers{};
+  uint64_t flushed_position{}, queued_bytes{};
+  std::exception_ptr write_error;
+  bool write_error_reported{};
+  // Set by the flusher thread as soon as a write fails. All buffers
+  // queued after the failed one are dropped instead of being written.
+  std::shared_ptr<std::atomic<bool>> write_failed{std::make_shared<std::atomic<bool>>(false)};
+
   explicit mm_write_buffer_io_private_c(mm_io_cptr const &p_proxy_io,
-                                        std::size_t p_buffer_size)
+                                        std::size_t p_buffer_size,
+                                        std::size_t p_num_async_buffers = 0)
     : mm_proxy_io_private_c{p_proxy_io}
     , af_buffer{memory_c::alloc(p_buffer_size)}
     , buffer{af_buffer->get_buffer()}
     , size{p_buffer_size}
+    , num_buffers{p_num_async_buffers}
   {
+    if (num_buffers < 2)
+      return;
+
+    flusher          = std::make_unique<mtx::thread_pool_c>(1);
+    flushed_position = proxy_io->getFilePointer();
+
+    for (auto idx = 1u; idx < num_buffers; ++idx)
+      free_buffers.emplace_back(memory_c::alloc(size));
   }
 };
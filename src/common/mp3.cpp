@@ -14,6 +14,7 @@
 #include "common/common_pch.h"
 #include "common/debugging.h"
 #include "common/mp3.h"
+#include "common/sync_word_scanner.h"
 
 // Synch word for a frame is 0xFFE0 (first 11 bits must be set)
 // Frame valuable information (for parsing) are stored in the first 4 bytes :
@@ -131,6 +132,13 @@ static int mp3_sampling_freqs[3][4] = {
   {11025, 12000, 8000, 0}
 };
 
+// ID3v2 tags, ID3v1 tags and frame sync words
+static mtx::sync_word_scanner_c const s_header_scanner{
+  { 0x494433, 0xffffff, 3, 0 }, // ID3
+  { 0x544147, 0xffffff, 3, 0 }, // TAG
+  { 0xffe0,   0xffe0,   2, 0 },
+};
+
 static int mp3_samples_per_channel[3][3] = {
   {384, 1152, 1152},
   {384, 1152, 576},
@@ -140,13 +148,15 @@ static int mp3_samples_per_channel[3][3] = {
 int
 find_mp3_header(const uint8_t *buf,
                 int size) {
-  int i, pos;
+  int i;
   unsigned long header;
 
   if (size < 4)
     return -1;
 
-  for (pos = 0; pos < (size - 4); pos++) {
+  for (auto candidate = s_header_scanner.find(buf, size); candidate < static_cast<std::size_t>(size - 4); candidate = s_header_scanner.find(buf, size, candidate + 1)) {
+    auto pos = static_cast<int>(candidate);
+
     if ((buf[pos] == 'I') && (buf[pos + 1] == 'D') && (buf[pos + 2] == '3')) {
       if ((pos + 10) >= size)
         return -1;
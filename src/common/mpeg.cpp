@@ -12,65 +12,240 @@
 
 #include "common/common_pch.h"
 
+#include <bit>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+#endif
+
 #include "common/debugging.h"
 #include "common/endian.h"
-#include "common/mm_mem_io.h"
 #include "common/mpeg.h"
 
 namespace mtx::mpeg {
 
+namespace {
+
+// Which values of the third byte of a 00 00 xx sequence are accepted:
+// either exactly the value given (start codes, emulation prevention
+// bytes) or everything up to it (bytes that need to be escaped).
+enum class third_byte_e {
+  equal,
+  at_most,
+};
+
+template<third_byte_e Tmode>
+uint8_t const *
+find_zero_pair_scalar(uint8_t const *begin,
+                      uint8_t const *end,
+                      uint8_t value) {
+  if ((end - begin) < 3)
+    return end;
+
+  auto p = begin;
+
+  // Look at the third byte of each candidate first: if it's larger
+  // than the value, none of the three candidates starting at p, p + 1
+  // and p + 2 can match. The same is true for non-zero third bytes of
+  // candidates whose first two bytes aren't zero.
+  while ((p + 2) < end) {
+    if (p[2] > value)
+      p += 3;
+
+    else if (   (p[0] == 0)
+             && (p[1] == 0)
+             && ((Tmode == third_byte_e::at_most) || (p[2] == value)))
+      return p;
+
+    else if (p[2] == 0)
+      ++p;
+
+    else
+      p += 3;
+  }
+
+  return end;
+}
+
+#if defined(__AVX2__)
+template<third_byte_e Tmode>
+__m256i
+third_byte_matches(__m256i bytes,
+                   __m256i value) {
+  if constexpr (Tmode == third_byte_e::equal)
+    return _mm256_cmpeq_epi8(bytes, value);
+  else
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, value), bytes);
+}
+
+#elif defined(__SSE2__)
+template<third_byte_e Tmode>
+__m128i
+third_byte_matches(__m128i bytes,
+                   __m128i value) {
+  if constexpr (Tmode == third_byte_e::equal)
+    return _mm_cmpeq_epi8(bytes, value);
+  else
+    return _mm_cmpeq_epi8(_mm_min_epu8(bytes, value), bytes);
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+template<third_byte_e Tmode>
+uint8x16_t
+third_byte_matches(uint8x16_t bytes,
+                   uint8x16_t value) {
+  if constexpr (Tmode == third_byte_e::equal)
+    return vceqq_u8(bytes, value);
+  else
+    return vcleq_u8(bytes, value);
+}
+#endif
+
+// Returns a pointer to the first byte of the first 00 00 xx sequence
+// located completely within [begin, end) whose third byte matches
+// according to Tmode or `end` if there is none.
+template<third_byte_e Tmode>
+uint8_t const *
+find_zero_pair(uint8_t const *begin,
+               uint8_t const *end,
+               uint8_t value) {
+  auto p = begin;
+
+#if defined(__AVX2__)
+  auto const zero  = _mm256_setzero_si256();
+  auto const third = _mm256_set1_epi8(static_cast<char>(value));
+
+  // Each iteration tests the 32 candidates starting at p…p + 31 and
+  // therefore needs 34 readable bytes.
+  while ((p + 34) <= end) {
+    auto b0   = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+    auto b1   = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + 1));
+    auto b2   = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + 2));
+    auto hits = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(b0, zero), _mm256_cmpeq_epi8(b1, zero)), third_byte_matches<Tmode>(b2, third));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+
+    if (mask)
+      return p + std::countr_zero(mask);
+
+    p += 32;
+  }
+
+#elif defined(__SSE2__)
+  auto const zero  = _mm_setzero_si128();
+  auto const third = _mm_set1_epi8(static_cast<char>(value));
+
+  while ((p + 18) <= end) {
+    auto b0   = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+    auto b1   = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + 1));
+    auto b2   = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + 2));
+    auto hits = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero)), third_byte_matches<Tmode>(b2, third));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+
+    if (mask)
+      return p + std::countr_zero(mask);
+
+    p += 16;
+  }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  auto const third = vdupq_n_u8(value);
+
+  while ((p + 18) <= end) {
+    auto b0   = vld1q_u8(p);
+    auto b1   = vld1q_u8(p + 1);
+    auto b2   = vld1q_u8(p + 2);
+    auto hits = vandq_u8(vandq_u8(vceqzq_u8(b0), vceqzq_u8(b1)), third_byte_matches<Tmode>(b2, third));
+
+    // NEON lacks a cheap movemask; locate the exact position with
+    // the scalar code once the block is known to contain a match.
+    if (vmaxvq_u8(hits))
+      return find_zero_pair_scalar<Tmode>(p, p + 18, value);
+
+    p += 16;
+  }
+#endif
+
+  return find_zero_pair_scalar<Tmode>(p, end, value);
+}
+
+} // anonymous namespace
+
+// Returns a pointer to the first byte of the first 00 00 01 sequence
+// located completely within [begin, end) or `end` if there is none.
+uint8_t const *
+find_start_code_scalar(uint8_t const *begin,
+                       uint8_t const *end) {
+  return find_zero_pair_scalar<third_byte_e::equal>(begin, end, 1);
+}
+
+uint8_t const *
+find_start_code(uint8_t const *begin,
+                uint8_t const *end) {
+  return find_zero_pair<third_byte_e::equal>(begin, end, 1);
+}
+
 memory_cptr
-nalu_to_rbsp(memory_cptr const &buffer) {
-  mm_mem_io_cptr d;
-  auto b = buffer->get_buffer();
-
-  for (int pos = 0, size = buffer->get_size(); pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 == b[pos + 2])) {
-
-      if (!d) {
-        d = std::make_shared<mm_mem_io_c>(nullptr, size, 100);
-        if (pos > 0)
-          d->write(b, pos);
-      }
-
-      d->write_uint8(0);
-      d->write_uint8(0);
-      pos += 2;
-
-    } else if (d)
-      d->write_uint8(b[pos]);
+nalu_to_rbsp(memory_cptr const &buffer,
+             std::size_t max_size) {
+  auto src  = static_cast<uint8_t const *>(buffer->get_buffer());
+  auto size = std::min(buffer->get_size(), max_size);
+  auto end  = src + size;
+  auto pos  = find_zero_pair<third_byte_e::equal>(src, end, 3);
+
+  if (pos == end)
+    return size == buffer->get_size() ? buffer : memory_c::borrow(buffer->get_buffer(), size, buffer);
+
+  // Removing emulation prevention bytes only ever shrinks the data.
+  auto dest     = memory_c::alloc(size);
+  auto dest_ptr = dest->get_buffer();
+
+  while (pos != end) {
+    auto span_size = static_cast<std::size_t>(pos + 2 - src);
+
+    std::memcpy(dest_ptr, src, span_size);
+    dest_ptr += span_size;
+    src       = pos + 3;
+    pos       = find_zero_pair<third_byte_e::equal>(src, end, 3);
   }
 
-  if (!d)
-    return buffer;
+  std::memcpy(dest_ptr, src, end - src);
+  dest_ptr += end - src;
+
+  dest->resize(dest_ptr - dest->get_buffer());
 
-  return d->get_and_lock_buffer();
+  return dest;
 }
 
 memory_cptr
 rbsp_to_nalu(memory_cptr const &buffer) {
-  int pos, size = buffer->get_size();
-  mm_mem_io_c d(nullptr, size, 100);
-  uint8_t *b = buffer->get_buffer();
-
-  for (pos = 0; pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 >= b[pos + 2])) {
-      d.write_uint8(0);
-      d.write_uint8(0);
-      d.write_uint8(3);
-      ++pos;
-
-    } else
-      d.write_uint8(b[pos]);
+  auto src  = static_cast<uint8_t const *>(buffer->get_buffer());
+  auto size = buffer->get_size();
+  auto end  = src + size;
+
+  if (!size)
+    return memory_c::alloc(0);
+
+  // Each emulation prevention byte follows at least two source bytes.
+  auto dest     = memory_c::alloc(size + size / 2);
+  auto dest_ptr = dest->get_buffer();
+
+  for (auto pos = find_zero_pair<third_byte_e::at_most>(src, end, 3); pos != end; pos = find_zero_pair<third_byte_e::at_most>(src, end, 3)) {
+    auto span_size = static_cast<std::size_t>(pos + 2 - src);
+
+    std::memcpy(dest_ptr, src, span_size);
+    dest_ptr[span_size]  = 0x03;
+    dest_ptr            += span_size + 1;
+    src                  = pos + 2;
   }
 
-  return d.get_and_lock_buffer();
+  std::memcpy(dest_ptr, src, end - src);
+  dest_ptr += end - src;
+
+  dest->resize(dest_ptr - dest->get_buffer());
+
+  return dest;
 }
 
 void
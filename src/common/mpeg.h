@@ -22,7 +22,18 @@ constexpr auto is_start_code(uint32_t v) {
   return ((v >> 8) & 0xffffff) == START_CODE_PREFIX;
 }
 
-memory_cptr nalu_to_rbsp(memory_cptr const &buffer);
+uint8_t const *find_start_code(uint8_t const *begin, uint8_t const *end);
+uint8_t const *find_start_code_scalar(uint8_t const *begin, uint8_t const *end);
+
+inline uint8_t *
+find_start_code(uint8_t *begin,
+                uint8_t *end) {
+  return const_cast<uint8_t *>(find_start_code(const_cast<uint8_t const *>(begin), const_cast<uint8_t const *>(end)));
+}
+
+// Converts only the first max_size bytes of the NALU if max_size is
+// smaller than its size, e.g. for parsing slice headers.
+memory_cptr nalu_to_rbsp(memory_cptr const &buffer, std::size_t max_size = std::numeric_limits<std::size_t>::max());
 memory_cptr rbsp_to_nalu(memory_cptr const &buffer);
 
 void write_nalu_size(uint8_t *buffer, std::size_t size, std::size_t nalu_size_length);
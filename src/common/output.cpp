@@ -13,6 +13,8 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
+
 #include <QDateTime>
 
 #include "common/command_line.h"
@@ -40,6 +42,22 @@ std::shared_ptr<mm_io_c> g_mm_stdio   = std::shared_ptr<mm_io_c>(new mm_stdio_c)
 static mxmsg_handler_t s_mxmsg_info_handler, s_mxmsg_warning_handler, s_mxmsg_error_handler;
 static std::vector<std::string> s_warnings_emitted, s_errors_emitted;
 
+// Messages may be emitted from worker threads, e.g. by readers running
+// in parallel. Handlers may emit further messages themselves.
+static std::recursive_mutex s_mxmsg_mutex;
+
+static thread_local json_output_capture_c *t_json_output_capture{};
+
+json_output_capture_c::json_output_capture_c()
+  : m_previous{t_json_output_capture}
+{
+  t_json_output_capture = this;
+}
+
+json_output_capture_c::~json_output_capture_c() {
+  t_json_output_capture = m_previous;
+}
+
 static nlohmann::json
 to_json_array(std::vector<std::string> const &messages) {
   auto result = nlohmann::json::array();
@@ -50,8 +68,32 @@ to_json_array(std::vector<std::string> const &messages) {
   return result;
 }
 
+// Every line output when identifying several files in parallel has to
+// name its file, even if the identification failed and only warnings
+// & errors were captured.
+nlohmann::json
+json_output_capture_c::get_output(nlohmann::json const &fields)
+  const {
+  auto output = m_output.value_or(nlohmann::json::object());
+
+  for (auto const &[key, value] : fields.items())
+    output[key] = value;
+
+  output["warnings"] = to_json_array(m_warnings);
+  output["errors"]   = to_json_array(m_errors);
+
+  return output;
+}
+
 void
 display_json_output(nlohmann::json json) {
+  if (t_json_output_capture) {
+    json["warnings"]                = to_json_array(t_json_output_capture->m_warnings);
+    json["errors"]                  = to_json_array(t_json_output_capture->m_errors);
+    t_json_output_capture->m_output = json;
+    return;
+  }
+
   json["warnings"] = to_json_array(s_warnings_emitted);
   json["errors"]   = to_json_array(s_errors_emitted);
 
@@ -62,7 +104,7 @@ static void
 json_warning_error_handler(unsigned int level,
                            std::string const &message) {
   if (MXMSG_WARNING == level) {
-    s_warnings_emitted.push_back(message);
+    (t_json_output_capture ? t_json_output_capture->m_warnings : s_warnings_emitted).push_back(message);
 
     if (mtx::cli::g_abort_on_warnings) {
       display_json_output(nlohmann::json{});
@@ -70,7 +112,7 @@ json_warning_error_handler(unsigned int level,
     }
 
   } else {
-    s_errors_emitted.push_back(message);
+    (t_json_output_capture ? t_json_output_capture->m_errors : s_errors_emitted).push_back(message);
     display_json_output(nlohmann::json{});
     mxexit(2);
   }
@@ -114,6 +156,8 @@ mxmsg(unsigned int level,
   static debugging_option_c s_memory_usage_in_messages{"memory_usage_in_messages"};
   static bool s_saw_cr_after_nl = false;
 
+  std::lock_guard<std::recursive_mutex> lock{s_mxmsg_mutex};
+
   if (g_suppress_info && (MXMSG_INFO == level))
     return;
 
@@ -160,6 +204,8 @@ default_mxinfo(unsigned int,
 
 void
 mxinfo(std::string const &info) {
+  std::lock_guard<std::recursive_mutex> lock{s_mxmsg_mutex};
+
   if (s_mxmsg_info_handler)
     s_mxmsg_info_handler(MXMSG_INFO, info);
 }
@@ -185,6 +231,8 @@ default_mxwarn(unsigned int,
 
 void
 mxwarn(std::string const &warning) {
+  std::lock_guard<std::recursive_mutex> lock{s_mxmsg_mutex};
+
   if (s_mxmsg_warning_handler)
     s_mxmsg_warning_handler(MXMSG_WARNING, warning);
 }
@@ -198,6 +246,8 @@ default_mxerror(unsigned int,
 
 void
 mxerror(std::string const &error) {
+  std::lock_guard<std::recursive_mutex> lock{s_mxmsg_mutex};
+
   if (s_mxmsg_error_handler)
     s_mxmsg_error_handler(MXMSG_ERROR, error);
 }
@@ -41,6 +41,30 @@ bool stdio_redirected();
 void redirect_warnings_and_errors_to_json();
 void display_json_output(nlohmann::json json);
 
+// While an instance exists, display_json_output() as well as warnings
+// & errors redirected to JSON don't print anything but are collected
+// for the current thread only. Used for identifying several files in
+// parallel.
+class json_output_capture_c {
+public:
+  std::optional<nlohmann::json> m_output;
+  std::vector<std::string> m_warnings, m_errors;
+
+protected:
+  json_output_capture_c *m_previous;
+
+public:
+  json_output_capture_c();
+  ~json_output_capture_c();
+
+  json_output_capture_c(json_output_capture_c const &) = delete;
+  json_output_capture_c &operator =(json_output_capture_c const &) = delete;
+
+  // The captured output or an empty object with the given fields as
+  // well as all captured warnings & errors merged in.
+  nlohmann::json get_output(nlohmann::json const &fields) const;
+};
+
 void init_common_output(bool no_charset_detection);
 void set_cc_stdio(const std::string &charset);
 
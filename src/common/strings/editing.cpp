@@ -165,31 +165,22 @@ get_displayable(std::string const &src) {
 std::string
 normalize_line_endings(std::string const &str,
                        line_ending_style_e line_ending_style) {
-  static std::optional<QRegularExpression> s_cr_lf_re, s_cr_re, s_lf_re;
+  static QRegularExpression const s_cr_lf_re{"\r\n"}, s_cr_re{"\r"}, s_lf_re{"\n"};
 
-  if (!s_cr_lf_re) {
-    s_cr_lf_re = QRegularExpression{"\r\n"};
-    s_cr_re    = QRegularExpression{"\r"};
-    s_lf_re    = QRegularExpression{"\n"};
-  }
-
-  auto result = Q(str).replace(*s_cr_lf_re, "\n");
-  result      = result.replace(*s_cr_re,    "\n");
+  auto result = Q(str).replace(s_cr_lf_re, "\n");
+  result      = result.replace(s_cr_re,    "\n");
 
   if (line_ending_style_e::lf == line_ending_style)
     return to_utf8(result);
 
-  return to_utf8(result.replace(*s_lf_re, "\r\n"));
+  return to_utf8(result.replace(s_lf_re, "\r\n"));
 }
 
 std::string
 chomp(std::string const &str) {
-  static std::optional<QRegularExpression> s_trailing_lf_re;
-
-  if (!s_trailing_lf_re)
-    s_trailing_lf_re = QRegularExpression{"[\r\n]+$"};
+  static QRegularExpression const s_trailing_lf_re{"[\r\n]+$"};
 
-  return to_utf8(Q(str).replace(*s_trailing_lf_re, {}));
+  return to_utf8(Q(str).replace(s_trailing_lf_re, {}));
 }
 
 QString
@@ -0,0 +1,182 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   searching for the sync words of audio frame headers
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+# include <arm_neon.h>
+#endif
+
+#include "common/endian.h"
+#include "common/sync_word_scanner.h"
+
+namespace mtx {
+
+namespace {
+
+// The first two bytes of a pattern together with their masks. The
+// vectorized search compares them at all positions of a block and
+// verifies the full pattern only where they match.
+struct prefix_t {
+  uint8_t value[2], mask[2];
+  std::size_t offset;
+};
+
+prefix_t
+prefix_for(sync_word_scanner_c::pattern_t const &pattern) {
+  auto byte_at = [&pattern](uint32_t word, unsigned int idx) -> uint8_t {
+    return idx < pattern.size ? (word >> ((pattern.size - 1 - idx) * 8)) & 0xff : 0;
+  };
+
+  return {
+    { static_cast<uint8_t>(byte_at(pattern.value & pattern.mask, 0)), static_cast<uint8_t>(byte_at(pattern.value & pattern.mask, 1)) },
+    { byte_at(pattern.mask, 0),                                       byte_at(pattern.mask, 1)                                       },
+    pattern.offset,
+  };
+}
+
+} // anonymous namespace
+
+sync_word_scanner_c::sync_word_scanner_c(std::initializer_list<pattern_t> patterns)
+  : m_patterns{patterns}
+{
+  assert(!m_patterns.empty() && (m_patterns.size() <= ms_max_num_patterns));
+
+  for (auto const &pattern : m_patterns)
+    assert((1 <= pattern.size) && (pattern.size <= 4));
+}
+
+bool
+sync_word_scanner_c::matches_at(uint8_t const *buffer,
+                                std::size_t size,
+                                std::size_t position)
+  const {
+  for (auto const &pattern : m_patterns) {
+    if ((position + pattern.offset + pattern.size) > size)
+      continue;
+
+    if ((get_uint_be(&buffer[position + pattern.offset], pattern.size) & pattern.mask) == (pattern.value & pattern.mask))
+      return true;
+  }
+
+  return false;
+}
+
+std::size_t
+sync_word_scanner_c::find_scalar(uint8_t const *buffer,
+                                 std::size_t size,
+                                 std::size_t start)
+  const {
+  for (auto position = start; position < size; ++position)
+    if (matches_at(buffer, size, position))
+      return position;
+
+  return npos;
+}
+
+std::size_t
+sync_word_scanner_c::find(uint8_t const *buffer,
+                          std::size_t size,
+                          std::size_t start)
+  const {
+  auto position = start;
+
+#if defined(__SSE2__) || defined(__AVX2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+  prefix_t prefixes[ms_max_num_patterns];
+  auto num_prefixes = m_patterns.size();
+  std::size_t reach = 0;
+
+  for (auto idx = 0u; idx < num_prefixes; ++idx) {
+    prefixes[idx] = prefix_for(m_patterns[idx]);
+    reach         = std::max(reach, prefixes[idx].offset + 2);
+  }
+#endif
+
+#if defined(__AVX2__)
+  // Each iteration tests the 32 candidates starting at position and
+  // reads up to `reach + 31` bytes from there.
+  while ((position < size) && ((size - position) >= (reach + 31))) {
+    auto hits = _mm256_setzero_si256();
+
+    for (auto idx = 0u; idx < num_prefixes; ++idx) {
+      auto const &prefix = prefixes[idx];
+      auto b0            = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&buffer[position + prefix.offset]));
+      auto b1            = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&buffer[position + prefix.offset + 1]));
+      auto eq0           = _mm256_cmpeq_epi8(_mm256_and_si256(b0, _mm256_set1_epi8(static_cast<char>(prefix.mask[0]))), _mm256_set1_epi8(static_cast<char>(prefix.value[0])));
+      auto eq1           = _mm256_cmpeq_epi8(_mm256_and_si256(b1, _mm256_set1_epi8(static_cast<char>(prefix.mask[1]))), _mm256_set1_epi8(static_cast<char>(prefix.value[1])));
+      hits               = _mm256_or_si256(hits, _mm256_and_si256(eq0, eq1));
+    }
+
+    for (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits)); mask; mask &= mask - 1) {
+      auto candidate = position + std::countr_zero(mask);
+      if (matches_at(buffer, size, candidate))
+        return candidate;
+    }
+
+    position += 32;
+  }
+
+#elif defined(__SSE2__)
+  while ((position < size) && ((size - position) >= (reach + 15))) {
+    auto hits = _mm_setzero_si128();
+
+    for (auto idx = 0u; idx < num_prefixes; ++idx) {
+      auto const &prefix = prefixes[idx];
+      auto b0            = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&buffer[position + prefix.offset]));
+      auto b1            = _mm_loadu_si128(reinterpret_cast<__m128i const *>(&buffer[position + prefix.offset + 1]));
+      auto eq0           = _mm_cmpeq_epi8(_mm_and_si128(b0, _mm_set1_epi8(static_cast<char>(prefix.mask[0]))), _mm_set1_epi8(static_cast<char>(prefix.value[0])));
+      auto eq1           = _mm_cmpeq_epi8(_mm_and_si128(b1, _mm_set1_epi8(static_cast<char>(prefix.mask[1]))), _mm_set1_epi8(static_cast<char>(prefix.value[1])));
+      hits               = _mm_or_si128(hits, _mm_and_si128(eq0, eq1));
+    }
+
+    for (auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits)); mask; mask &= mask - 1) {
+      auto candidate = position + std::countr_zero(mask);
+      if (matches_at(buffer, size, candidate))
+        return candidate;
+    }
+
+    position += 16;
+  }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while ((position < size) && ((size - position) >= (reach + 15))) {
+    auto hits = vdupq_n_u8(0);
+
+    for (auto idx = 0u; idx < num_prefixes; ++idx) {
+      auto const &prefix = prefixes[idx];
+      auto b0            = vld1q_u8(&buffer[position + prefix.offset]);
+      auto b1            = vld1q_u8(&buffer[position + prefix.offset + 1]);
+      auto eq0           = vceqq_u8(vandq_u8(b0, vdupq_n_u8(prefix.mask[0])), vdupq_n_u8(prefix.value[0]));
+      auto eq1           = vceqq_u8(vandq_u8(b1, vdupq_n_u8(prefix.mask[1])), vdupq_n_u8(prefix.value[1]));
+      hits               = vorrq_u8(hits, vandq_u8(eq0, eq1));
+    }
+
+    // NEON lacks a cheap movemask; verify the block's positions with
+    // the scalar code once it's known to contain a candidate.
+    if (vmaxvq_u8(hits))
+      for (auto candidate = position; candidate < (position + 16); ++candidate)
+        if (matches_at(buffer, size, candidate))
+          return candidate;
+
+    position += 16;
+  }
+#endif
+
+  return find_scalar(buffer, size, position);
+}
+
+}
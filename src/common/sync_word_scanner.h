@@ -0,0 +1,49 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   searching for the sync words of audio frame headers
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+namespace mtx {
+
+// Finds positions at which at least one of up to four sync patterns
+// matches. The parsers only decode full headers at those positions
+// instead of at every byte offset.
+class sync_word_scanner_c {
+public:
+  // `size` big-endian bytes located `offset` bytes after the candidate
+  // position must equal `value` after being and-ed with `mask`.
+  struct pattern_t {
+    uint32_t value{}, mask{};
+    unsigned int size{}, offset{};
+  };
+
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+  static constexpr std::size_t ms_max_num_patterns = 4;
+
+protected:
+  std::vector<pattern_t> m_patterns;
+
+public:
+  sync_word_scanner_c(std::initializer_list<pattern_t> patterns);
+
+  // Returns the first position >= start at which a pattern matches
+  // completely within the buffer or npos if there is none.
+  std::size_t find(uint8_t const *buffer, std::size_t size, std::size_t start = 0) const;
+  std::size_t find_scalar(uint8_t const *buffer, std::size_t size, std::size_t start = 0) const;
+
+  bool matches_at(uint8_t const *buffer, std::size_t size, std::size_t position) const;
+};
+
+}
@@ -0,0 +1,85 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   a simple pool of worker threads
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/thread_pool.h"
+
+namespace mtx {
+
+thread_pool_c::thread_pool_c(std::size_t num_threads) {
+  if (!num_threads)
+    num_threads = default_num_threads();
+
+  m_threads.reserve(num_threads);
+
+  for (auto idx = 0u; idx < num_threads; ++idx)
+    m_threads.emplace_back([this]() { run(); });
+}
+
+thread_pool_c::~thread_pool_c() {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_shutting_down = true;
+  }
+
+  m_tasks_available.notify_all();
+
+  for (auto &thread : m_threads)
+    thread.join();
+}
+
+std::size_t
+thread_pool_c::get_num_threads()
+  const {
+  return m_threads.size();
+}
+
+std::size_t
+thread_pool_c::default_num_threads() {
+  return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void
+thread_pool_c::enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_tasks.emplace_back(std::move(task));
+  }
+
+  m_tasks_available.notify_one();
+}
+
+void
+thread_pool_c::run() {
+  while (true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_tasks_available.wait(lock, [this]() { return m_shutting_down || !m_tasks.empty(); });
+
+      // Remaining tasks are still executed when shutting down so that
+      // no future is left without a result.
+      if (m_tasks.empty())
+        return;
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   a simple pool of worker threads
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace mtx {
+
+class thread_pool_c {
+protected:
+  std::vector<std::thread> m_threads;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_tasks_available;
+  bool m_shutting_down{};
+
+public:
+  explicit thread_pool_c(std::size_t num_threads = 0);
+  ~thread_pool_c();
+
+  thread_pool_c(thread_pool_c const &) = delete;
+  thread_pool_c &operator =(thread_pool_c const &) = delete;
+
+  std::size_t get_num_threads() const;
+
+  // Exceptions thrown by the task are stored in the returned future
+  // and re-thrown by its get().
+  template<typename Tfunc>
+  std::future<std::invoke_result_t<Tfunc>>
+  submit(Tfunc &&func) {
+    auto task   = std::make_shared<std::packaged_task<std::invoke_result_t<Tfunc>()>>(std::forward<Tfunc>(func));
+    auto result = task->get_future();
+
+    enqueue([task]() { (*task)(); });
+
+    return result;
+  }
+
+  static std::size_t default_num_threads();
+
+protected:
+  void enqueue(std::function<void()> task);
+  void run();
+};
+
+using thread_pool_cptr = std::shared_ptr<thread_pool_c>;
+
+}
@@ -21,6 +21,7 @@
 #include "common/endian.h"
 #include "common/list_utils.h"
 #include "common/memory.h"
+#include "common/sync_word_scanner.h"
 #include "common/truehd.h"
 
 // TrueHD header fields
@@ -54,6 +55,14 @@ uint8_t const frame_t::ms_mlp_channels[32] = {     1,     2,      3, 4, 3, 4, 5,
 
 constexpr std::size_t PARSER_MIN_HEADER_SIZE = 12;
 
+// Frames start with an AC-3 sync word or carry the TrueHD/MLP major
+// sync word four bytes into the frame.
+static mtx::sync_word_scanner_c const s_frame_scanner{
+  { mtx::ac3::SYNC_WORD, 0xffff,     2, 0 },
+  { TRUEHD_SYNC_WORD,    0xffffffff, 4, 4 },
+  { MLP_SYNC_WORD,       0xffffffff, 4, 4 },
+};
+
 bool
 frame_t::parse_header(uint8_t const *data,
                       std::size_t size) {
@@ -283,13 +292,12 @@ parser_c::resync(unsigned int offset) {
   m_sync_state = state_unsynced;
   auto frame   = frame_t{};
 
-  for (offset = offset + 4; (offset + 4) < size; ++offset) {
-    uint32_t sync_word = get_uint32_be(&data[offset]);
-    if (   (   mtx::included_in(sync_word, TRUEHD_SYNC_WORD, MLP_SYNC_WORD)
-               || (mtx::ac3::SYNC_WORD == get_uint16_be(&data[offset - 4])))
-        && frame.parse_header(&data[offset - 4], size - 4)) {
+  for (auto position = s_frame_scanner.find(data, size, offset);
+       (position != mtx::sync_word_scanner_c::npos) && ((position + 8) < size);
+       position = s_frame_scanner.find(data, size, position + 1)) {
+    if (frame.parse_header(&data[position], size - 4)) {
       m_sync_state  = state_synced;
-      return offset - 4;
+      return position;
     }
   }
 
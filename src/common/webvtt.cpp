@@ -186,12 +186,9 @@ parser_c::get_total_number_of_bytes()
 std::string
 parser_c::adjust_embedded_timestamps(std::string const &text,
                                             timestamp_c const &offset) {
-  static std::optional<QRegularExpression> s_embedded_timestamp_re;
+  static QRegularExpression const s_embedded_timestamp_re{Q(fmt::format("<{0}>", RE_TIMESTAMP))};
 
-  if (!s_embedded_timestamp_re)
-    s_embedded_timestamp_re = QRegularExpression{Q(fmt::format("<{0}>", RE_TIMESTAMP))};
-
-  return mtx::string::replace(text, *s_embedded_timestamp_re, [&offset](auto const &match) {
+  return mtx::string::replace(text, s_embedded_timestamp_re, [&offset](auto const &match) {
     timestamp_c timestamp;
     mtx::string::parse_timestamp(to_utf8(match.captured(1)), timestamp);
     return Q(fmt::format("<{0}>", mtx::string::format_timestamp(timestamp + offset, 3)));
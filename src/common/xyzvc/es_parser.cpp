@@ -14,7 +14,6 @@
 
 #include "common/checksums/base_fwd.h"
 #include "common/endian.h"
-#include "common/memory_slice_cursor.h"
 #include "common/mm_file_io.h"
 #include "common/mpeg.h"
 #include "common/strings/formatting.h"
@@ -79,65 +78,108 @@ es_parser_c::add_bytes(uint8_t *buffer,
                        std::size_t size) {
   maybe_dump_raw_data(buffer, size);
 
-  mtx::mem::slice_cursor_c cursor;
-  int marker_size              = 0;
-  int previous_marker_size     = 0;
-  int previous_pos             = -1;
+  // The data to parse consists of two contiguous spans: the bytes
+  // left over from the previous call (starting with the last start
+  // code found) followed by the new buffer. Start codes are searched
+  // for in each span separately; only the few candidates straddling
+  // both spans are checked byte by byte.
+  auto unparsed      = m_unparsed_buffer && m_unparsed_buffer->get_size() ? m_unparsed_buffer : memory_cptr{};
+  auto unparsed_ptr  = unparsed ? unparsed->get_buffer() : nullptr;
+  auto unparsed_size = unparsed ? unparsed->get_size()   : std::size_t{};
+  auto total_size    = unparsed_size + size;
+
+  auto byte_at = [&](std::size_t pos) -> uint8_t {
+    return pos < unparsed_size ? unparsed_ptr[pos] : buffer[pos - unparsed_size];
+  };
+
+  auto find_next_start_code = [&](std::size_t pos) -> std::size_t {
+    if (pos < unparsed_size) {
+      auto found = mtx::mpeg::find_start_code(unparsed_ptr + pos, unparsed_ptr + unparsed_size) - unparsed_ptr;
+      if (static_cast<std::size_t>(found) < unparsed_size)
+        return found;
+
+      for (pos = std::max(pos, unparsed_size >= 2 ? unparsed_size - 2 : 0); (pos < unparsed_size) && ((pos + 3) <= total_size); ++pos)
+        if ((byte_at(pos) == 0x00) && (byte_at(pos + 1) == 0x00) && (byte_at(pos + 2) == 0x01))
+          return pos;
+
+      pos = unparsed_size;
+    }
+
+    if (pos >= total_size)
+      return total_size;
+
+    return mtx::mpeg::find_start_code(buffer + pos - unparsed_size, buffer + size) - buffer + unparsed_size;
+  };
+
+  // NALUs located completely within one of the spans are passed on as
+  // views into it without copying; the parsers take ownership of the
+  // ones they have to keep. Only NALUs straddling both spans are
+  // assembled into a new buffer.
+  auto extract_nalu = [&](std::size_t start, std::size_t end) -> memory_cptr {
+    if (start >= unparsed_size)
+      return memory_c::borrow(buffer + start - unparsed_size, end - start);
+
+    if (end <= unparsed_size)
+      return memory_c::borrow(unparsed_ptr + start, end - start);
+
+    auto nalu = memory_c::alloc(end - start);
+    std::memcpy(nalu->get_buffer(),                         unparsed_ptr + start, unparsed_size - start);
+    std::memcpy(nalu->get_buffer() + unparsed_size - start, buffer,               end - unparsed_size);
+
+    return nalu;
+  };
+
+  std::optional<std::size_t> previous_pos;
+  std::size_t previous_marker_size{};
   uint64_t previous_parsed_pos = m_parsed_position;
 
-  if (m_unparsed_buffer && (0 != m_unparsed_buffer->get_size()))
-    cursor.add_slice(m_unparsed_buffer);
-  cursor.add_slice(buffer, size);
-
-  if (3 <= cursor.get_remaining_size()) {
-    uint32_t marker =                               1 << 24
-                    | (unsigned int)cursor.get_char() << 16
-                    | (unsigned int)cursor.get_char() <<  8
-                    | (unsigned int)cursor.get_char();
-
-    while (true) {
-      if (NALU_START_CODE == marker)
-        marker_size = 4;
-      else if (NALU_START_CODE == (marker & 0x00ffffff))
-        marker_size = 3;
-
-      if (0 != marker_size) {
-        if (-1 != previous_pos) {
-          int new_size = cursor.get_position() - marker_size - previous_pos - previous_marker_size;
-          auto nalu = memory_c::alloc(new_size);
-          cursor.copy(nalu->get_buffer(), previous_pos + previous_marker_size, new_size);
-          m_parsed_position = previous_parsed_pos + previous_pos;
-
-          mtx::mpeg::remove_trailing_zero_bytes(*nalu);
-          if (nalu->get_size())
-            handle_nalu(nalu, m_parsed_position);
-        }
-        previous_pos         = cursor.get_position() - marker_size;
-        previous_marker_size = marker_size;
-        marker_size          = 0;
-      }
+  for (auto pos = find_next_start_code(0); pos < total_size; pos = find_next_start_code(pos + 3)) {
+    std::size_t marker_size = (pos > 0) && (byte_at(pos - 1) == 0x00) ? 4 : 3;
+    auto marker_pos         = pos + 3 - marker_size;
 
-      if (!cursor.char_available())
-        break;
+    if (previous_pos) {
+      auto nalu_start   = *previous_pos + previous_marker_size;
+      m_parsed_position = previous_parsed_pos + *previous_pos;
 
-      marker <<= 8;
-      marker  |= (unsigned int)cursor.get_char();
+      if (nalu_start < marker_pos) {
+        auto nalu = extract_nalu(nalu_start, marker_pos);
+
+        mtx::mpeg::remove_trailing_zero_bytes(*nalu);
+        if (nalu->get_size())
+          handle_nalu(nalu, m_parsed_position);
+      }
     }
+
+    previous_pos         = marker_pos;
+    previous_marker_size = marker_size;
   }
 
-  if (-1 == previous_pos)
+  if (!previous_pos)
     previous_pos = 0;
 
   m_stream_position += size;
-  m_parsed_position  = previous_parsed_pos + previous_pos;
+  m_parsed_position  = previous_parsed_pos + *previous_pos;
 
-  int new_size = cursor.get_size() - previous_pos;
-  if (0 != new_size) {
-    m_unparsed_buffer = memory_c::alloc(new_size);
-    cursor.copy(m_unparsed_buffer->get_buffer(), previous_pos, new_size);
+  auto new_size = total_size - *previous_pos;
 
-  } else
+  if (!new_size)
     m_unparsed_buffer.reset();
+
+  else if ((*previous_pos == 0) && unparsed)
+    unparsed->add(buffer, size);
+
+  else {
+    m_unparsed_buffer = memory_c::alloc(new_size);
+    auto dest         = m_unparsed_buffer->get_buffer();
+
+    if (*previous_pos < unparsed_size) {
+      std::memcpy(dest, unparsed_ptr + *previous_pos, unparsed_size - *previous_pos);
+      dest += unparsed_size - *previous_pos;
+    }
+
+    auto buffer_start = std::max(*previous_pos, unparsed_size) - unparsed_size;
+    std::memcpy(dest, buffer + buffer_start, size - buffer_start);
+  }
 }
 
 void
@@ -18,6 +18,12 @@ namespace mtx::xyzvc {
 
 constexpr auto NALU_START_CODE = 0x00000001;
 
+// The slice parsers only read the first few fields of the slice
+// header. For valid streams those fit into far fewer bytes than this,
+// even if every third byte is an emulation prevention byte. Therefore
+// only that many bytes of a slice NALU are converted to RBSP.
+constexpr auto SLICE_HEADER_PREFIX_SIZE = 128u;
+
 struct slice_info_t {
 public:
   // Fields common to AVC & HEVC:
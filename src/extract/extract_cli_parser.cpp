@@ -20,6 +20,7 @@
 #include "common/list_utils.h"
 #include "common/path.h"
 #include "common/qt.h"
+#include "common/strings/editing.h"
 #include "common/strings/formatting.h"
 #include "common/strings/parsing.h"
 #include "common/translation.h"
@@ -80,6 +81,8 @@ extract_cli_parser_c::init_parser() {
   add_option("blockadd=level", std::bind(&extract_cli_parser_c::set_blockadd, this), YT("Keep only the BlockAdditions up to this level (default: keep all levels)"));
   add_option("raw",            std::bind(&extract_cli_parser_c::set_raw,      this), YT("Extract the data to a raw file."));
   add_option("fullraw",        std::bind(&extract_cli_parser_c::set_fullraw,  this), YT("Extract the data to a raw file including the CodecPrivate as a header."));
+  add_option("time-range=start-end", std::bind(&extract_cli_parser_c::set_time_range, this),
+             YT("Only extract the part between the two timestamps. Either one can be left out. Extraction starts at the cluster of the last cue point before 'start' and stops at the first cluster starting at or after 'end'."));
   add_informational_option("TID:out", YT("Write track with the ID TID to the file 'out'."));
 
   add_section_header(YT("Example"));
@@ -195,6 +198,21 @@ extract_cli_parser_c::set_fullraw() {
   m_target_mode = track_spec_t::tm_full_raw;
 }
 
+void
+extract_cli_parser_c::set_time_range() {
+  assert_mode(options_c::em_tracks);
+
+  auto &mode  = *m_current_mode;
+  auto parts  = mtx::string::split(m_next_arg, "-");
+  auto valid  = (parts.size() == 2) && (!parts[0].empty() || !parts[1].empty());
+  valid       = valid && (parts[0].empty() || mtx::string::parse_timestamp(parts[0], mode.m_range_start));
+  valid       = valid && (parts[1].empty() || mtx::string::parse_timestamp(parts[1], mode.m_range_end));
+  valid       = valid && !(mode.m_range_start.valid() && mode.m_range_end.valid() && (mode.m_range_start >= mode.m_range_end));
+
+  if (!valid)
+    mxerror(fmt::format(FY("Invalid time range in argument '{0}'.\n"), m_next_arg));
+}
+
 void
 extract_cli_parser_c::set_simple() {
   assert_mode(options_c::em_chapters);
@@ -11,6 +11,7 @@
 #include "common/common_pch.h"
 
 #include "common/list_utils.h"
+#include "common/strings/formatting.h"
 #include "extract/mkvextract.h"
 #include "extract/options.h"
 
@@ -26,8 +27,10 @@ options_c::mode_options_c::dump(std::string const &prefix)
   mxinfo(fmt::format("{0}simple chapter format:   {1}\n"
                      "{0}simple chapter language: {2}\n"
                      "{0}extraction mode:         {3}\n"
-                     "{0}num track specs:         {4}\n",
-                     prefix, m_simple_chapter_format, m_simple_chapter_language.get_closest_iso639_2_alpha_3_code(), static_cast<int>(m_extraction_mode), m_tracks.size()));
+                     "{0}num track specs:         {4}\n"
+                     "{0}time range:              {5} - {6}\n",
+                     prefix, m_simple_chapter_format, m_simple_chapter_language.get_closest_iso639_2_alpha_3_code(), static_cast<int>(m_extraction_mode), m_tracks.size(),
+                     m_range_start.valid() ? mtx::string::format_timestamp(m_range_start) : "-"s, m_range_end.valid() ? mtx::string::format_timestamp(m_range_end) : "-"s));
 
 
   for (auto idx = 0u; idx < m_tracks.size(); ++idx) {
@@ -12,6 +12,12 @@
 
 #include "common/common_pch.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <ebml/EbmlHead.h>
 #include <ebml/EbmlStream.h>
 #include <ebml/EbmlVersion.h>
@@ -20,6 +26,8 @@
 #include <matroska/KaxBlock.h>
 #include <matroska/KaxBlockData.h>
 #include <matroska/KaxCluster.h>
+#include <matroska/KaxCues.h>
+#include <matroska/KaxCuesData.h>
 #include <matroska/KaxSegment.h>
 #include <matroska/KaxTracks.h>
 
@@ -30,6 +38,7 @@
 #include "common/mm_proxy_io.h"
 #include "common/mm_write_buffer_io.h"
 #include "common/strings/formatting.h"
+#include "common/thread_pool.h"
 #include "extract/mkvextract.h"
 #include "extract/xtr_base.h"
 
@@ -221,16 +230,214 @@ handle_simpleblock_timestamps(libmatroska::KaxSimpleBlock &simpleblock) {
     extractor.m_timestamps.emplace_back(get_global_timestamp(simpleblock) + idx * extractor.m_default_duration, extractor.m_default_duration);
 }
 
+// ------------------------------------------------------------------------
+
+// A frame or a codec state to be handed to an extractor. The data may
+// be borrowed from the cluster it was read from; the cluster is kept
+// alive by the memory object.
+struct xtr_job_t {
+  xtr_base_c *m_extractor{};
+  memory_cptr m_data;
+  libmatroska::KaxBlockAdditions *m_additions{};
+  int64_t m_timestamp{}, m_duration{}, m_bref{}, m_fref{};
+  bool m_keyframe{}, m_discardable{}, m_is_codec_state{};
+  timestamp_c m_discard_duration;
+};
+
+static void
+handle_job(xtr_job_t &job) {
+  if (job.m_is_codec_state) {
+    job.m_extractor->handle_codec_state(job.m_data);
+    return;
+  }
+
+  auto f = xtr_frame_t{job.m_data, job.m_additions, job.m_timestamp, job.m_duration, job.m_bref, job.m_fref, job.m_keyframe, job.m_discardable, job.m_discard_duration};
+  job.m_extractor->decode_and_handle_frame(f);
+}
+
+// Handles the jobs of all extractors writing to the same output file.
+// At most one task draining the queue is active at any time, so jobs
+// are handled in the order they're queued in and the output is
+// identical to handling them on the main thread.
+class xtr_worker_c {
+protected:
+  static constexpr std::size_t s_max_queued_jobs = 1024;
+
+  mtx::thread_pool_c &m_pool;
+  std::deque<xtr_job_t> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_space_available, m_idle;
+  bool m_draining{};
+  std::atomic<bool> m_failed{};
+  std::exception_ptr m_error;
+
+public:
+  explicit xtr_worker_c(mtx::thread_pool_c &pool)
+    : m_pool{pool}
+  {
+  }
+
+  void
+  queue(xtr_job_t &&job) {
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    m_space_available.wait(lock, [this]() { return m_jobs.size() < s_max_queued_jobs; });
+    m_jobs.emplace_back(std::move(job));
+
+    if (m_draining)
+      return;
+
+    m_draining = true;
+    m_pool.submit([this]() { drain(); });
+  }
+
+  bool
+  has_failed()
+    const {
+    return m_failed;
+  }
+
+  // Waits until all queued jobs have been handled. Re-throws the
+  // exception an extractor might have thrown.
+  void
+  finish() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+
+    m_idle.wait(lock, [this]() { return !m_draining; });
+
+    if (m_error)
+      std::rethrow_exception(m_error);
+  }
+
+protected:
+  void
+  drain() {
+    while (true) {
+      xtr_job_t job;
+
+      {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        if (m_jobs.empty()) {
+          m_draining = false;
+          m_idle.notify_all();
+          return;
+        }
+
+        job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_space_available.notify_one();
+      }
+
+      // After a failure the remaining jobs are only dropped so that
+      // the main thread never waits for free space in vain.
+      if (m_failed)
+        continue;
+
+      try {
+        handle_job(job);
+      } catch (...) {
+        m_error  = std::current_exception();
+        m_failed = true;
+      }
+    }
+  }
+};
+
+static debugging_option_c s_debug_parallel_extraction{"parallel_extraction"};
+static std::unordered_map<xtr_base_c *, std::shared_ptr<xtr_worker_c>> s_workers_by_extractor;
+static std::vector<std::shared_ptr<xtr_worker_c>> s_workers;
+// Declared last so that it is destroyed first: its threads may still
+// be using the workers if the program exits prematurely.
+static std::unique_ptr<mtx::thread_pool_c> s_worker_pool;
+
+static void
+start_workers() {
+  // Extractors writing to the same file must share a worker.
+  std::unordered_map<xtr_base_c *, std::shared_ptr<xtr_worker_c>> workers_by_master;
+  std::size_t num_files{};
+
+  for (auto const &extractor : track_extractor_list)
+    if (!extractor->m_master)
+      ++num_files;
+
+  if (!num_files)
+    return;
+
+  s_worker_pool = std::make_unique<mtx::thread_pool_c>(std::min(num_files, mtx::thread_pool_c::default_num_threads()));
+
+  for (auto const &extractor : track_extractor_list) {
+    auto master  = extractor->m_master ? extractor->m_master : extractor.get();
+    auto &worker = workers_by_master[master];
+
+    if (!worker) {
+      worker = std::make_shared<xtr_worker_c>(*s_worker_pool);
+      s_workers.push_back(worker);
+    }
+
+    s_workers_by_extractor[extractor.get()] = worker;
+  }
+
+  mxdebug_if(s_debug_parallel_extraction, fmt::format("start_workers: {0} extractors, {1} files, {2} threads\n", track_extractor_list.size(), s_workers.size(), s_worker_pool->get_num_threads()));
+}
+
+static bool
+any_worker_failed() {
+  return std::any_of(s_workers.begin(), s_workers.end(), [](auto const &worker) { return worker->has_failed(); });
+}
+
+static void
+finish_workers() {
+  std::exception_ptr first_error;
+
+  for (auto const &worker : s_workers) {
+    try {
+      worker->finish();
+    } catch (...) {
+      if (!first_error)
+        first_error = std::current_exception();
+    }
+  }
+
+  s_worker_pool.reset();
+  s_workers_by_extractor.clear();
+  s_workers.clear();
+
+  if (auto code = mxexit_requested())
+    mxexit(*code);
+
+  if (!first_error)
+    return;
+
+  // An extractor called mxexit() on a worker thread after having
+  // output its error message. Exit for real now.
+  try {
+    std::rethrow_exception(first_error);
+  } catch (mtx::exit_requested_x &ex) {
+    mxexit(ex.code());
+  }
+}
+
+static void
+queue_job(xtr_job_t &&job) {
+  auto itr = s_workers_by_extractor.find(job.m_extractor);
+
+  if (itr != s_workers_by_extractor.end())
+    itr->second->queue(std::move(job));
+  else
+    handle_job(job);
+}
+
 static int64_t
 handle_blockgroup(libmatroska::KaxBlockGroup &blockgroup,
-                  libmatroska::KaxCluster &cluster,
+                  std::shared_ptr<libmatroska::KaxCluster> const &cluster,
                   int64_t tc_scale) {
   // Only continue if this block group actually contains a block.
   libmatroska::KaxBlock *block = find_child<libmatroska::KaxBlock>(&blockgroup);
   if (!block || (0 == block->NumberFrames()))
     return -1;
 
-  block->SetParent(cluster);
+  block->SetParent(*cluster);
 
   handle_blockgroup_timestamps(blockgroup, tc_scale);
 
@@ -265,8 +472,12 @@ handle_blockgroup(libmatroska::KaxBlockGroup &blockgroup,
 
   auto kcstate = find_child<libmatroska::KaxCodecState>(&blockgroup);
   if (kcstate) {
-    auto ctstate = memory_c::borrow(kcstate->GetBuffer(), kcstate->GetSize());
-    extractor.handle_codec_state(ctstate);
+    auto job             = xtr_job_t{};
+    job.m_extractor      = &extractor;
+    job.m_data           = memory_c::borrow(kcstate->GetBuffer(), kcstate->GetSize(), cluster);
+    job.m_is_codec_state = true;
+
+    queue_job(std::move(job));
   }
 
   for (int i = 0, num_frames = block->NumberFrames(); i < num_frames; i++) {
@@ -287,9 +498,7 @@ handle_blockgroup(libmatroska::KaxBlockGroup &blockgroup,
       discard_padding = timestamp_c::ns(kdiscard_padding->GetValue());
 
     auto &data = block->GetBuffer(i);
-    auto frame = memory_c::borrow(data.Buffer(), data.Size());
-    auto f     = xtr_frame_t{frame, kadditions, this_timestamp, this_duration, bref, fref, (!bref && !fref), false, discard_padding};
-    extractor.decode_and_handle_frame(f);
+    queue_job({ &extractor, memory_c::borrow(data.Buffer(), data.Size(), cluster), kadditions, this_timestamp, this_duration, bref, fref, (!bref && !fref), false, false, discard_padding });
 
     max_timestamp = std::max(max_timestamp, this_timestamp);
   }
@@ -299,11 +508,11 @@ handle_blockgroup(libmatroska::KaxBlockGroup &blockgroup,
 
 static int64_t
 handle_simpleblock(libmatroska::KaxSimpleBlock &simpleblock,
-                   libmatroska::KaxCluster &cluster) {
+                   std::shared_ptr<libmatroska::KaxCluster> const &cluster) {
   if (0 == simpleblock.NumberFrames())
     return -1;
 
-  simpleblock.SetParent(cluster);
+  simpleblock.SetParent(*cluster);
 
   handle_simpleblock_timestamps(simpleblock);
 
@@ -328,9 +537,7 @@ handle_simpleblock(libmatroska::KaxSimpleBlock &simpleblock,
     }
 
     auto &data = simpleblock.GetBuffer(i);
-    auto frame = memory_c::borrow(data.Buffer(), data.Size());
-    auto f     = xtr_frame_t{frame, nullptr, this_timestamp, this_duration, 0, 0, simpleblock.IsKeyframe(), simpleblock.IsDiscardable(), timestamp_c::ns(0)};
-    extractor.decode_and_handle_frame(f);
+    queue_job({ &extractor, memory_c::borrow(data.Buffer(), data.Size(), cluster), nullptr, this_timestamp, this_duration, 0, 0, simpleblock.IsKeyframe(), simpleblock.IsDiscardable(), false, timestamp_c::ns(0) });
 
     max_timestamp = std::max(max_timestamp, this_timestamp);
   }
@@ -340,6 +547,8 @@ handle_simpleblock(libmatroska::KaxSimpleBlock &simpleblock,
 
 static void
 close_extractors() {
+  finish_workers();
+
   for (auto &extractor : track_extractor_list)
     extractor->finish_track();
 
@@ -393,6 +602,103 @@ write_all_cuesheets(libmatroska::KaxChapters &chapters,
   }
 }
 
+// Returns the position of the cluster to start reading at for the
+// range start. For each extracted track the last cue point at or
+// before the start is determined; the earliest of their clusters is
+// used so that every track starts with a key frame. If none of the
+// extracted tracks is indexed, all indexed tracks are considered
+// instead. Nothing is returned if reading has to start at the
+// beginning of the file.
+static std::optional<uint64_t>
+find_range_start_position(kax_analyzer_c &analyzer,
+                          libmatroska::KaxTracks &tracks,
+                          std::vector<track_spec_t> const &tspecs,
+                          timestamp_c const &range_start,
+                          int64_t tc_scale) {
+  auto af_cues = ebml_master_cptr{ analyzer.read_all(EBML_INFO(libmatroska::KaxCues)) };
+  auto cues    = dynamic_cast<libmatroska::KaxCues *>(af_cues.get());
+
+  if (!cues || !find_child<libmatroska::KaxCuePoint>(*cues)) {
+    mxwarn(Y("The file does not contain cues. Extraction will start at the beginning of the file.\n"));
+    return {};
+  }
+
+  struct cue_position_t {
+    uint64_t time, position;
+  };
+
+  std::unordered_set<uint64_t> extracted_tracks, indexed_tracks;
+  std::unordered_map<uint64_t, cue_position_t> start_positions;
+  auto track_idx = int64_t{};
+
+  for (auto const &elt : tracks) {
+    auto ktrack_entry = dynamic_cast<libmatroska::KaxTrackEntry *>(elt);
+    if (!ktrack_entry)
+      continue;
+
+    if (std::find_if(tspecs.begin(), tspecs.end(), [track_idx](auto const &tspec) { return tspec.tid == track_idx; }) != tspecs.end())
+      extracted_tracks.insert(kt_get_number(*ktrack_entry));
+
+    ++track_idx;
+  }
+
+  for (auto const &elt : *cues) {
+    auto kcue_point = dynamic_cast<libmatroska::KaxCuePoint *>(elt);
+    auto ktime      = kcue_point ? find_child<libmatroska::KaxCueTime>(*kcue_point) : nullptr;
+
+    if (!ktime)
+      continue;
+
+    auto time = ktime->GetValue();
+
+    for (auto const &pos_elt : *kcue_point) {
+      auto ktrack_pos = dynamic_cast<libmatroska::KaxCueTrackPositions *>(pos_elt);
+      auto ktrack     = ktrack_pos ? find_child<libmatroska::KaxCueTrack>(*ktrack_pos)           : nullptr;
+      auto kposition  = ktrack_pos ? find_child<libmatroska::KaxCueClusterPosition>(*ktrack_pos) : nullptr;
+      if (!ktrack || !kposition)
+        continue;
+
+      auto track = ktrack->GetValue();
+      indexed_tracks.insert(track);
+
+      if (static_cast<int64_t>(time) * tc_scale > range_start.to_ns())
+        continue;
+
+      auto current = start_positions.find(track);
+      if (   (current == start_positions.end())
+          || (time >  current->second.time)
+          || ((time == current->second.time) && (kposition->GetValue() < current->second.position)))
+        start_positions[track] = { time, kposition->GetValue() };
+    }
+  }
+
+  std::unordered_set<uint64_t> relevant_tracks;
+  for (auto track : extracted_tracks)
+    if (indexed_tracks.count(track))
+      relevant_tracks.insert(track);
+
+  if (relevant_tracks.empty())
+    relevant_tracks = indexed_tracks;
+
+  std::optional<uint64_t> best_position;
+
+  for (auto track : relevant_tracks) {
+    auto start_position = start_positions.find(track);
+
+    // The track's first key frame comes after the start.
+    if (start_position == start_positions.end())
+      return {};
+
+    if (!best_position || (start_position->second.position < *best_position))
+      best_position = start_position->second.position;
+  }
+
+  if (!best_position)
+    return {};
+
+  return analyzer.get_segment_data_start_pos() + *best_position;
+}
+
 void
 find_and_verify_track_uids(libmatroska::KaxTracks &tracks,
                            std::vector<track_spec_t> &tspecs) {
@@ -445,6 +751,7 @@ extract_tracks(kax_analyzer_c &analyzer,
   find_and_verify_track_uids(*tracks, tspecs);
   create_extractors(*tracks, tspecs);
   create_timestamp_files(*tracks, tspecs);
+  start_workers();
 
   try {
     in.setFilePointer(0);
@@ -483,6 +790,13 @@ extract_tracks(kax_analyzer_c &analyzer,
     file->set_timestamp_scale(tc_scale);
     file->set_segment_end(static_cast<libmatroska::KaxSegment &>(*l0));
 
+    if (options.m_range_start.valid()) {
+      auto position = find_range_start_position(analyzer, *tracks, tspecs, options.m_range_start, tc_scale);
+
+      if (position)
+        in.setFilePointer(*position);
+    }
+
     while (true) {
       auto cluster = file->read_next_cluster();
       if (!cluster)
@@ -491,6 +805,9 @@ extract_tracks(kax_analyzer_c &analyzer,
       auto ctc = static_cast<kax_cluster_timestamp_c *> (cluster->FindFirstElt(EBML_INFO(kax_cluster_timestamp_c), false));
       init_timestamp(*cluster, ctc ? ctc->GetValue() : 0, tc_scale);
 
+      if (options.m_range_end.valid() && ctc && (static_cast<int64_t>(ctc->GetValue() * tc_scale) >= options.m_range_end.to_ns()))
+        break;
+
       if (0 == verbose) {
         auto current_percentage = in.getFilePointer() * 100 / file_size;
 
@@ -512,16 +829,20 @@ extract_tracks(kax_analyzer_c &analyzer,
         libebml::EbmlElement *el          = (*cluster)[i];
 
         if (is_type<libmatroska::KaxBlockGroup>(el))
-          max_bg_timestamp = handle_blockgroup(*static_cast<libmatroska::KaxBlockGroup *>(el), *cluster, tc_scale);
+          max_bg_timestamp = handle_blockgroup(*static_cast<libmatroska::KaxBlockGroup *>(el), cluster, tc_scale);
 
         else if (is_type<libmatroska::KaxSimpleBlock>(el))
-          max_bg_timestamp = handle_simpleblock(*static_cast<libmatroska::KaxSimpleBlock *>(el), *cluster);
+          max_bg_timestamp = handle_simpleblock(*static_cast<libmatroska::KaxSimpleBlock *>(el), cluster);
 
         max_timestamp = std::max(max_timestamp, max_bg_timestamp);
       }
 
       if (-1 != max_timestamp)
         file->set_last_timestamp(max_timestamp);
+
+      // Stop early; finish_workers() reports the error.
+      if (any_worker_failed())
+        break;
     }
 
     delete l0;
@@ -550,6 +871,11 @@ extract_tracks(kax_analyzer_c &analyzer,
 
     return true;
   } catch (...) {
+    try {
+      finish_workers();
+    } catch (...) {
+    }
+
     show_error(Y("Caught exception"));
 
     return false;
@@ -14,6 +14,7 @@
 #include "common/common_pch.h"
 
 #include "common/ebml.h"
+#include "common/strings/editing.h"
 #include "common/strings/formatting.h"
 #include "common/strings/parsing.h"
 #include "common/translation.h"
@@ -33,6 +34,8 @@ info_cli_parser_c::init_parser() {
   add_section_header(YT("Options"));
 
   add_option("a|all",                std::bind(&info_cli_parser_c::set_show_all_elements,   this), YT("Show all sub-elements (including cues & seek heads entries) and don't stop at the first cluster."));
+  add_option("byte-range=start-end", std::bind(&info_cli_parser_c::set_byte_range,          this),
+             YT("Only read the clusters starting between the two file positions. Either one can be left out. All other elements are shown, but the remaining clusters are skipped without reading their content."));
   add_option("c|checksum|checksums", std::bind(&info_cli_parser_c::set_checksum,            this), YT("Calculate and display checksums of frame contents."));
   add_option("C|check-mode",         std::bind(&info_cli_parser_c::set_check_mode,          this), YT("Calculate and display checksums and use verbosity level 4."));
   add_option("o|continue",           std::bind(&info_cli_parser_c::set_continue_at_cluster, this), YT("Don't stop processing at the first cluster."));
@@ -40,6 +43,8 @@ info_cli_parser_c::init_parser() {
   add_option("p|hex-positions",      std::bind(&info_cli_parser_c::set_hex_positions,       this), YT("Show the position of each element in hexadecimal."));
   add_option("s|summary",            std::bind(&info_cli_parser_c::set_summary,             this), YT("Only show summaries of the contents, not each element."));
   add_option("t|track-info",         std::bind(&info_cli_parser_c::set_track_info,          this), YT("Show statistics for each track in verbose mode."));
+  add_option("threads=n",            std::bind(&info_cli_parser_c::set_num_threads,         this),
+             YT("Read the clusters with n threads in parallel (default: 1). Only used together with options that read all clusters such as '--summary' or '--track-info'."));
   add_option("x|hexdump",            std::bind(&info_cli_parser_c::set_hexdump,             this), YT("Show the first 16 bytes of each frame as a hex dump."));
   add_option("X|full-hexdump",       std::bind(&info_cli_parser_c::set_full_hexdump,        this), YT("Show all bytes of each frame and other binary elements as a hex dump."));
   add_option("z|size",               std::bind(&info_cli_parser_c::set_size,                this), YT("Show the size of each element including its header."));
@@ -79,6 +84,28 @@ info_cli_parser_c::set_summary() {
 }
 
 
+void
+info_cli_parser_c::set_byte_range() {
+  auto parts = mtx::string::split(m_next_arg, "-");
+  auto start = int64_t{};
+  auto end   = std::numeric_limits<int64_t>::max();
+  auto valid = (parts.size() == 2) && (!parts[0].empty() || !parts[1].empty());
+  valid      = valid && (parts[0].empty() || mtx::string::parse_number(parts[0], start));
+  valid      = valid && (parts[1].empty() || mtx::string::parse_number(parts[1], end));
+  valid      = valid && (0 <= start) && (start < end);
+
+  if (!valid)
+    mxerror(fmt::format(FY("Invalid byte range in argument '{0}'.\n"), m_next_arg));
+
+  m_options.m_byte_range = std::make_pair(start, end);
+}
+
+void
+info_cli_parser_c::set_num_threads() {
+  if (!mtx::string::parse_number(m_next_arg, m_options.m_num_threads) || !m_options.m_num_threads)
+    mxerror(fmt::format(FY("Invalid number of threads in '{0} {1}'.\n"), m_current_arg, m_next_arg));
+}
+
 void
 info_cli_parser_c::set_hexdump() {
   m_options.m_show_hexdump = true;
@@ -31,6 +31,8 @@ protected:
   void set_check_mode();
   void set_continue_at_cluster();
   void set_summary();
+  void set_byte_range();
+  void set_num_threads();
   void set_hexdump();
   void set_full_hexdump();
   void set_size();
@@ -50,10 +50,14 @@ main(int argc,
   info.set_show_size(options.m_show_size);
   info.set_show_track_info(options.m_show_track_info);
   info.set_hexdump_max_size(options.m_hexdump_max_size);
+  info.set_num_threads(options.m_num_threads);
 
   if (options.m_hex_positions)
     info.set_hex_positions(*options.m_hex_positions);
 
+  if (options.m_byte_range)
+    info.set_cluster_range(options.m_byte_range->first, options.m_byte_range->second);
+
   try {
     info.open_and_process_file(options.m_file_name);
   } catch (mtx::kax_info::exception &ex) {
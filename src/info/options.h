@@ -18,4 +18,6 @@ public:
   bool m_calc_checksums{}, m_continue_at_cluster{}, m_show_summary{}, m_show_hexdump{}, m_show_size{}, m_show_track_info{}, m_show_all_elements{};
   int m_hexdump_max_size{16}, m_verbose{};
   std::optional<bool> m_hex_positions;
+  std::optional<std::pair<int64_t, int64_t>> m_byte_range;
+  std::size_t m_num_threads{1};
 };
@@ -13,6 +13,7 @@
 
 #include "common/common_pch.h"
 
+#include "common/bluray/lpcm.h"
 #include "input/bluray_pcm_channel_layout_packet_converter.h"
 #include "merge/generic_packetizer.h"
 
@@ -23,95 +24,23 @@ bluray_pcm_channel_layout_packet_converter_c::bluray_pcm_channel_layout_packet_c
   , m_bytes_per_channel{bytes_per_channel}
   , m_num_input_channels{num_input_channels}
   , m_num_output_channels{num_output_channels}
-  , m_remap_buf_size{}
-  , m_remap{}
 {
-  if (m_num_output_channels == 6) {
-    m_remap_buf_size = m_bytes_per_channel * 3;
-    m_remap          = &bluray_pcm_channel_layout_packet_converter_c::remap_6ch;
-  } else if (m_num_output_channels == 7) {
-    m_remap_buf_size = m_bytes_per_channel * 3;
-    m_remap          = &bluray_pcm_channel_layout_packet_converter_c::remap_7ch;
-  } else if (m_num_output_channels == 8) {
-    m_remap_buf_size = m_bytes_per_channel * 5;
-    m_remap          = &bluray_pcm_channel_layout_packet_converter_c::remap_8ch;
-  }
-
-  if (m_remap_buf_size > 0)
-    m_remap_buf = memory_c::alloc(m_remap_buf_size);
 }
 
 void
 bluray_pcm_channel_layout_packet_converter_c::removal(packet_cptr const &packet) {
-  auto start_ptr                  = packet->data->get_buffer();
-  auto end_ptr                    = start_ptr + packet->data->get_size();
-  auto input_ptr                  = start_ptr;
-  auto output_ptr                 = start_ptr;
-  auto input_bytes_per_iteration  = m_bytes_per_channel * m_num_input_channels;
-  auto output_bytes_per_iteration = m_bytes_per_channel * m_num_output_channels;
-
-  while ((input_ptr + input_bytes_per_iteration) <= end_ptr) {
-    if (input_ptr != output_ptr)
-      std::memmove(output_ptr, input_ptr, output_bytes_per_iteration);
-
-    input_ptr  += input_bytes_per_iteration;
-    output_ptr += output_bytes_per_iteration;
-  }
-
-  packet->data->set_size(output_ptr - start_ptr);
+  auto &data = *packet->data;
+  data.set_size(mtx::bluray::lpcm::remove_channels(data.get_buffer(), data.get_size(), m_bytes_per_channel, m_num_input_channels, m_num_output_channels));
 }
 
 void
-bluray_pcm_channel_layout_packet_converter_c::remap_6ch(packet_cptr const &packet) {
-  auto start_ptr = packet->data->get_buffer();
-  auto end_ptr   = start_ptr + packet->data->get_size();
-
-  // post-remap order: FL FR FC LFE BL BR
-  while (start_ptr != end_ptr) {
-    start_ptr += m_bytes_per_channel * 3;
+bluray_pcm_channel_layout_packet_converter_c::remap(packet_cptr const &packet) {
+  auto &data     = *packet->data;
+  auto remainder = data.get_size() % (m_bytes_per_channel * m_num_output_channels);
+  if (remainder != 0)
+    data.set_size(data.get_size() - remainder);
 
-    memcpy(m_remap_buf->get_buffer(),       start_ptr,                                           m_remap_buf_size);
-    memcpy(start_ptr,                       m_remap_buf->get_buffer() + m_bytes_per_channel * 2, m_bytes_per_channel);
-    memcpy(start_ptr + m_bytes_per_channel, m_remap_buf->get_buffer(),                           m_bytes_per_channel * 2);
-
-    start_ptr += m_remap_buf_size;
-  }
-}
-
-void
-bluray_pcm_channel_layout_packet_converter_c::remap_7ch(packet_cptr const &packet) {
-  auto start_ptr = packet->data->get_buffer();
-  auto end_ptr   = start_ptr + packet->data->get_size();
-
-  // post-remap order: FL FR FC BL BR SL SR
-  while (start_ptr != end_ptr) {
-    start_ptr += m_bytes_per_channel * 3;
-
-    memcpy(m_remap_buf->get_buffer(),           start_ptr,                                       m_remap_buf_size);
-    memcpy(start_ptr,                           m_remap_buf->get_buffer() + m_bytes_per_channel, m_bytes_per_channel * 2);
-    memcpy(start_ptr + m_bytes_per_channel * 2, m_remap_buf->get_buffer(),                       m_bytes_per_channel);
-
-    start_ptr += m_remap_buf_size + m_bytes_per_channel;
-  }
-}
-
-void
-bluray_pcm_channel_layout_packet_converter_c::remap_8ch(packet_cptr const &packet) {
-  auto start_ptr = packet->data->get_buffer();
-  auto end_ptr   = start_ptr + packet->data->get_size();
-
-  // post-remap order: FL FR FC LFE BL BR SL SR
-  while (start_ptr != end_ptr) {
-    start_ptr += m_bytes_per_channel * 3;
-
-    memcpy(m_remap_buf->get_buffer(),           start_ptr,                                           m_remap_buf_size);
-    memcpy(start_ptr,                           m_remap_buf->get_buffer() + m_bytes_per_channel * 4, m_bytes_per_channel);
-    // BL and BR stay at the same place
-    memcpy(start_ptr + m_bytes_per_channel * 3, m_remap_buf->get_buffer(),                           m_bytes_per_channel);
-    memcpy(start_ptr + m_bytes_per_channel * 4, m_remap_buf->get_buffer() + m_bytes_per_channel * 3, m_bytes_per_channel);
-
-    start_ptr += m_remap_buf_size;
-  }
+  mtx::bluray::lpcm::remap_channels(data.get_buffer(), data.get_size(), m_bytes_per_channel, m_num_output_channels);
 }
 
 bool
@@ -121,13 +50,8 @@ bluray_pcm_channel_layout_packet_converter_c::convert(packet_cptr const &packet)
     removal(packet);
 
   // remap channels into WAVEFORMATEXTENSIBLE channel order
-  if (m_remap_buf) {
-    auto remainder = packet->data->get_size() % (m_bytes_per_channel * m_num_output_channels);
-    if (remainder != 0)
-      packet->data->set_size(packet->data->get_size() - remainder);
-
-    (this->*m_remap)(packet);
-  }
+  if ((m_num_output_channels >= 6) && (m_num_output_channels <= 8))
+    remap(packet);
 
   m_ptzr->process(packet);
 
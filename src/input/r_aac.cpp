@@ -83,6 +83,9 @@ aac_reader_c::read_headers() {
         || (mtx::includes(m_ti.m_all_aac_is_sbr, -1) && !m_ti.m_all_aac_is_sbr[-1]))
       m_aacheader.config.profile = detected_profile;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::open_x();
   }
@@ -113,7 +116,7 @@ aac_reader_c::read(generic_packetizer_c *,
 
     while (m_parser.frames_available()) {
       auto frame = m_parser.get_frame();
-      ptzr(0).process(std::make_shared<packet_t>(frame.m_data));
+      ptzr(0).process(mtx::mem::make_pooled<packet_t>(frame.m_data));
     }
   }
 
@@ -143,6 +146,9 @@ aac_reader_c::find_valid_headers(mm_io_c &in,
     in.setFilePointer(0);
 
     return mtx::aac::parser_c::find_consecutive_frames(buf->get_buffer(), num_read, num_headers);
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return -1;
   }
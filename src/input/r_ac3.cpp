@@ -80,7 +80,7 @@ ac3_reader_c::read(generic_packetizer_c *,
   int num_read             = m_in->read(m_chunk->get_buffer(), read_len);
 
   if (0 < num_read)
-    ptzr(0).process(std::make_shared<packet_t>(memory_c::borrow(m_chunk->get_buffer(), num_read)));
+    ptzr(0).process(mtx::mem::make_pooled<packet_t>(memory_c::borrow(m_chunk->get_buffer(), num_read)));
 
   return (0 != num_read) && (0 < (remaining_bytes - num_read)) ? FILE_STATUS_MOREDATA : flush_packetizers();
 }
@@ -113,6 +113,9 @@ ac3_reader_c::find_valid_headers(mm_io_c &in,
 
     return pos;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return -1;
   }
@@ -169,6 +169,9 @@ avi_reader_c::parse_subtitle_chunks() {
           m_subtitle_demuxers.push_back(demuxer);
       }
 
+    } catch (mtx::exit_requested_x &) {
+      throw;
+
     } catch (...) {
     }
   }
@@ -347,6 +350,9 @@ avi_reader_c::create_mpeg4_p10_packetizer() {
 
     show_packetizer_info(0, *ptzr);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxerror_tid(m_ti.m_fname, 0, Y("Could not extract the decoder specific config data (AVCC) from this AVC/H.264 track.\n"));
   }
@@ -600,6 +606,9 @@ avi_reader_c::create_dts_packetizer(int aid) {
 
     return new dts_packetizer_c(this, m_ti, dtsheader);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxerror_tid(m_ti.m_fname, aid + 1, Y("Could not find valid DTS headers in this track's first frames.\n"));
     return nullptr;
@@ -736,7 +745,7 @@ avi_reader_c::read_video() {
   // AVC with framed packets (without NALU start codes but with length fields)
   // or non-AVC video track?
   if (0 >= m_avc_nal_size_size)
-    ptzr(m_vptzr).process(std::make_shared<packet_t>(chunk, timestamp, duration, key ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME));
+    ptzr(m_vptzr).process(mtx::mem::make_pooled<packet_t>(chunk, timestamp, duration, key ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME));
 
   else {
     // AVC video track without NALU start codes. Re-frame with NALU start codes.
@@ -754,7 +763,7 @@ avi_reader_c::read_video() {
       memcpy(nalu->get_buffer() + 4, chunk->get_buffer() + offset, nalu_size);
       offset += nalu_size;
 
-      ptzr(m_vptzr).process(std::make_shared<packet_t>(nalu, timestamp, duration, key ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME));
+      ptzr(m_vptzr).process(mtx::mem::make_pooled<packet_t>(nalu, timestamp, duration, key ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME));
     }
   }
 
@@ -791,7 +800,7 @@ avi_reader_c::read_audio(avi_demuxer_t &demuxer) {
     if (!size)
       continue;
 
-    ptzr(demuxer.m_ptzr).process(std::make_shared<packet_t>(chunk));
+    ptzr(demuxer.m_ptzr).process(mtx::mem::make_pooled<packet_t>(chunk));
 
     m_bytes_processed += size;
 
@@ -951,6 +960,9 @@ avi_reader_c::identify_attachments() {
       parser->set_attachment_id_base(g_attachments.size());
       parser->parse();
 
+    } catch (mtx::exit_requested_x &) {
+      throw;
+
     } catch (...) {
     }
   }
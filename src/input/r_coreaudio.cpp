@@ -140,10 +140,13 @@ coreaudio_reader_c::read(generic_packetizer_c *,
     if (m_in->read(mem, m_current_packet->m_size) != m_current_packet->m_size)
       throw false;
 
-    ptzr(0).process(std::make_shared<packet_t>(mem, m_current_packet->m_timestamp * m_frames_to_timestamp, m_current_packet->m_duration * m_frames_to_timestamp));
+    ptzr(0).process(mtx::mem::make_pooled<packet_t>(mem, m_current_packet->m_timestamp * m_frames_to_timestamp, m_current_packet->m_duration * m_frames_to_timestamp));
 
     ++m_current_packet;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     m_current_packet = m_packets.end();
   }
@@ -173,6 +176,9 @@ coreaudio_reader_c::scan_chunks() {
       m_in->setFilePointer(chunk.m_size, libebml::seek_current);
 
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
@@ -221,6 +227,9 @@ coreaudio_reader_c::read_chunk(std::string const &type,
   } catch (mtx::input::header_parsing_x &) {
     throw;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     debug_error_and_throw(fmt::format("Generic error reading the '{0}' chunk", type));
   }
@@ -255,6 +264,9 @@ coreaudio_reader_c::parse_desc_chunk() {
 
   } catch (mtx::mm_io::exception &ex) {
     debug_error_and_throw(fmt::format("I/O exception during 'desc' parsing: {0}", ex.what()));
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     debug_error_and_throw(fmt::format("Unknown exception during 'desc' parsing"));
   }
@@ -298,6 +310,9 @@ coreaudio_reader_c::parse_pakt_chunk() {
 
   } catch (mtx::mm_io::exception &ex) {
     debug_error_and_throw(fmt::format("I/O exception during 'pakt' parsing: {0}", ex.what()));
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     debug_error_and_throw(fmt::format("Unknown exception during 'pakt' parsing"));
   }
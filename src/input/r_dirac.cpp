@@ -61,6 +61,9 @@ dirac_es_reader_c::read_headers() {
 
     m_in->setFilePointer(0);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::open_x();
   }
@@ -86,7 +89,7 @@ dirac_es_reader_c::read(generic_packetizer_c *,
 
   int num_read = m_in->read(m_buffer->get_buffer(), READ_SIZE);
   if (0 < num_read)
-    ptzr(0).process(std::make_shared<packet_t>(memory_c::borrow(m_buffer->get_buffer(), num_read)));
+    ptzr(0).process(mtx::mem::make_pooled<packet_t>(memory_c::borrow(m_buffer->get_buffer(), num_read)));
 
   return ((READ_SIZE != num_read) || (m_in->getFilePointer() >= m_size)) ? flush_packetizers() : FILE_STATUS_MOREDATA;
 }
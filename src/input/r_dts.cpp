@@ -68,6 +68,9 @@ dts_reader_c::read_headers() {
       throw mtx::input::header_parsing_x();
     m_in->setFilePointer(m_current_chunk->data_start);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::open_x();
   }
@@ -170,7 +173,7 @@ dts_reader_c::read(generic_packetizer_c *,
 
   int num_to_output = decode_buffer(num_read);
 
-  ptzr(0).process(std::make_shared<packet_t>(memory_c::borrow(m_buf[m_cur_buf], num_to_output)));
+  ptzr(0).process(mtx::mem::make_pooled<packet_t>(memory_c::borrow(m_buf[m_cur_buf], num_to_output)));
 
   if (m_in->eof() || (num_read < bytes_to_read))
     return flush_packetizers();
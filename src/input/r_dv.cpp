@@ -64,6 +64,9 @@ dv_reader_c::probe_file(mm_io_c &in) {
       id_result_container_unsupported(in.get_file_name(), mtx::file_type_t::get_name(mtx::file_type_e::dv));
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
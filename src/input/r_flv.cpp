@@ -275,6 +275,9 @@ flv_reader_c::read_headers() {
       m_in->setFilePointer(m_tag.m_next_position);
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::invalid_format_x();
   }
@@ -884,7 +887,7 @@ flv_reader_c::read(generic_packetizer_c *,
     if (track->m_v_frame_rate && track->m_fourcc.equiv("AVC1"))
       duration = mtx::to_int(mtx::rational(1'000'000'000, track->m_v_frame_rate));
 
-    auto packet = std::make_shared<packet_t>(track->m_payload, track->m_timestamp, duration, 'I' == track->m_v_frame_type ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME);
+    auto packet = mtx::mem::make_pooled<packet_t>(track->m_payload, track->m_timestamp, duration, 'I' == track->m_v_frame_type ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME);
 
     if (track->m_extra_data)
       packet->codec_state = track->m_extra_data;
@@ -81,7 +81,10 @@ hdmv_pgs_reader_c::read(generic_packetizer_c *,
 
     mxdebug_if(m_debug, fmt::format("hdmv_pgs_reader_c::read(): type {0:02x} size {1} at {2}\n", static_cast<unsigned int>(frame->get_buffer()[0]), segment_size, m_in->getFilePointer() - 10 - 3));
 
-    ptzr(0).process(std::make_shared<packet_t>(frame, timestamp));
+    ptzr(0).process(mtx::mem::make_pooled<packet_t>(frame, timestamp));
+
+  } catch (mtx::exit_requested_x &) {
+    throw;
 
   } catch (...) {
     mxdebug_if(m_debug, "hdmv_pgs_reader_c::read(): exception\n");
@@ -48,6 +48,7 @@
 #include "common/audio_emphasis.h"
 #include "common/chapters/chapters.h"
 #include "common/codec.h"
+#include "common/compression.h"
 #include "common/container.h"
 #include "common/date_time.h"
 #include "common/debugging.h"
@@ -65,6 +66,7 @@
 #include "common/strings/utf8.h"
 #include "common/tags/tags.h"
 #include "common/tags/vorbis.h"
+#include "common/thread_pool.h"
 #include "common/id_info.h"
 #include "common/vobsub.h"
 #include "input/r_matroska.h"
@@ -409,6 +411,9 @@ kax_reader_c::unlace_vorbis_private_data(kax_track_t *t,
     for (auto const &header : t->headers)
       header->take_ownership();
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return false;
   }
@@ -495,6 +500,9 @@ kax_reader_c::verify_dts_audio_track(kax_track_t *t) {
     t->a_channels = t->dts_header.get_total_num_audio_channels();
     t->codec.set_specialization(t->dts_header.get_codec_specialization());
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return false;
   }
@@ -577,6 +585,9 @@ kax_reader_c::verify_truehd_audio_track(kax_track_t *t) {
       num_frames_to_probe *= 20;
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -597,6 +608,9 @@ kax_reader_c::verify_ac3_audio_track(kax_track_t *t) {
       return true;
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -1571,6 +1585,9 @@ kax_reader_c::handle_seek_head(mm_io_c *io,
         m_deferred_l1_positions[type].push_back(new_seek_pos);
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return;
   }
@@ -1624,6 +1641,9 @@ kax_reader_c::find_level1_elements_via_analyzer() {
     analyzer->with_elements(EBML_ID(libmatroska::KaxChapters),    [this](kax_analyzer_data_c const &data) { m_deferred_l1_positions[dl1t_chapters   ].push_back(data.m_pos); });
     analyzer->with_elements(EBML_ID(libmatroska::KaxTags),        [this](kax_analyzer_data_c const &data) { m_deferred_l1_positions[dl1t_tags       ].push_back(data.m_pos); });
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
@@ -1761,6 +1781,9 @@ kax_reader_c::read_headers_internal() {
 
     read_deferred_level1_elements(static_cast<libmatroska::KaxSegment &>(*l0));
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxwarn(fmt::format("{0} {1} {2}\n",
                        fmt::format(FY("{0}: an unknown exception occurred."), "kax_reader_c::read_headers_internal()"),
@@ -2381,7 +2404,7 @@ kax_reader_c::create_vc1_video_packetizer(kax_track_t *t,
   show_packetizer_info(t->tnum, *t->ptzr_ptr);
 
   if (t->private_data && (sizeof(alBITMAPINFOHEADER) < t->private_data->get_size()))
-    t->ptzr_ptr->process(std::make_shared<packet_t>(memory_c::borrow(t->private_data->get_buffer() + sizeof(alBITMAPINFOHEADER), t->private_data->get_size() - sizeof(alBITMAPINFOHEADER))));
+    t->ptzr_ptr->process(mtx::mem::make_pooled<packet_t>(memory_c::borrow(t->private_data->get_buffer() + sizeof(alBITMAPINFOHEADER), t->private_data->get_size() - sizeof(alBITMAPINFOHEADER))));
 }
 
 void
@@ -2455,6 +2478,9 @@ kax_reader_c::read_first_frames(kax_track_t *t,
       if (t->first_frames_data.size() >= num_wanted)
         break;
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
@@ -2483,6 +2509,11 @@ kax_reader_c::read(generic_packetizer_c *requested_ptzr,
     auto cluster_ts = find_child_value<kax_cluster_timestamp_c>(*cluster);
     init_timestamp(*cluster, cluster_ts, m_tc_scale);
 
+    // The frames being decoded refer to the cluster's memory; all
+    // decoders must be done before the cluster is freed.
+    start_decoding_frames(*cluster);
+    mtx::at_scope_exit_c finish_decoding{[this]() { finish_decoding_frames(); }};
+
     size_t bgidx;
     for (bgidx = 0; bgidx < cluster->ListSize(); bgidx++) {
       libebml::EbmlElement *element = (*cluster)[bgidx];
@@ -2494,6 +2525,9 @@ kax_reader_c::read(generic_packetizer_c *requested_ptzr,
         process_block_group(cluster.get(), static_cast<libmatroska::KaxBlockGroup *>(element));
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxwarn(fmt::format("{0} {1} {2}\n",
                        fmt::format(FY("{0}: an unknown exception occurred."), "kax_reader_c::read()"),
@@ -2565,9 +2599,9 @@ kax_reader_c::process_simple_block(libmatroska::KaxCluster *cluster,
     for (i = 0; block_simple->NumberFrames() > i; ++i) {
       auto &data_buffer = block_simple->GetBuffer(i);
       auto data         = memory_c::borrow(data_buffer.Buffer(), data_buffer.Size());
-      block_track->content_decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+      reverse_block_content_encodings(*block_track, data);
 
-      packet_cptr packet(new packet_t(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref));
+      auto packet = mtx::mem::make_pooled<packet_t>(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref);
       packet->key_flag         = key_flag;
       packet->discardable_flag = discardable_flag;
 
@@ -2579,9 +2613,9 @@ kax_reader_c::process_simple_block(libmatroska::KaxCluster *cluster,
     for (i = 0; i < block_simple->NumberFrames(); i++) {
       auto &data_buffer = block_simple->GetBuffer(i);
       auto data         = memory_c::borrow(data_buffer.Buffer(), data_buffer.Size());
-      block_track->content_decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+      reverse_block_content_encodings(*block_track, data);
 
-      auto packet              = std::make_shared<packet_t>(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref);
+      auto packet              = mtx::mem::make_pooled<packet_t>(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref);
       packet->key_flag         = key_flag;
       packet->discardable_flag = discardable_flag;
 
@@ -2593,6 +2627,68 @@ kax_reader_c::process_simple_block(libmatroska::KaxCluster *cluster,
   block_track->units_processed    += block_simple->NumberFrames();
 }
 
+// Reverses the content encodings of all frames in the cluster on the
+// shared compression thread pool for tracks whose encodings support it
+// (e.g. zlib). The results are picked up by
+// reverse_block_content_encodings() in the cluster's order.
+void
+kax_reader_c::start_decoding_frames(libmatroska::KaxCluster &cluster) {
+  auto pool = compressor_c::get_thread_pool();
+  if (!pool)
+    return;
+
+  for (auto idx = 0u; idx < cluster.ListSize(); ++idx) {
+    auto element = cluster[idx];
+    auto block   = is_type<libmatroska::KaxSimpleBlock>(element) ? static_cast<libmatroska::KaxInternalBlock *>(static_cast<libmatroska::KaxSimpleBlock *>(element))
+                 : is_type<libmatroska::KaxBlockGroup>(element)  ? find_child<libmatroska::KaxBlock>(static_cast<libmatroska::KaxBlockGroup *>(element))
+                 :                                                 nullptr;
+
+    if (!block)
+      continue;
+
+    auto track = find_track_by_num(block->TrackNum());
+    if (!track || (-1 == track->ptzr) || !track->content_decoder.can_reverse_in_parallel(CONTENT_ENCODING_SCOPE_BLOCK))
+      continue;
+
+    for (auto frame_idx = 0u, num_frames = block->NumberFrames(); frame_idx < num_frames; ++frame_idx) {
+      auto &data_buffer = block->GetBuffer(frame_idx);
+      if (!data_buffer.Size())
+        continue;
+
+      auto data = memory_c::borrow(data_buffer.Buffer(), data_buffer.Size());
+
+      m_frames_being_decoded.emplace(data_buffer.Buffer(), pool->submit([&decoder = track->content_decoder, data]() mutable {
+        decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+        return data;
+      }));
+    }
+  }
+}
+
+void
+kax_reader_c::finish_decoding_frames() {
+  for (auto &[buffer, result] : m_frames_being_decoded)
+    result.wait();
+
+  m_frames_being_decoded.clear();
+}
+
+void
+kax_reader_c::reverse_block_content_encodings(kax_track_t &track,
+                                              memory_cptr &data) {
+  // Empty frames aren't decoded in parallel, and their buffer may well
+  // be the same as the following frame's.
+  auto itr = data->get_size() ? m_frames_being_decoded.find(data->get_buffer()) : m_frames_being_decoded.end();
+
+  if (itr == m_frames_being_decoded.end()) {
+    track.content_decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+    return;
+  }
+
+  data = itr->second.get();
+  m_frames_being_decoded.erase(itr);
+}
+
 void
 kax_reader_c::process_block_group_common(libmatroska::KaxBlockGroup *block_group,
                                          packet_t *packet,
@@ -2703,9 +2799,9 @@ kax_reader_c::process_block_group(libmatroska::KaxCluster *cluster,
     for (i = 0; i < block->NumberFrames(); i++) {
       auto &data_buffer = block->GetBuffer(i);
       auto data         = memory_c::borrow(data_buffer.Buffer(), data_buffer.Size());
-      block_track->content_decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+      reverse_block_content_encodings(*block_track, data);
 
-      auto packet                = std::make_shared<packet_t>(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref);
+      auto packet                = mtx::mem::make_pooled<packet_t>(data, m_last_timestamp + i * frame_duration, block_duration, block_bref, block_fref);
       packet->duration_mandatory = duration;
 
       process_block_group_common(block_group, packet.get(), *block_track);
@@ -2724,9 +2820,9 @@ kax_reader_c::process_block_group(libmatroska::KaxCluster *cluster,
   for (auto block_idx = 0u, num_frames = block->NumberFrames(); block_idx < num_frames; ++block_idx) {
     auto &data_buffer = block->GetBuffer(block_idx);
     auto data         = memory_c::borrow(data_buffer.Buffer(), data_buffer.Size());
-    block_track->content_decoder.reverse(data, CONTENT_ENCODING_SCOPE_BLOCK);
+    reverse_block_content_encodings(*block_track, data);
 
-    auto packet = std::make_shared<packet_t>(data, m_last_timestamp + block_idx * frame_duration, block_duration, block_bref, block_fref);
+    auto packet = mtx::mem::make_pooled<packet_t>(data, m_last_timestamp + block_idx * frame_duration, block_duration, block_bref, block_fref);
 
     if (duration && !duration->GetValue())
       packet->duration_mandatory = true;
@@ -2826,6 +2922,9 @@ kax_reader_c::determine_minimum_timestamps() {
         }
       }
 
+    } catch (mtx::exit_requested_x &) {
+      throw;
+
     } catch (...) {
       break;
     }
@@ -16,6 +16,8 @@
 
 #include "common/common_pch.h"
 
+#include <future>
+
 #include <ctime>
 
 #include "common/codec.h"
@@ -226,6 +228,11 @@ private:
   bool m_opus_experimental_warning_shown{}, m_regenerate_chapter_uids{}, m_regenerate_track_uids{}, m_is_webm{};
   std::unordered_map<uint64_t, uint64_t> m_track_uid_mapping;
 
+  // Frames of the current cluster whose content encodings are being
+  // reversed on other threads, keyed by their position in the cluster's
+  // memory.
+  std::unordered_map<uint8_t const *, std::future<memory_cptr>> m_frames_being_decoded;
+
   debugging_option_c m_debug_minimum_timestamp{"kax_reader|kax_reader_minimum_timestamp"}, m_debug_track_headers{"kax_reader|kax_reader_track_headers"};
 
 public:
@@ -330,6 +337,10 @@ protected:
   virtual void process_block_group(libmatroska::KaxCluster *cluster, libmatroska::KaxBlockGroup *block_group);
   virtual void process_block_group_common(libmatroska::KaxBlockGroup *block_group, packet_t *packet, kax_track_t &track);
 
+  virtual void start_decoding_frames(libmatroska::KaxCluster &cluster);
+  virtual void finish_decoding_frames();
+  virtual void reverse_block_content_encodings(kax_track_t &track, memory_cptr &data);
+
   void init_l1_position_storage(deferred_positions_t &storage);
   virtual bool has_deferred_element_been_processed(deferred_l1_type_e type, int64_t position);
 
@@ -82,7 +82,7 @@ mp3_reader_c::read(generic_packetizer_c *,
   if (0 >= nread)
     return flush_packetizers();
 
-  ptzr(0).process(std::make_shared<packet_t>(memory_c::borrow(m_chunk->get_buffer(), nread)));
+  ptzr(0).process(mtx::mem::make_pooled<packet_t>(memory_c::borrow(m_chunk->get_buffer(), nread)));
 
   return FILE_STATUS_MOREDATA;
 }
@@ -125,6 +125,9 @@ mp3_reader_c::find_valid_headers(mm_io_c &io,
     // auto result = find_consecutive_mp3_headers(buf->get_buffer(), nread, num_headers);
     // return -1 == result ? -1 : result + idx;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return -1;
   }
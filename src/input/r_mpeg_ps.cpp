@@ -168,6 +168,9 @@ mpeg_ps_reader_c::read_headers() {
       done |= m_in->eof() || (m_in->getFilePointer() >= m_probe_range);
     } // while (!done)
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -297,6 +300,9 @@ mpeg_ps_reader_c::parse_program_stream_map() {
       es_map_len -= 4 + plen;
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -436,6 +442,9 @@ mpeg_ps_reader_c::parse_packet(mpeg_ps_id_t id,
             packet.m_id.sub_id = bc.get_bits(8);
         }
       }
+    } catch (mtx::exit_requested_x &) {
+      throw;
+
     } catch (...) {
     }
 
@@ -591,6 +600,9 @@ mpeg_ps_reader_c::new_stream_v_avc_or_mpeg_1_2(mpeg_ps_id_t id,
       return;
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -898,6 +910,9 @@ mpeg_ps_reader_c::new_stream_a_pcm(mpeg_ps_id_t,
     track->a_channels        = bc.get_bits(3) + 1;
     bc.skip_bits(8);            // dynamic range control(8)
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw false;
   }
@@ -1078,6 +1093,9 @@ mpeg_ps_reader_c::found_new_stream(mpeg_ps_id_t id) {
   } catch (bool) {
     m_blocked_ids[id.idx()] = true;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxerror_fn(m_ti.m_fname, Y("Error parsing a MPEG PS packet during the header reading phase. This stream seems to be badly damaged.\n"));
   }
@@ -1187,6 +1205,9 @@ mpeg_ps_reader_c::resync_stream(uint32_t &header) {
 
     return true;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxdebug_if(m_debug_resync, "resync failed: exception caught\n");
     return false;
@@ -1324,7 +1345,7 @@ mpeg_ps_reader_c::read(generic_packetizer_c *requested_ptzr,
 
       if (0 < track->buffer_size) {
         if (((track->buffer_usage + packet.m_length) > track->buffer_size)) {
-          auto new_packet = std::make_shared<packet_t>(memory_c::borrow(track->buffer, track->buffer_usage));
+          auto new_packet = mtx::mem::make_pooled<packet_t>(memory_c::borrow(track->buffer, track->buffer_usage));
 
           if (!track->multiple_timestamps_packet_extension->empty()) {
             new_packet->extensions.push_back(packet_extension_cptr(track->multiple_timestamps_packet_extension));
@@ -1355,7 +1376,7 @@ mpeg_ps_reader_c::read(generic_packetizer_c *requested_ptzr,
           return finish();
         }
 
-        ptzr(track->ptzr).process(std::make_shared<packet_t>(buf, timestamp));
+        ptzr(track->ptzr).process(mtx::mem::make_pooled<packet_t>(buf, timestamp));
       }
 
       return FILE_STATUS_MOREDATA;
@@ -1376,7 +1397,7 @@ mpeg_ps_reader_c::finish() {
 
   for (auto &track : tracks)
     if (0 < track->buffer_usage)
-      ptzr(track->ptzr).process(std::make_shared<packet_t>(memory_c::clone(track->buffer, track->buffer_usage)));
+      ptzr(track->ptzr).process(mtx::mem::make_pooled<packet_t>(memory_c::clone(track->buffer, track->buffer_usage)));
 
   file_done = true;
 
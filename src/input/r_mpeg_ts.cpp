@@ -84,6 +84,9 @@ constexpr auto TS_SDT_PID         = 0x0011;
 
 constexpr auto TS_SDT_TID         = 0x42;
 
+constexpr auto TS_NUM_PIDS        = 0x2000;
+constexpr auto TS_READ_BATCH_SIZE = 512;
+
 int reader_c::potential_packet_sizes[] = { 188, 192, 204, 0 };
 
 // ------------------------------------------------------------
@@ -162,7 +165,7 @@ track_c::send_to_packetizer() {
                          pid, pes_payload_size_to_read, pes_payload_read->get_size() - bytes_to_skip, timestamp_to_use, timestamp_to_check, m_timestamp, m_previous_timestamp, f.m_stream_timestamp, min, max, f.m_timestamp_restriction_min_seen, ptzr, use_packet));
 
   if (use_packet) {
-    process(std::make_shared<packet_t>(memory_c::clone(pes_payload_read->get_buffer() + bytes_to_skip, pes_payload_read->get_size() - bytes_to_skip), timestamp_to_use.to_ns(-1)));
+    process(mtx::mem::make_pooled<packet_t>(take_pes_payload(bytes_to_skip), timestamp_to_use.to_ns(-1)));
 
     f.m_packet_sent_to_packetizer = true;
   }
@@ -209,6 +212,19 @@ track_c::clear_pes_payload() {
   pes_payload_size_to_read = 0;
 }
 
+// Large payloads are handed over without copying them. For small ones
+// copying is cheaper than keeping the whole chunk-sized storage alive
+// while the packet is queued.
+memory_cptr
+track_c::take_pes_payload(std::size_t bytes_to_skip) {
+  bytes_to_skip = std::min<std::size_t>(bytes_to_skip, pes_payload_read->get_size());
+
+  if ((pes_payload_read->get_size() * 2) >= pes_payload_read->get_allocated_size())
+    return pes_payload_read->detach(bytes_to_skip);
+
+  return memory_c::clone(pes_payload_read->get_buffer() + bytes_to_skip, pes_payload_read->get_size() - bytes_to_skip);
+}
+
 int
 track_c::new_stream_v_mpeg_1_2(bool end_of_detection) {
   if (!m_m2v_parser) {
@@ -537,7 +553,7 @@ track_c::new_stream_s_teletext() {
   if (!m_ttx_parser)
     return FILE_STATUS_DONE;
 
-  m_ttx_parser->convert(std::make_shared<packet_t>(memory_c::clone(pes_payload_read->get_buffer(), pes_payload_read->get_size())));
+  m_ttx_parser->convert(mtx::mem::make_pooled<packet_t>(take_pes_payload()));
   clear_pes_payload();
 
   return FILE_STATUS_MOREDATA;
@@ -734,6 +750,9 @@ track_c::parse_dovi_pmt_descriptor(pmt_descriptor_t const &pmt_descriptor,
     mxdebug_if(reader.m_debug_dovi, fmt::format("parse_dovi_pmt_descriptor: I/O exception\n"));
     return false;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxdebug_if(reader.m_debug_dovi, fmt::format("parse_dovi_pmt_descriptor: unknown exception\n"));
     return false;
@@ -1257,6 +1276,70 @@ file_t::get_start_source_packet_position()
   return m_start_source_packet_number * m_detected_packet_size;
 }
 
+// Returns the next packet or nullptr if not enough data is left.
+// Packets are read in batches of TS_READ_BATCH_SIZE. The sync bytes of
+// a whole batch are verified in one pass right after reading it;
+// is_in_sync() tells whether or not the packet returned last passed
+// that check.
+uint8_t *
+file_t::read_packet() {
+  if ((m_read_buffer_pos + m_detected_packet_size) > m_read_buffer_fill) {
+    auto capacity = static_cast<std::size_t>(TS_READ_BATCH_SIZE) * m_detected_packet_size;
+
+    if (!m_read_buffer || (m_read_buffer->get_size() != capacity))
+      m_read_buffer = memory_c::alloc(capacity);
+
+    auto buffer    = m_read_buffer->get_buffer();
+    auto remaining = m_read_buffer_fill - m_read_buffer_pos;
+
+    m_read_buffer_file_pos = get_read_position();
+    if (remaining)
+      std::memmove(buffer, buffer + m_read_buffer_pos, remaining);
+
+    m_read_buffer_pos  = 0;
+    m_read_buffer_fill = remaining + m_in->read(buffer + remaining, capacity - remaining);
+
+    auto num_packets   = m_read_buffer_fill / m_detected_packet_size;
+    auto sync_byte     = buffer + m_header_offset;
+    auto num_synced    = std::size_t{};
+
+    while ((num_synced < num_packets) && (sync_byte[num_synced * m_detected_packet_size] == 0x47))
+      ++num_synced;
+
+    m_read_buffer_synced_end = num_synced * m_detected_packet_size;
+
+    if (m_read_buffer_fill < m_detected_packet_size)
+      return nullptr;
+  }
+
+  m_position         = m_read_buffer_file_pos + m_read_buffer_pos;
+  auto packet        = m_read_buffer->get_buffer() + m_read_buffer_pos;
+  m_read_buffer_pos += m_detected_packet_size;
+
+  return packet;
+}
+
+bool
+file_t::is_in_sync()
+  const {
+  return m_read_buffer_pos <= m_read_buffer_synced_end;
+}
+
+uint64_t
+file_t::get_read_position()
+  const {
+  return m_read_buffer_fill ? m_read_buffer_file_pos + m_read_buffer_pos : m_in->getFilePointer();
+}
+
+// Must be called whenever the file position is changed while packets
+// are read via read_packet().
+void
+file_t::clear_read_buffer() {
+  m_read_buffer_pos        = 0;
+  m_read_buffer_fill       = 0;
+  m_read_buffer_synced_end = 0;
+}
+
 // ------------------------------------------------------------
 
 bool
@@ -1313,6 +1396,9 @@ reader_c::detect_packet_size(mm_io_c &in,
         }
       }
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -1332,6 +1418,8 @@ reader_c::setup_initial_tracks() {
   auto &f                      = file();
   f.m_ignored_pids[TS_PAT_PID] = true;
   f.m_ignored_pids[TS_SDT_PID] = true;
+
+  invalidate_pid_tables();
 }
 
 void
@@ -1403,6 +1491,9 @@ reader_c::read_headers_for_file(std::size_t file_num) {
 
       setup_initial_tracks();
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxdebug_if(m_debug_headers, fmt::format("read_headers: caught exception\n"));
   }
@@ -1479,6 +1570,7 @@ reader_c::handle_probed_teletext_pages() {
     track->handle_probed_teletext_pages(newly_created_tracks);
 
   std::copy(newly_created_tracks.begin(), newly_created_tracks.end(), std::back_inserter(m_tracks));
+  invalidate_pid_tables();
 }
 
 void
@@ -1533,6 +1625,7 @@ reader_c::read_headers() {
     read_headers_for_file(idx);
 
   m_tracks = std::move(m_all_probed_tracks);
+  invalidate_pid_tables();
 
   for (int idx = 0, num_files = m_files.size(); idx < num_files; ++idx) {
     parse_clip_info_file(idx);
@@ -1570,6 +1663,7 @@ reader_c::read_headers() {
   }
 
   m_tracks = std::move(identified_tracks);
+  invalidate_pid_tables();
 
   show_demuxer_info();
 }
@@ -1614,6 +1708,9 @@ reader_c::determine_global_timestamp_offset() {
 
       parse_packet(&buf[f.m_header_offset]);
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxdebug_if(m_debug_timestamp_offset, fmt::format("determine_global_timestamp_offset: caught exception\n"));
   }
@@ -1811,6 +1908,7 @@ reader_c::parse_pat(track_c &track) {
     pmt->set_pid(tmp_pid);
 
     m_tracks.push_back(pmt);
+    invalidate_pid_tables();
   }
 
   mxdebug_if(m_debug_pat_pmt, fmt::format("parse_pat: number of PMTs to find: {0}\n", f.m_num_pmts_to_find));
@@ -1901,6 +1999,8 @@ reader_c::parse_pmt_pid_info(mm_mem_io_c &mem,
 
     std::copy(track->m_coupled_tracks.begin(), track->m_coupled_tracks.end(), std::back_inserter(m_tracks));
     f.m_es_to_process += track->m_coupled_tracks.size();
+
+    invalidate_pid_tables();
   }
 
   mxdebug_if(m_debug_pat_pmt,
@@ -2004,42 +2104,39 @@ reader_c::parse_pmt(track_c &track) {
 
 charset_converter_cptr
 reader_c::get_charset_converter_for_coding_type(unsigned int coding) {
-  static std::unordered_map<unsigned int, std::string> coding_names;
-
-  if (coding_names.empty()) {
-    coding_names[0x00]     = "ISO6937";
-    coding_names[0x01]     = "ISO8859-5";
-    coding_names[0x02]     = "ISO8859-6";
-    coding_names[0x03]     = "ISO8859-7";
-    coding_names[0x04]     = "ISO8859-8";
-    coding_names[0x05]     = "ISO8859-9";
-    coding_names[0x06]     = "ISO8859-10";
-    coding_names[0x07]     = "ISO8859-11";
-    coding_names[0x09]     = "ISO8859-13";
-    coding_names[0x0a]     = "ISO8859-14";
-    coding_names[0x0b]     = "ISO8859-15";
-    coding_names[0x10]     = "ISO8859";
-    coding_names[0x13]     = "GB2312";
-    coding_names[0x14]     = "BIG5";
-    coding_names[0x100001] = "ISO8859-1";
-    coding_names[0x100002] = "ISO8859-2";
-    coding_names[0x100003] = "ISO8859-3";
-    coding_names[0x100004] = "ISO8859-4";
-    coding_names[0x100005] = "ISO8859-5";
-    coding_names[0x100006] = "ISO8859-6";
-    coding_names[0x100007] = "ISO8859-7";
-    coding_names[0x100008] = "ISO8859-8";
-    coding_names[0x100009] = "ISO8859-9";
-    coding_names[0x10000a] = "ISO8859-10";
-    coding_names[0x10000b] = "ISO8859-11";
-    coding_names[0x10000d] = "ISO8859-13";
-    coding_names[0x10000e] = "ISO8859-14";
-    coding_names[0x10000f] = "ISO8859-15";
-  }
-
-  auto coding_name = coding_names[coding];
-  if (coding_name.empty())
-    coding_name = "UTF-8";
+  static std::unordered_map<unsigned int, std::string> const s_coding_names{
+    { 0x00,     "ISO6937" }
+  , { 0x01,     "ISO8859-5" }
+  , { 0x02,     "ISO8859-6" }
+  , { 0x03,     "ISO8859-7" }
+  , { 0x04,     "ISO8859-8" }
+  , { 0x05,     "ISO8859-9" }
+  , { 0x06,     "ISO8859-10" }
+  , { 0x07,     "ISO8859-11" }
+  , { 0x09,     "ISO8859-13" }
+  , { 0x0a,     "ISO8859-14" }
+  , { 0x0b,     "ISO8859-15" }
+  , { 0x10,     "ISO8859" }
+  , { 0x13,     "GB2312" }
+  , { 0x14,     "BIG5" }
+  , { 0x100001, "ISO8859-1" }
+  , { 0x100002, "ISO8859-2" }
+  , { 0x100003, "ISO8859-3" }
+  , { 0x100004, "ISO8859-4" }
+  , { 0x100005, "ISO8859-5" }
+  , { 0x100006, "ISO8859-6" }
+  , { 0x100007, "ISO8859-7" }
+  , { 0x100008, "ISO8859-8" }
+  , { 0x100009, "ISO8859-9" }
+  , { 0x10000a, "ISO8859-10" }
+  , { 0x10000b, "ISO8859-11" }
+  , { 0x10000d, "ISO8859-13" }
+  , { 0x10000e, "ISO8859-14" }
+  , { 0x10000f, "ISO8859-15" }
+  };
+
+  auto itr         = s_coding_names.find(coding);
+  auto coding_name = itr != s_coding_names.end() ? itr->second : "UTF-8"s;
 
   auto converter = charset_converter_c::init(coding_name, true);
   return converter ? converter : charset_converter_c::init("UTF-8");
@@ -2227,6 +2324,7 @@ reader_c::parse_pes(track_c &track) {
   if (f.m_timestamp_restriction_max.valid() && has_pts && (pts >= f.m_timestamp_restriction_max)) {
     mxdebug_if(m_debug_mpls, fmt::format("MPLS: stopping processing file as PTS {0} >= max. timestamp restriction {1}\n", pts, f.m_timestamp_restriction_max));
     f.m_in->setFilePointer(f.m_in->get_size());
+    f.clear_read_buffer();
     return;
   }
 
@@ -2283,6 +2381,8 @@ reader_c::handle_packet_for_pid_not_listed_in_pmt(uint16_t pid) {
   m_tracks.push_back(track);
   ++f.m_es_to_process;
 
+  invalidate_pid_tables();
+
   return track;
 }
 
@@ -2520,6 +2620,9 @@ reader_c::probe_packet_complete(track_c &track,
 
   try {
     result = determine_track_parameters(track, end_of_detection);
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -2534,8 +2637,10 @@ reader_c::probe_packet_complete(track_c &track,
 
   if (mtx::included_in(track.type, pid_type_e::pat, pid_type_e::pmt)) {
     auto it = std::find_if(m_tracks.begin(), m_tracks.end(), [&track](track_ptr const &candidate) { return candidate.get() == &track; });
-    if (m_tracks.end() != it)
+    if (m_tracks.end() != it) {
       m_tracks.erase(it);
+      invalidate_pid_tables();
+    }
 
   } else {
     auto &f         = file();
@@ -2798,17 +2903,16 @@ reader_c::read(generic_packetizer_c *requested_ptzr,
   }
 
   f.m_packet_sent_to_packetizer = false;
-  auto prior_position           = f.m_in->getFilePointer();
-
-  uint8_t buf[TS_MAX_PACKET_SIZE + 1];
+  auto prior_position           = f.get_read_position();
 
   while (!f.m_packet_sent_to_packetizer) {
-    f.m_position = f.m_in->getFilePointer();
+    auto packet = f.read_packet();
 
-    if (f.m_in->read(buf, f.m_detected_packet_size) != static_cast<unsigned int>(f.m_detected_packet_size))
+    if (!packet)
       return finish();
 
-    if (buf[f.m_header_offset] != 0x47) {
+    if (!f.is_in_sync()) {
+      f.clear_read_buffer();
       if (resync(f.m_position))
         continue;
       return finish();
@@ -2816,10 +2920,10 @@ reader_c::read(generic_packetizer_c *requested_ptzr,
 
     ++m_packet_num;
 
-    parse_packet(&buf[f.m_header_offset]);
+    parse_packet(&packet[f.m_header_offset]);
   }
 
-  m_bytes_processed += f.m_in->getFilePointer() - prior_position;
+  m_bytes_processed += f.get_read_position() - prior_position;
 
   return FILE_STATUS_MOREDATA;
 }
@@ -2901,6 +3005,9 @@ reader_c::resync(int64_t start_at) {
       return true;
     }
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return false;
   }
@@ -2908,27 +3015,50 @@ reader_c::resync(int64_t start_at) {
   return false;
 }
 
+void
+reader_c::invalidate_pid_tables() {
+  for (auto const &file : m_files)
+    file->m_pid_table_valid = false;
+}
+
+void
+reader_c::build_pid_table(file_t &file)
+  const {
+  file.m_pid_table.assign(TS_NUM_PIDS, track_ptr{});
+
+  for (auto const &track : m_tracks) {
+    if ((track->m_file_num != m_current_file) || (track->pid >= TS_NUM_PIDS))
+      continue;
+
+    auto &entry = file.m_pid_table[track->pid];
+    if (!entry)
+      entry = track;
+  }
+
+  file.m_pid_table_valid = true;
+}
+
 track_ptr
 reader_c::find_track_for_pid(uint16_t pid)
   const {
   auto &f = *m_files[m_current_file];
 
-  for (auto const &track : m_tracks) {
-    if (   (track->m_file_num != m_current_file)
-        || (track->pid        != pid))
-      continue;
+  if (!f.m_pid_table_valid)
+    build_pid_table(f);
 
-    if (track->has_packetizer() || mtx::included_in(f.m_state, processing_state_e::probing, processing_state_e::determining_timestamp_offset))
-      return track;
+  auto const &track = f.m_pid_table[pid & (TS_NUM_PIDS - 1)];
 
-    for (auto const &coupled_track : track->m_coupled_tracks)
-      if (coupled_track->has_packetizer())
-        return coupled_track;
+  if (!track)
+    return {};
 
+  if (track->has_packetizer() || mtx::included_in(f.m_state, processing_state_e::probing, processing_state_e::determining_timestamp_offset))
     return track;
-  }
 
-  return {};
+  for (auto const &coupled_track : track->m_coupled_tracks)
+    if (coupled_track->has_packetizer())
+      return coupled_track;
+
+  return track;
 }
 
 std::pair<uint8_t *, std::size_t>
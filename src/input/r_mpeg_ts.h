@@ -356,6 +356,7 @@ public:
   void add_pes_payload(uint8_t *ts_payload, size_t ts_payload_size);
   void add_pes_payload_to_probe_data();
   void clear_pes_payload();
+  memory_cptr take_pes_payload(std::size_t bytes_to_skip = 0);
   bool is_pes_payload_complete() const;
   bool is_pes_payload_size_unbounded() const;
   std::size_t remaining_payload_size_to_read() const;
@@ -416,7 +417,17 @@ struct file_t {
 
   unsigned int m_header_offset{};
 
-  std::unordered_map<uint16_t, track_ptr> m_pid_to_track_map;
+  // Maps each of the 8192 possible PIDs to the first track in
+  // reader_c::m_tracks belonging to this file. Rebuilt on demand
+  // whenever the list of tracks changes.
+  std::vector<track_ptr> m_pid_table;
+  bool m_pid_table_valid{};
+
+  // Packets are read in batches during muxing. All packets ending at
+  // or before m_read_buffer_synced_end have a valid sync byte.
+  memory_cptr m_read_buffer;
+  std::size_t m_read_buffer_pos{}, m_read_buffer_fill{}, m_read_buffer_synced_end{};
+  uint64_t m_read_buffer_file_pos{};
   std::unordered_map<uint16_t, bool> m_ignored_pids, m_pmt_pid_seen;
   std::vector<generic_packetizer_c *> m_packetizers;
   std::vector<program_t> m_programs;
@@ -443,6 +454,11 @@ struct file_t {
   void reset_processing_state(processing_state_e new_state);
   bool all_pmts_found() const;
   uint64_t get_start_source_packet_position() const;
+
+  uint8_t *read_packet();
+  bool is_in_sync() const;
+  uint64_t get_read_position() const;
+  void clear_read_buffer();
 };
 using file_cptr = std::shared_ptr<file_t>;
 
@@ -504,6 +520,8 @@ private:
   void read_headers_for_file(std::size_t file_num);
 
   track_ptr find_track_for_pid(uint16_t pid) const;
+  void build_pid_table(file_t &file) const;
+  void invalidate_pid_tables();
   std::pair<uint8_t *, std::size_t> determine_ts_payload_start(packet_header_t *hdr) const;
   void setup_initial_tracks();
 
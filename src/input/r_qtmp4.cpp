@@ -1664,18 +1664,29 @@ qtmp4_reader_c::read(generic_packetizer_c *packetizer,
 
     memcpy(buffer->get_buffer(), dmx.esds.decoder_config->get_buffer(), dmx.esds.decoder_config->get_size());
 
-  } else {
-    buffer = memory_c::alloc(index.size);
   }
 
-  if (m_in->read(buffer->get_buffer() + buffer_offset, index.size) != static_cast<uint64_t>(index.size)) {
+  auto chunk_read = false;
+
+  if (buffer)
+    chunk_read = m_in->read(buffer->get_buffer() + buffer_offset, index.size) == static_cast<uint64_t>(index.size);
+
+  else {
+    try {
+      buffer     = m_in->read_zero_copy(index.size);
+      chunk_read = true;
+    } catch (mtx::mm_io::end_of_file_x &) {
+    }
+  }
+
+  if (!chunk_read) {
     mxwarn(fmt::format(FY("Quicktime/MP4 reader: Could not read chunk number {0}/{1} with size {2} from position {3}. Aborting.\n"),
                        dmx.pos, dmx.m_index.size(), index.size, index.file_pos));
     return finish();
   }
 
   auto duration = dmx.m_use_frame_rate_for_duration ? *dmx.m_use_frame_rate_for_duration : index.duration;
-  auto packet   = std::make_shared<packet_t>(buffer, index.timestamp, duration, index.is_keyframe ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME);
+  auto packet   = mtx::mem::make_pooled<packet_t>(buffer, index.timestamp, duration, index.is_keyframe ? VFT_IFRAME : VFT_PFRAMEAUTOMATIC, VFT_NOBFRAME);
   dmx.process(packet);
 
   ++dmx.pos;
@@ -3192,6 +3203,9 @@ qtmp4_demuxer_c::parse_audio_header_priv_atoms(mm_mem_io_c &mio,
 
       try {
         atom = read_qtmp4_atom(&mio, false);
+      } catch (mtx::exit_requested_x &) {
+        throw;
+
       } catch (...) {
         return;
       }
@@ -3254,6 +3268,9 @@ qtmp4_demuxer_c::parse_video_header_priv_atoms(uint64_t atom_size,
 
       try {
         atom = read_qtmp4_atom(&mio);
+      } catch (mtx::exit_requested_x &) {
+        throw;
+
       } catch (...) {
         return;
       }
@@ -3306,6 +3323,9 @@ qtmp4_demuxer_c::parse_subtitles_header_priv_atoms(uint64_t atom_size,
 
       try {
         atom = read_qtmp4_atom(&mio);
+      } catch (mtx::exit_requested_x &) {
+        throw;
+
       } catch (...) {
         return;
       }
@@ -130,7 +130,7 @@ truehd_reader_c::read(generic_packetizer_c *,
   auto num_read = m_in->read(m_chunk->get_buffer(), read_len);
 
   if (0 < num_read)
-    m_converter.convert(std::make_shared<packet_t>(memory_c::borrow(m_chunk->get_buffer(), num_read)));
+    m_converter.convert(mtx::mem::make_pooled<packet_t>(memory_c::borrow(m_chunk->get_buffer(), num_read)));
 
   if (num_read == read_len)
     return FILE_STATUS_MOREDATA;
@@ -192,6 +192,9 @@ truehd_reader_c::find_valid_headers(mm_io_c &in,
 
     return num_sync_frames >= num_headers;
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return false;
   }
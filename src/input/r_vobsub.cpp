@@ -105,12 +105,18 @@ vobsub_reader_c::read_headers() {
 
   try {
     m_in = std::make_shared<mm_file_io_c>(idx_name);
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::extended_x(fmt::format(FY("Could not open '{0}' for reading.\n"), idx_name));
   }
 
   try {
     m_sub_file = std::make_shared<mm_file_io_c>(sub_name);
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::extended_x(fmt::format(FY("Could not open '{0}' for reading.\n"), sub_name));
   }
@@ -432,7 +438,7 @@ vobsub_reader_c::deliver_packet(uint8_t *buf,
   }
 
   if (duration.valid())
-    packetizer->process(std::make_shared<packet_t>(memory_c::take_ownership(buf, size), timestamp, duration.to_ns()));
+    packetizer->process(mtx::mem::make_pooled<packet_t>(memory_c::take_ownership(buf, size), timestamp, duration.to_ns()));
   else
     safefree(buf);
 
@@ -117,6 +117,9 @@ wav_reader_c::parse_fmt_chunk() {
     else
       m_format_tag = get_uint16_le(&m_wheader.common.wFormatTag);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::header_parsing_x();
   }
@@ -333,6 +336,9 @@ wav_reader_c::scan_chunks_wave() {
       m_in->setFilePointer(new_chunk.len, libebml::seek_current);
 
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
@@ -367,6 +373,9 @@ wav_reader_c::scan_chunks_wave64() {
       m_in->setFilePointer(new_chunk.len, libebml::seek_current);
 
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
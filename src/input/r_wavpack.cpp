@@ -42,6 +42,9 @@ wavpack_reader_c::read_headers() {
     int packet_size = mtx::wavpack::parse_frame(*m_in, header, meta, true, true);
     if (0 > packet_size)
       mxerror_fn(m_ti.m_fname, Y("The file header was not read correctly.\n"));
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     throw mtx::input::open_x();
   }
@@ -61,6 +64,9 @@ wavpack_reader_c::read_headers() {
       m_in_correc->setFilePointer(m_in_correc->getFilePointer() - sizeof(mtx::wavpack::header_t));
       meta.has_correction = true;
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     if (verbose)
       mxinfo_fn(m_ti.m_fname, fmt::format(FY("Could not open the corresponding correction file '{0}c'.\n"), m_ti.m_fname));
@@ -147,7 +153,7 @@ wavpack_reader_c::read(generic_packetizer_c *,
     data_size  -= truncate_bytes;
   }
 
-  packet_cptr packet(new packet_t(memory_c::take_ownership(chunk, data_size)));
+  auto packet = mtx::mem::make_pooled<packet_t>(memory_c::take_ownership(chunk, data_size));
 
   // find the if there is a correction file data corresponding
   if (!m_in_correc) {
@@ -90,7 +90,7 @@ subtitles_c::process(generic_packetizer_c *p) {
   if (empty() || (entries.end() == current))
     return;
 
-  packet_cptr packet(new packet_t(memory_c::borrow(current->subs), current->start, current->end - current->start));
+  auto packet = mtx::mem::make_pooled<packet_t>(memory_c::borrow(current->subs), current->start, current->end - current->start);
   packet->extensions.push_back(packet_extension_cptr(new subtitle_number_packet_extension_c(current->number)));
   p->process(packet);
   ++current;
@@ -125,6 +125,9 @@ srt_parser_c::probe(mm_text_io_c &io) {
     s = io.getline();
     io.setFilePointer(0);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     return false;
   }
@@ -332,6 +335,9 @@ ssa_parser_c::probe(mm_text_io_c &io) {
       // Neither a wanted line nor an empty one/a comment: negative result.
       return false;
     }
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -354,20 +354,16 @@ teletext_to_srt_packet_converter_c::decode_line(uint8_t const *buffer,
 
   auto to_clean = Q(recoded);
 
-  static std::optional<QRegularExpression> s_re_spaces_start_end, s_re_spaces_before_closing_tag, s_re_spaces_after_opening_tag, s_re_no_content;
-
-  if (!s_re_spaces_start_end) {
-    s_re_spaces_before_closing_tag = QRegularExpression{Q("[[:space:]]+</font>[[:space:]]*")};
-    s_re_spaces_after_opening_tag  = QRegularExpression{Q("[[:space:]]*(<font color=[^>]+>)[[:space:]]+")};
-    s_re_spaces_start_end          = QRegularExpression{Q("^[[:space:]]+|[[:space:]]+$")};
-    s_re_no_content                = QRegularExpression{Q("<font color=[^>]+>[[:space:]]*</font>")};
-  }
+  static QRegularExpression const s_re_spaces_before_closing_tag{Q("[[:space:]]+</font>[[:space:]]*")};
+  static QRegularExpression const s_re_spaces_after_opening_tag{Q("[[:space:]]*(<font color=[^>]+>)[[:space:]]+")};
+  static QRegularExpression const s_re_spaces_start_end{Q("^[[:space:]]+|[[:space:]]+$")};
+  static QRegularExpression const s_re_no_content{Q("<font color=[^>]+>[[:space:]]*</font>")};
 
   to_clean
-    .replace(*s_re_spaces_before_closing_tag, Q("</font> "))
-    .replace(*s_re_spaces_after_opening_tag,  Q(" \\1"))
-    .replace(*s_re_no_content,                {})
-    .replace(*s_re_spaces_start_end,          {});
+    .replace(s_re_spaces_before_closing_tag, Q("</font> "))
+    .replace(s_re_spaces_after_opening_tag,  Q(" \\1"))
+    .replace(s_re_no_content,                {})
+    .replace(s_re_spaces_start_end,          {});
 
   recoded = to_utf8(to_clean);
 
@@ -461,7 +457,7 @@ teletext_to_srt_packet_converter_c::queue_page_content(std::string const &conten
   }
 
   auto duration   = (m_current_track->m_page_timestamp - m_current_track->m_queued_timestamp).abs();
-  auto new_packet = std::make_shared<packet_t>(memory_c::clone(content), m_current_track->m_queued_timestamp.to_ns(), duration.to_ns());
+  auto new_packet = mtx::mem::make_pooled<packet_t>(memory_c::clone(content), m_current_track->m_queued_timestamp.to_ns(), duration.to_ns());
 
   queue_packet(new_packet);
 
@@ -54,6 +54,9 @@ signature_t::match(mm_io_c &in)
 
     id_result_container_unsupported(in.get_file_name(), name);
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
   }
 }
@@ -29,6 +29,7 @@
 #include "merge/output_control.h"
 #include "merge/packet_extensions.h"
 #include "merge/private/cluster_helper.h"
+#include "merge/timing_statistics.h"
 
 #include <matroska/KaxBlock.h>
 #include <matroska/KaxBlockData.h>
@@ -400,6 +401,7 @@ cluster_helper_c::must_duration_be_set(render_groups_c *rg,
 
 int
 cluster_helper_c::render() {
+  mtx::timing_statistics::timer_c timer{mtx::timing_statistics::get_stage(mtx::timing_statistics::global_stage_e::cluster_rendering)};
 
   std::vector<render_groups_cptr> render_groups;
   kax_cues_with_cleanup_c cues;
@@ -438,6 +440,9 @@ cluster_helper_c::render() {
       continue;
     }
 
+    timer.add_packets(1);
+    timer.add_bytes(pack->data->get_size());
+
     render_groups_c *render_group = nullptr;
     for (auto &rg : render_groups)
       if (rg->m_source == source) {
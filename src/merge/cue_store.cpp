@@ -0,0 +1,318 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   compact storage for cue points
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <queue>
+
+#include "common/mm_file_io.h"
+#include "common/mm_io_x.h"
+#include "merge/cue_store.h"
+
+namespace {
+
+// Six LEB128 encoded values of at most ten bytes each
+constexpr std::size_t s_max_encoded_point_size = 6 * 10;
+constexpr std::size_t s_spill_read_buffer_size = 64 * 1024;
+
+void
+put_leb128(std::vector<uint8_t> &data,
+           uint64_t value) {
+  do {
+    uint8_t byte   = value & 0x7f;
+    value        >>= 7;
+
+    data.push_back(byte | (value ? 0x80 : 0x00));
+  } while (value);
+}
+
+uint64_t
+get_leb128(uint8_t const *&ptr) {
+  uint64_t value{};
+  auto shift = 0u;
+
+  while (true) {
+    auto byte  = *ptr++;
+    value     |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    shift     += 7;
+
+    if (!(byte & 0x80) || (shift >= 64))
+      return value;
+  }
+}
+
+bool
+compare_points(cue_point_t const &a,
+               cue_point_t const &b) {
+  return (a.timestamp < b.timestamp)
+      || ((a.timestamp == b.timestamp) && (a.track_num < b.track_num));
+}
+
+} // anonymous namespace
+
+// Decodes the points of a single run. Timestamps and cluster positions
+// are stored as differences to the previous point; all values are
+// LEB128 encoded. Position adjustments made after the run was sealed
+// are applied while decoding.
+class cue_store_c::run_reader_c {
+public:
+  cue_point_t m_point;
+  std::size_t m_run_idx;
+
+protected:
+  cue_store_c &m_store;
+  run_t const &m_run;
+  std::vector<uint8_t> m_buffer;
+  uint8_t const *m_ptr{}, *m_end{};
+  uint64_t m_file_position{}, m_file_bytes_left{};
+  std::size_t m_points_left;
+  uint64_t m_stored_cluster_position{};
+
+public:
+  run_reader_c(cue_store_c &store,
+               std::size_t run_idx)
+    : m_run_idx{run_idx}
+    , m_store{store}
+    , m_run{store.m_runs[run_idx]}
+    , m_points_left{m_run.m_num_points}
+  {
+    if (!m_run.m_data.empty()) {
+      m_ptr = m_run.m_data.data();
+      m_end = m_ptr + m_run.m_data.size();
+
+    } else {
+      m_file_position   = m_run.m_spill_position;
+      m_file_bytes_left = m_run.m_size;
+    }
+  }
+
+  bool
+  next() {
+    if (!m_points_left)
+      return false;
+
+    if (static_cast<std::size_t>(m_end - m_ptr) < s_max_encoded_point_size)
+      refill();
+
+    m_point.timestamp            += get_leb128(m_ptr);
+    m_point.track_num             = get_leb128(m_ptr);
+    m_stored_cluster_position    += get_leb128(m_ptr);
+    m_point.relative_position     = get_leb128(m_ptr);
+    m_point.duration              = get_leb128(m_ptr);
+    m_point.codec_state_position  = get_leb128(m_ptr);
+    m_point.cluster_position      = m_stored_cluster_position;
+
+    auto const &adjustments = m_store.m_position_adjustments;
+
+    for (auto idx = m_run.m_first_adjustment, num_adjustments = adjustments.size(); idx < num_adjustments; ++idx) {
+      auto [old_position, delta] = adjustments[idx];
+
+      if (m_point.cluster_position >= old_position)
+        m_point.cluster_position += delta;
+
+      if (m_point.codec_state_position && (m_point.codec_state_position >= old_position))
+        m_point.codec_state_position += delta;
+    }
+
+    --m_points_left;
+
+    return true;
+  }
+
+protected:
+  void
+  refill() {
+    if (!m_file_bytes_left)
+      return;
+
+    auto remaining = static_cast<std::size_t>(m_end - m_ptr);
+    auto to_read   = std::min<uint64_t>(s_spill_read_buffer_size, m_file_bytes_left);
+
+    std::vector<uint8_t> buffer(remaining + to_read);
+    if (remaining)
+      std::memcpy(buffer.data(), m_ptr, remaining);
+
+    auto &file = *m_store.m_spill_file;
+    file.setFilePointer(m_file_position);
+    if (file.read(buffer.data() + remaining, to_read) != to_read)
+      throw mtx::mm_io::end_of_file_x{};
+
+    m_file_position   += to_read;
+    m_file_bytes_left -= to_read;
+    m_buffer           = std::move(buffer);
+    m_ptr              = m_buffer.data();
+    m_end              = m_ptr + m_buffer.size();
+  }
+};
+
+cue_store_c::cue_store_c(std::size_t run_size,
+                         uint64_t memory_limit)
+  : m_run_size{std::max<std::size_t>(run_size, 1)}
+  , m_memory_limit{memory_limit}
+{
+}
+
+cue_store_c::~cue_store_c() {
+  remove_spill_file();
+}
+
+void
+cue_store_c::add(cue_point_t const &point) {
+  m_open_points.push_back(point);
+  ++m_num_points;
+}
+
+void
+cue_store_c::seal_open_points_if_full() {
+  if (m_open_points.size() >= m_run_size)
+    seal_open_points();
+}
+
+void
+cue_store_c::seal_open_points() {
+  if (m_open_points.empty())
+    return;
+
+  // Points are usually added in almost sorted order already.
+  if (!std::is_sorted(m_open_points.begin(), m_open_points.end(), compare_points))
+    std::stable_sort(m_open_points.begin(), m_open_points.end(), compare_points);
+
+  run_t run;
+  run.m_num_points       = m_open_points.size();
+  run.m_first_adjustment = m_position_adjustments.size();
+  run.m_data.reserve(m_open_points.size() * 12);
+
+  uint64_t previous_timestamp{}, previous_cluster_position{};
+
+  for (auto const &point : m_open_points) {
+    put_leb128(run.m_data, point.timestamp - previous_timestamp);
+    put_leb128(run.m_data, point.track_num);
+    // Wraps around for decreasing positions; decoding wraps back.
+    put_leb128(run.m_data, point.cluster_position - previous_cluster_position);
+    put_leb128(run.m_data, point.relative_position);
+    put_leb128(run.m_data, point.duration);
+    put_leb128(run.m_data, point.codec_state_position);
+
+    previous_timestamp        = point.timestamp;
+    previous_cluster_position = point.cluster_position;
+  }
+
+  run.m_data.shrink_to_fit();
+  run.m_size     = run.m_data.size();
+  m_memory_used += run.m_size;
+
+  mxdebug_if(m_debug, fmt::format("cue_store: sealed run {0} with {1} points in {2} bytes; memory used {3}\n", m_runs.size(), run.m_num_points, run.m_size, m_memory_used));
+
+  m_runs.emplace_back(std::move(run));
+  m_open_points.clear();
+
+  if (m_memory_used > m_memory_limit)
+    spill_runs();
+}
+
+void
+cue_store_c::spill_runs() {
+  try {
+    if (!m_spill_file) {
+      m_spill_file_name = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("mkvmerge-cues-%%%%-%%%%-%%%%-%%%%.tmp")).string();
+      m_spill_file      = std::make_shared<mm_file_io_c>(m_spill_file_name, libebml::MODE_CREATE);
+    }
+
+    for (auto &run : m_runs) {
+      if (run.m_data.empty())
+        continue;
+
+      m_spill_file->setFilePointer(0, libebml::seek_end);
+      run.m_spill_position = m_spill_file->getFilePointer();
+
+      if (m_spill_file->write(run.m_data.data(), run.m_size) != run.m_size)
+        throw mtx::mm_io::insufficient_space_x{};
+
+      m_memory_used -= run.m_size;
+      std::vector<uint8_t>{}.swap(run.m_data);
+    }
+
+    mxdebug_if(m_debug, fmt::format("cue_store: spilled runs to {0}; memory used {1}\n", m_spill_file_name, m_memory_used));
+
+  } catch (mtx::mm_io::exception &ex) {
+    mxdebug_if(m_debug, fmt::format("cue_store: spilling to {0} failed ({1}); keeping everything in memory\n", m_spill_file_name, ex.what()));
+    m_memory_limit = std::numeric_limits<uint64_t>::max();
+  }
+}
+
+void
+cue_store_c::adjust_positions(uint64_t old_position,
+                              uint64_t delta) {
+  for (auto &point : m_open_points) {
+    if (point.cluster_position >= old_position)
+      point.cluster_position += delta;
+
+    if (point.codec_state_position && (point.codec_state_position >= old_position))
+      point.codec_state_position += delta;
+  }
+
+  if (!m_runs.empty())
+    m_position_adjustments.emplace_back(old_position, delta);
+}
+
+void
+cue_store_c::for_each(std::function<void(cue_point_t const &)> const &worker) {
+  assert(m_open_points.empty());
+
+  std::vector<std::unique_ptr<run_reader_c>> readers;
+  auto later = [&readers](std::size_t a, std::size_t b) {
+    auto const &point_a = readers[a]->m_point;
+    auto const &point_b = readers[b]->m_point;
+
+    return compare_points(point_b, point_a) || (!compare_points(point_a, point_b) && (b < a));
+  };
+  std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> queue{later};
+
+  for (auto idx = 0u; idx < m_runs.size(); ++idx) {
+    readers.emplace_back(new run_reader_c{*this, idx});
+    if (readers.back()->next())
+      queue.push(idx);
+  }
+
+  while (!queue.empty()) {
+    auto idx = queue.top();
+    queue.pop();
+
+    worker(readers[idx]->m_point);
+
+    if (readers[idx]->next())
+      queue.push(idx);
+  }
+}
+
+void
+cue_store_c::clear() {
+  m_open_points.clear();
+  m_runs.clear();
+  m_position_adjustments.clear();
+  m_num_points  = 0;
+  m_memory_used = 0;
+
+  remove_spill_file();
+}
+
+void
+cue_store_c::remove_spill_file() {
+  if (!m_spill_file)
+    return;
+
+  m_spill_file.reset();
+
+  boost::system::error_code ec;
+  boost::filesystem::remove(m_spill_file_name, ec);
+}
@@ -0,0 +1,96 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   compact storage for cue points
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+struct cue_point_t {
+  uint64_t timestamp{}, duration{}, cluster_position{}, codec_state_position{};
+  uint32_t track_num{}, relative_position{};
+};
+
+// Cue points are collected in an open, unsorted list that can still
+// be modified. Once enough have been collected they're sorted by
+// timestamp & track number and encoded compactly into a run of their
+// own. Runs are merged on the fly when the points are read back. If
+// the runs use more memory than allowed they're moved to a temporary
+// file.
+class cue_store_c {
+public:
+  static constexpr std::size_t s_default_run_size  = 64 * 1024;
+  static constexpr uint64_t s_default_memory_limit = 32 * 1024 * 1024;
+
+protected:
+  struct run_t {
+    std::vector<uint8_t> m_data;         // empty once spilled
+    uint64_t m_spill_position{}, m_size{};
+    std::size_t m_num_points{}, m_first_adjustment{};
+  };
+
+  class run_reader_c;
+
+  std::vector<cue_point_t> m_open_points;
+  std::vector<run_t> m_runs;
+  std::vector<std::pair<uint64_t, uint64_t>> m_position_adjustments;
+  std::size_t m_run_size, m_num_points{};
+  uint64_t m_memory_limit, m_memory_used{};
+
+  std::string m_spill_file_name;
+  mm_io_cptr m_spill_file;
+
+  debugging_option_c m_debug{"cues|cue_store"};
+
+public:
+  cue_store_c(std::size_t run_size = s_default_run_size, uint64_t memory_limit = s_default_memory_limit);
+  ~cue_store_c();
+
+  void add(cue_point_t const &point);
+
+  // Points not sorted into a run yet. They may be modified.
+  std::vector<cue_point_t> &get_open_points() {
+    return m_open_points;
+  }
+
+  void seal_open_points();
+  void seal_open_points_if_full();
+
+  void adjust_positions(uint64_t old_position, uint64_t delta);
+
+  // Calls worker for each point sorted by timestamp & track
+  // number. Points with equal keys are visited in the order they were
+  // added. The open points must have been sealed before.
+  void for_each(std::function<void(cue_point_t const &)> const &worker);
+
+  std::size_t size() const {
+    return m_num_points;
+  }
+
+  bool empty() const {
+    return !m_num_points;
+  }
+
+  uint64_t get_memory_usage() const {
+    return m_memory_used;
+  }
+
+  bool has_spilled() const {
+    return !!m_spill_file;
+  }
+
+  void clear();
+
+protected:
+  void spill_runs();
+  void remove_spill_file();
+};
@@ -21,6 +21,7 @@
 #include "merge/generic_packetizer.h"
 #include "merge/libmatroska_extensions.h"
 #include "merge/output_control.h"
+#include "merge/timing_statistics.h"
 
 cues_cptr cues_c::s_cues;
 
@@ -62,23 +63,25 @@ cues_c::add(libmatroska::KaxCuePoint &point) {
     uint64_t track_num = find_child_value<libmatroska::KaxCueTrack>(*positions);
     assert(track_num <= static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()));
 
-    m_points.push_back({ timestamp, 0, find_child_value<libmatroska::KaxCueClusterPosition>(*positions), static_cast<uint32_t>(track_num), 0 });
+    cue_point_t cue_point;
+    cue_point.timestamp            = timestamp;
+    cue_point.cluster_position     = find_child_value<libmatroska::KaxCueClusterPosition>(*positions);
+    cue_point.codec_state_position = find_child_value<libmatroska::KaxCueCodecState>(*positions);
+    cue_point.track_num            = track_num;
 
-    uint64_t codec_state_position = find_child_value<libmatroska::KaxCueCodecState>(*positions);
-    if (codec_state_position)
-      m_codec_state_position_map[ id_timestamp_t{ track_num, timestamp } ] = codec_state_position;
+    m_store.add(cue_point);
   }
 }
 
 void
 cues_c::write(mm_io_c &out,
               libmatroska::KaxSeekHead &seek_head) {
-  if (!m_points.size() || !g_cue_writing_requested)
+  if (m_store.empty() || !g_cue_writing_requested)
     return;
 
-  // auto start = mtx::sys::get_current_time_millis();
-  sort();
-  // auto end_sort = mtx::sys::get_current_time_millis();
+  mtx::timing_statistics::timer_c timer{mtx::timing_statistics::get_stage(mtx::timing_statistics::global_stage_e::cue_writing)};
+
+  m_store.seal_open_points();
 
   // Need to write the (empty) cues element so that its position will
   // be set for indexing in g_kax_sh_main. Necessary because there's
@@ -94,11 +97,17 @@ cues_c::write(mm_io_c &out,
   seek_head.IndexThis(cues_dummy, *g_kax_segment);
 
   // Forcefully write the correct head and copy its content from the
-  // temporary storage location.
-  auto total_size = calculate_total_size();
+  // temporary storage location. The points are merged from the sorted
+  // runs twice: once for the size, once for writing them.
+  uint64_t total_size{};
+  m_store.for_each([this, &total_size](cue_point_t const &point) { total_size += calculate_point_size(point); });
+
   write_ebml_element_head(out, EBML_ID(libmatroska::KaxCues), total_size);
 
-  for (auto &point : m_points) {
+  timer.add_packets(m_store.size());
+  timer.add_bytes(total_size);
+
+  m_store.for_each([&out](cue_point_t const &point) {
     libmatroska::KaxCuePoint kc_point;
 
     get_child<libmatroska::KaxCueTime>(kc_point).SetValue(point.timestamp / g_timestamp_scale);
@@ -107,9 +116,8 @@ cues_c::write(mm_io_c &out,
     get_child<libmatroska::KaxCueTrack>(positions).SetValue(point.track_num);
     get_child<libmatroska::KaxCueClusterPosition>(positions).SetValue(point.cluster_position);
 
-    auto codec_state_position = m_codec_state_position_map.find({ point.track_num, point.timestamp });
-    if (codec_state_position != m_codec_state_position_map.end())
-      get_child<libmatroska::KaxCueCodecState>(positions).SetValue(codec_state_position->second);
+    if (point.codec_state_position)
+      get_child<libmatroska::KaxCueCodecState>(positions).SetValue(point.codec_state_position);
 
     if (point.relative_position)
       get_child<libmatroska::KaxCueRelativePosition>(positions).SetValue(point.relative_position);
@@ -118,29 +126,10 @@ cues_c::write(mm_io_c &out,
       get_child<libmatroska::KaxCueDuration>(positions).SetValue(round_timestamp_scale(point.duration) / g_timestamp_scale);
 
     g_doc_type_version_handler->render(kc_point, out);
-  }
+  });
 
-  m_points.clear();
-  m_codec_state_position_map.clear();
+  m_store.clear();
   m_num_cue_points_postprocessed = 0;
-
-  // auto end_all = mtx::sys::get_current_time_millis();
-  // mxinfo(fmt::format("dur sort {0} write {1} total {2}\n", end_sort - start, end_all - end_sort, end_all - start));
-}
-
-void
-cues_c::sort() {
-  std::sort(m_points.begin(), m_points.end(), [](cue_point_t const &a, cue_point_t const &b) -> bool {
-      if (a.timestamp < b.timestamp)
-        return true;
-      if (a.timestamp > b.timestamp)
-        return false;
-
-      if (a.track_num < b.track_num)
-        return true;
-
-      return false;
-    });
 }
 
 std::multimap<id_timestamp_t, uint64_t>
@@ -177,14 +166,23 @@ cues_c::postprocess_cues(libmatroska::KaxCues &cues,
                          libmatroska::KaxCluster &cluster) {
   add(cues);
 
-  if (m_no_cue_duration && m_no_cue_relative_position)
-    return;
+  if (!m_no_cue_duration || !m_no_cue_relative_position)
+    set_durations_and_relative_positions(cluster);
 
+  // Only points that have been post-processed may be sealed.
+  m_store.seal_open_points_if_full();
+  m_num_cue_points_postprocessed = m_store.get_open_points().size();
+}
+
+void
+cues_c::set_durations_and_relative_positions(libmatroska::KaxCluster &cluster) {
   auto cluster_data_start_pos = cluster.GetDataStart();
   auto block_positions        = calculate_block_positions(cluster);
   std::map<id_timestamp_t, size_t> nblocks_processed; //# blocks processed so far with given track #/timestamp
 
-  for (auto point = m_points.begin() + m_num_cue_points_postprocessed, end = m_points.end(); point != end; ++point) {
+  auto &points = m_store.get_open_points();
+
+  for (auto point = points.begin() + m_num_cue_points_postprocessed, end = points.end(); point != end; ++point) {
     nblocks_processed[id_timestamp_t{ point->track_num, point->timestamp }]++;
 
     // Set CueRelativePosition for all cues.
@@ -233,17 +231,9 @@ cues_c::postprocess_cues(libmatroska::KaxCues &cues,
                            point->track_num, point->timestamp, duration_itr == m_id_timestamp_duration_multimap.end() ? static_cast<int64_t>(-1) : duration_itr->second));
   }
 
-  m_num_cue_points_postprocessed = m_points.size();
-
   m_id_timestamp_duration_multimap.clear();
 }
 
-uint64_t
-cues_c::calculate_total_size()
-  const {
-  return std::accumulate(m_points.begin(), m_points.end(), 0ull, [this](uint64_t sum, cue_point_t const &point) { return sum + calculate_point_size(point); });
-}
-
 uint64_t
 cues_c::calculate_bytes_for_uint(uint64_t value)
   const {
@@ -262,9 +252,8 @@ cues_c::calculate_point_size(cue_point_t const &point)
                       + EBML_ID(libmatroska::KaxCueTrack).GetLength()           + 1 + calculate_bytes_for_uint(point.track_num)
                       + EBML_ID(libmatroska::KaxCueClusterPosition).GetLength() + 1 + calculate_bytes_for_uint(point.cluster_position);
 
-  auto codec_state_position = m_codec_state_position_map.find({ point.track_num, point.timestamp });
-  if (codec_state_position != m_codec_state_position_map.end())
-    point_size += EBML_ID(libmatroska::KaxCueCodecState).GetLength() + 1 + calculate_bytes_for_uint(codec_state_position->second);
+  if (point.codec_state_position)
+    point_size += EBML_ID(libmatroska::KaxCueCodecState).GetLength() + 1 + calculate_bytes_for_uint(point.codec_state_position);
 
   if (point.relative_position)
     point_size += EBML_ID(libmatroska::KaxCueRelativePosition).GetLength() + 1 + calculate_bytes_for_uint(point.relative_position);
@@ -280,20 +269,14 @@ cues_c::adjust_positions(uint64_t old_position,
                          uint64_t delta) {
   auto s_debug_rerender_track_headers = debugging_option_c{"rerender|rerender_track_headers"};
 
-  if (!delta || (m_points.empty() && m_codec_state_position_map.empty()))
+  if (!delta || m_store.empty())
     return;
 
   mxdebug_if(s_debug_rerender_track_headers,
-             fmt::format("[rerender] cues_c::adjust_positions: old_position {0} delta {1} num_points {2} first point's position {3}\n",
-                         old_position, delta, m_points.size(), !m_points.empty() ? m_points[0].cluster_position : 0));
-
-  for (auto &point : m_points)
-    if (point.cluster_position >= old_position)
-      point.cluster_position += delta;
+             fmt::format("[rerender] cues_c::adjust_positions: old_position {0} delta {1} num_points {2}\n",
+                         old_position, delta, m_store.size()));
 
-  for (auto &element : m_codec_state_position_map)
-    if (element.second >= old_position)
-      element.second += delta;
+  m_store.adjust_positions(old_position, delta);
 }
 
 cues_c &
@@ -19,21 +19,17 @@
 #include <matroska/KaxCuesData.h>
 #include <matroska/KaxSeekHead.h>
 
-using id_timestamp_t = std::pair<uint64_t, uint64_t>;
+#include "merge/cue_store.h"
 
-struct cue_point_t {
-  uint64_t timestamp, duration, cluster_position;
-  uint32_t track_num, relative_position;
-};
+using id_timestamp_t = std::pair<uint64_t, uint64_t>;
 
 class cues_c;
 using cues_cptr = std::shared_ptr<cues_c>;
 
 class cues_c {
 protected:
-  std::vector<cue_point_t> m_points;
+  cue_store_c m_store;
   std::multimap<id_timestamp_t, uint64_t> m_id_timestamp_duration_multimap;
-  std::map<id_timestamp_t, uint64_t> m_codec_state_position_map;
 
   size_t m_num_cue_points_postprocessed;
   bool m_no_cue_duration, m_no_cue_relative_position;
@@ -56,9 +52,8 @@ public:
   static cues_c &get();
 
 protected:
-  void sort();
   std::multimap<id_timestamp_t, uint64_t> calculate_block_positions(libmatroska::KaxCluster &cluster) const;
-  uint64_t calculate_total_size() const;
+  void set_durations_and_relative_positions(libmatroska::KaxCluster &cluster);
   uint64_t calculate_point_size(cue_point_t const &point) const;
   uint64_t calculate_bytes_for_uint(uint64_t value) const;
 };
@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>
 #include <unordered_map>
 
 #include <matroska/KaxTracks.h>
@@ -26,6 +27,7 @@
 #include "common/hacks.h"
 #include "common/option_with_source.h"
 #include "common/strings/formatting.h"
+#include "common/thread_pool.h"
 #include "common/unique_numbers.h"
 #include "common/xml/ebml_tags_converter.h"
 #include "merge/cluster_helper.h"
@@ -58,6 +60,7 @@ debugging_option_c s_debug{"generic_packetizer"};
 }
 
 static std::unordered_map<std::string, bool> s_experimental_status_warning_shown;
+static std::mutex s_experimental_status_warning_mutex;
 std::vector<generic_packetizer_c *> ptzrs_in_header_order;
 
 int generic_packetizer_c::ms_track_number = 0;
@@ -167,6 +170,11 @@ generic_packetizer_c::generic_packetizer_c(generic_reader_c *reader,
   else if (mtx::includes(m_ti.m_compression_list, -1))
     m_ti.m_compression = m_ti.m_compression_list[-1];
 
+  if (mtx::includes(m_ti.m_compression_parameters_list, m_ti.m_id))
+    m_ti.m_compression_parameters = m_ti.m_compression_parameters_list[m_ti.m_id];
+  else if (mtx::includes(m_ti.m_compression_parameters_list, -1))
+    m_ti.m_compression_parameters = m_ti.m_compression_parameters_list[-1];
+
   // Let's see if the user has specified a name for this track.
   if (mtx::includes(m_ti.m_track_names, m_ti.m_id))
     m_ti.m_track_name = m_ti.m_track_names[m_ti.m_id];
@@ -1351,6 +1359,7 @@ generic_packetizer_c::set_headers() {
     get_child<libmatroska::KaxContentEncodingScope>(c_encoding).SetValue(1); // Only the frame contents have been compresed.
 
     m_compressor = compressor_c::create(m_hcompression);
+    m_compressor->set_parameters(m_ti.m_compression_parameters);
     m_compressor->set_track_headers(c_encoding);
   }
 
@@ -1404,20 +1413,57 @@ generic_packetizer_c::fix_headers() {
 }
 
 void
-generic_packetizer_c::compress_packet(packet_t &packet) {
+generic_packetizer_c::compress_packet(packet_cptr const &packet) {
   if (!m_compressor) {
     return;
   }
 
+  auto compress = [](compressor_c &compressor, packet_t &packet_to_compress) {
+    packet_to_compress.data = compressor.compress(packet_to_compress.data);
+    for (auto &data_add : packet_to_compress.data_adds)
+      data_add.data = compressor.compress(data_add.data);
+  };
+
+  // Compressors that can be used on several threads at the same time
+  // compress queued packets on the shared pool. get_packet() waits for
+  // each packet's result, keeping the order of the packets intact.
+  auto pool = m_compressor->is_thread_safe() ? compressor_c::get_thread_pool() : nullptr;
+
+  if (pool) {
+    // The task must not hold a reference to the packet: the packet
+    // owns the task's shared state, and that cycle would only be
+    // broken by wait_for_compression().
+    packet->pending_compression = pool->submit([compressor = m_compressor, packet_to_compress = packet.get(), compress]() { compress(*compressor, *packet_to_compress); }).share();
+    return;
+  }
+
+  try {
+    compress(*m_compressor, *packet);
+
+  } catch (mtx::compression_x &e) {
+    mxerror_tid(m_ti.m_fname, m_ti.m_id, fmt::format(FY("Compression failed: {0}\n"), e.error()));
+  }
+
+  if (!m_compressor->track_headers_changed())
+    return;
+
+  m_compressor->set_track_headers(get_child<libmatroska::KaxContentEncoding>(get_child<libmatroska::KaxContentEncodings>(m_track_entry)));
+  rerender_track_headers();
+}
+
+void
+generic_packetizer_c::wait_for_compression(packet_t &packet) {
+  if (!packet.pending_compression.valid())
+    return;
+
   try {
-    packet.data = m_compressor->compress(packet.data);
-    size_t i;
-    for (i = 0; packet.data_adds.size() > i; ++i)
-      packet.data_adds[i].data = m_compressor->compress(packet.data_adds[i].data);
+    packet.pending_compression.get();
 
   } catch (mtx::compression_x &e) {
     mxerror_tid(m_ti.m_fname, m_ti.m_id, fmt::format(FY("Compression failed: {0}\n"), e.error()));
   }
+
+  packet.pending_compression = {};
 }
 
 void
@@ -1428,6 +1474,11 @@ generic_packetizer_c::account_enqueued_bytes(packet_t &packet,
 
 void
 generic_packetizer_c::add_packet(packet_cptr const &pack) {
+  mtx::timing_statistics::timer_c timer{get_timing_stage(m_add_packet_timing_stage, "packetizer_add_packet")};
+
+  timer.add_packets(1);
+  timer.add_bytes(pack->data->get_size());
+
   mxdebug_if(s_debug, fmt::format("add_packet() track {0} timestamp {1} m_connected_to {2}\n", get_source_track_num(), mtx::string::format_timestamp(pack->timestamp), m_connected_to));
 
   if (m_htrack_type == track_subtitle)
@@ -1534,7 +1585,7 @@ generic_packetizer_c::add_packet2(packet_cptr const &pack) {
 
   after_packet_timestamped(*pack);
 
-  compress_packet(*pack);
+  compress_packet(pack);
 }
 
 void
@@ -1552,6 +1603,8 @@ generic_packetizer_c::get_packet() {
   packet_cptr pack = m_packet_queue.front();
   m_packet_queue.pop_front();
 
+  wait_for_compression(*pack);
+
   pack->output_order_timestamp = timestamp_c::ns(pack->assigned_timestamp - std::max(m_codec_delay.to_ns(0), m_seek_pre_roll.to_ns(0)));
 
   account_enqueued_bytes(*pack, -1);
@@ -1636,7 +1689,7 @@ generic_packetizer_c::apply_factory_short_queueing(packet_cptr_di &p_start) {
 
 struct packet_sorter_t {
   int m_index;
-  static std::deque<packet_cptr> *m_packet_queue;
+  static thread_local std::deque<packet_cptr> *m_packet_queue;
 
   packet_sorter_t(int index)
     : m_index(index)
@@ -1648,7 +1701,7 @@ struct packet_sorter_t {
   }
 };
 
-std::deque<packet_cptr> *packet_sorter_t::m_packet_queue = nullptr;
+thread_local std::deque<packet_cptr> *packet_sorter_t::m_packet_queue = nullptr;
 
 void
 generic_packetizer_c::apply_factory_full_queueing(packet_cptr_di &p_start) {
@@ -1729,7 +1782,9 @@ generic_packetizer_c::connect(generic_packetizer_c *src,
   m_htrack_default_duration     = src->m_htrack_default_duration;
   m_huid                        = src->m_huid;
   m_hcompression                = src->m_hcompression;
-  m_compressor                  = compressor_c::create(m_hcompression);
+  // A zstd dictionary stored in the track headers must be used for
+  // the appended frames, too.
+  m_compressor                  = (COMPRESSION_ZSTD == m_hcompression) && src->m_compressor ? src->m_compressor : compressor_c::create(m_hcompression);
   m_last_cue_timestamp          = src->m_last_cue_timestamp;
   m_timestamp_factory           = src->m_timestamp_factory;
   m_correction_timestamp_offset = 0;
@@ -1795,10 +1850,16 @@ generic_packetizer_c::wants_cue_duration()
 void
 generic_packetizer_c::show_experimental_status_version(std::string const &codec_id) {
   auto idx = get_format_name().get_untranslated();
-  if (s_experimental_status_warning_shown[idx])
-    return;
 
-  s_experimental_status_warning_shown[idx] = true;
+  {
+    std::lock_guard<std::mutex> lock{s_experimental_status_warning_mutex};
+
+    if (s_experimental_status_warning_shown[idx])
+      return;
+
+    s_experimental_status_warning_shown[idx] = true;
+  }
+
   mxwarn(fmt::format(FY("Note that the Matroska specifications regarding the storage of '{0}' have not been finalized yet. "
                        "mkvmerge's support for it is therefore subject to change and uses the CodecID '{1}/EXPERIMENTAL' instead of '{1}'. "
                        "This warning will be removed once the specifications have been finalized and mkvmerge has been updated accordingly.\n"),
@@ -1812,9 +1873,24 @@ generic_packetizer_c::read(bool force) {
 
 void
 generic_packetizer_c::process(packet_cptr const &packet) {
+  mtx::timing_statistics::timer_c timer{get_timing_stage(m_process_timing_stage, "packetizer_process")};
+
+  timer.add_packets(1);
+  if (packet->data)
+    timer.add_bytes(packet->data->get_size());
+
   process_impl(packet);
 }
 
+mtx::timing_statistics::stage_c *
+generic_packetizer_c::get_timing_stage(mtx::timing_statistics::stage_cptr &stage,
+                                       char const *type) {
+  if (!stage && mtx::timing_statistics::is_enabled())
+    stage = mtx::timing_statistics::create_stage(type, m_ti.m_fname, get_format_name().get_untranslated(), m_hcodec_id, m_ti.m_id);
+
+  return stage.get();
+}
+
 void
 generic_packetizer_c::prevent_lacing() {
   m_prevent_lacing = true;
@@ -24,6 +24,7 @@
 #include "merge/file_status.h"
 #include "merge/packet.h"
 #include "merge/timestamp_factory.h"
+#include "merge/timing_statistics.h"
 #include "merge/track_info.h"
 #include "merge/webm.h"
 
@@ -102,6 +103,8 @@ protected:
 
   std::string m_source_id;
 
+  mtx::timing_statistics::stage_cptr m_process_timing_stage, m_add_packet_timing_stage;
+
 protected:                      // static
   static int ms_track_number;
 
@@ -309,10 +312,13 @@ protected:
 
   virtual void show_experimental_status_version(std::string const &codec_id);
 
-  virtual void compress_packet(packet_t &packet);
+  virtual void compress_packet(packet_cptr const &packet);
+  virtual void wait_for_compression(packet_t &packet);
   virtual void account_enqueued_bytes(packet_t &packet, int64_t factor);
 
   virtual void apply_block_addition_mappings();
+
+  mtx::timing_statistics::stage_c *get_timing_stage(mtx::timing_statistics::stage_cptr &stage, char const *type);
 };
 
 extern std::vector<generic_packetizer_c *> ptzrs_in_header_order;
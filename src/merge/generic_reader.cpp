@@ -68,11 +68,17 @@ generic_reader_c::read_all() {
 file_status_e
 generic_reader_c::read_next(generic_packetizer_c *packetizer,
                             bool force) {
+  if (!m_read_timing_stage && mtx::timing_statistics::is_enabled())
+    m_read_timing_stage = mtx::timing_statistics::create_stage("reader_read", m_ti.m_fname, get_format_name().get_untranslated());
+
+  mtx::timing_statistics::timer_c timer{m_read_timing_stage.get()};
+
   auto prior_progrss = get_progress();
   auto result        = read(packetizer, force);
   auto new_progress  = get_progress();
 
   add_to_progress(new_progress - prior_progrss);
+  timer.add_bytes(std::max<int64_t>(new_progress - prior_progrss, 0));
 
   return result;
 }
@@ -26,6 +26,7 @@
 #include "merge/packet.h"
 #include "merge/probe_range_info.h"
 #include "merge/timestamp_factory.h"
+#include "merge/timing_statistics.h"
 #include "merge/track_info.h"
 #include "merge/webm.h"
 
@@ -60,6 +61,8 @@ protected:
 
   timestamp_c m_restricted_timestamps_min, m_restricted_timestamps_max;
 
+  mtx::timing_statistics::stage_cptr m_read_timing_stage;
+
 public:
   virtual ~generic_reader_c() = default;
 
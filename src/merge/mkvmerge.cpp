@@ -48,17 +48,22 @@
 #include "common/file_types.h"
 #include "common/fs_sys_helpers.h"
 #include "common/iso639.h"
+#include "common/json.h"
 #include "common/kax_analyzer.h"
 #include "common/list_utils.h"
+#include "common/memory_pool.h"
 #include "common/mime.h"
 #include "common/mm_file_io.h"
 #include "common/mm_mpls_multi_file_io.h"
+#include "common/mm_stdio.h"
 #include "common/qt.h"
 #include "common/random.h"
 #include "common/segmentinfo.h"
 #include "common/split_arg_parsing.h"
+#include "common/strings/editing.h"
 #include "common/strings/formatting.h"
 #include "common/strings/parsing.h"
+#include "common/thread_pool.h"
 #include "common/unique_numbers.h"
 #include "common/version.h"
 #include "common/webm.h"
@@ -69,6 +74,7 @@
 #include "merge/generic_reader.h"
 #include "merge/output_control.h"
 #include "merge/reader_detection_and_creation.h"
+#include "merge/timing_statistics.h"
 #include "merge/track_info.h"
 
 static std::string s_split_by_chapters_arg;
@@ -147,6 +153,13 @@ set_usage() {
                   "                           form or not at all (default: canonical form).\n");
   usage_text += Y("  --stop-after-video-ends  Stops processing after the primary video track ends,\n"
                   "                           discarding any remaining packets of other tracks.\n");
+  usage_text += Y("  --parallel-reading       Read from several source files at the same time\n"
+                  "                           using multiple threads.\n");
+  usage_text += Y("  --memory-mapped-reading  Read source files via memory-mapped I/O.\n");
+  usage_text += Y("  --timing-statistics <file>\n"
+                  "                           Measure the time spent reading, packetizing,\n"
+                  "                           rendering and writing, and write a summary in\n"
+                  "                           JSON format to <file>.\n");
   usage_text +=   "\n";
   usage_text += Y(" File splitting, linking, appending and concatenating (more global options):\n");
   usage_text += Y("  --split <d[K,M,G]|HH:MM:SS|s>\n"
@@ -377,12 +390,20 @@ set_usage() {
   usage_text += Y(" Options that only apply to VobSub subtitle tracks:\n");
   usage_text += Y("  --compression <TID:method>\n"
                   "                           Sets the compression method used for the\n"
-                  "                           specified track ('none' or 'zlib').\n");
+                  "                           specified track ('none', 'zlib' or\n"
+                  "                           'zstd[:level][:dict]').\n");
   usage_text +=   "\n\n";
   usage_text += Y(" Other options:\n");
   usage_text += Y("  -i, --identify <file>    Print information about the source file.\n");
   usage_text += Y("  -J <file>                This is a convenient alias for\n"
                   "                           \"--identification-format json --identify file\".\n");
+  usage_text += Y("  --identify-batch <file1> [<file2> ...]\n"
+                  "                           Identifies several files in parallel and outputs\n"
+                  "                           one line of JSON per file. '-' reads file names\n"
+                  "                           from the standard input.\n");
+  usage_text += Y("  --identification-threads <n>\n"
+                  "                           Number of files identified in parallel by\n"
+                  "                           --identify-batch (default: number of CPUs).\n");
   usage_text += Y("  -F, --identification-format <format>\n"
                   "                           Set the identification results format\n"
                   "                           ('text' or 'json'; default is 'text').\n");
@@ -520,26 +541,22 @@ display_unsupported_file_type(filelist_t const &file) {
 
 /** \brief Identify a file type and its contents
 
-   This function called for \c --identify. It sets up dummy track info
-   data for the reader, probes the input file, creates the file reader
-   and calls its identify function.
+   Sets up dummy track info data for the reader, probes the input
+   file, creates the file reader and calls its identify function. The
+   file is not added to the global list of files.
 */
 static void
-identify(std::string &filename) {
-  g_files.emplace_back(new filelist_t);
-  auto &file = *g_files.back();
-  file.ti    = std::make_unique<track_info_c>();
+identify_file(filelist_t &file,
+              std::string filename) {
+  file.ti = std::make_unique<track_info_c>();
 
   if ('=' == filename[0]) {
     file.ti->m_disable_multi_file = true;
     filename                      = filename.substr(1);
   }
 
-  verbose             = 0;
-  g_suppress_warnings = true;
-  g_identifying       = true;
-  file.ti->m_fname    = filename;
-  file.name           = filename;
+  file.ti->m_fname = filename;
+  file.name        = filename;
   file.all_names.push_back(filename);
 
   file.reader = probe_file_format(file);
@@ -547,10 +564,24 @@ identify(std::string &filename) {
   if (!file.reader)
     display_unsupported_file_type(file);
 
-  read_file_headers();
+  read_file_headers(file);
 
   file.reader->identify();
   file.reader->display_identification_results();
+}
+
+/** \brief Identify a single file
+
+   This function called for \c --identify.
+*/
+static void
+identify(std::string const &filename) {
+  verbose             = 0;
+  g_suppress_warnings = true;
+  g_identifying       = true;
+
+  g_files.emplace_back(new filelist_t);
+  identify_file(*g_files.back(), filename);
 
   g_files.clear();
 }
@@ -1351,6 +1382,8 @@ parse_arg_cues(const std::string &s,
 /** \brief Parse the \c --compression argument
 
    The argument must have the form \c TID:compression, e.g. \c 0:zlib.
+   zstd optionally takes the compression level and the keyword
+   \c dict for training a dictionary, e.g. \c 0:zstd:19:dict.
 */
 static void
 parse_arg_compression(const std::string &s,
@@ -1371,15 +1404,27 @@ parse_arg_compression(const std::string &s,
   std::vector<std::string> available_compression_methods;
   available_compression_methods.push_back("none");
   available_compression_methods.push_back("zlib");
+#if defined(HAVE_ZSTD)
+  available_compression_methods.push_back("zstd");
+#endif
   available_compression_methods.push_back("mpeg4_p2");
   available_compression_methods.push_back("analyze_header_removal");
 
   ti.m_compression_list[id] = COMPRESSION_UNSPECIFIED;
   balg::to_lower(parts[1]);
 
+  auto parameters = mtx::string::split(parts[1], ":");
+  parts[1]        = parameters[0];
+  parameters.erase(parameters.begin());
+
   if (parts[1] == "zlib")
     ti.m_compression_list[id] = COMPRESSION_ZLIB;
 
+#if defined(HAVE_ZSTD)
+  if (parts[1] == "zstd")
+    ti.m_compression_list[id] = COMPRESSION_ZSTD;
+#endif
+
   if (parts[1] == "none")
     ti.m_compression_list[id] = COMPRESSION_NONE;
 
@@ -1391,6 +1436,28 @@ parse_arg_compression(const std::string &s,
 
   if (ti.m_compression_list[id] == COMPRESSION_UNSPECIFIED)
     mxerror(fmt::format(FY("'{0}' is an unsupported argument for --compression. Available compression methods are: {1}\n"), s, mtx::string::join(available_compression_methods, ", ")));
+
+  if (!parameters.empty() && (ti.m_compression_list[id] != COMPRESSION_ZSTD))
+    mxerror(fmt::format(FY("Invalid compression option specified in '--compression {0}'.\n"), s));
+
+#if defined(HAVE_ZSTD)
+  compression_parameters_t compression_parameters;
+
+  for (auto const &parameter : parameters) {
+    int level{};
+
+    if (parameter == "dict")
+      compression_parameters.train_dictionary = true;
+
+    else if (mtx::string::parse_number(parameter, level) && (level >= ZSTD_minCLevel()) && (level <= ZSTD_maxCLevel()))
+      compression_parameters.level = level;
+
+    else
+      mxerror(fmt::format(FY("Invalid compression option specified in '--compression {0}'.\n"), s));
+  }
+
+  ti.m_compression_parameters_list[id] = compression_parameters;
+#endif
 }
 
 static std::tuple<int64_t, std::string>
@@ -2122,6 +2189,138 @@ parse_normalize_language_ietf(std::optional<std::string> const &next_arg) {
   mtx::bcp47::language_c::set_normalization_mode(mode);
 }
 
+/** \brief Identify one file in batch mode
+
+   Runs in one of the worker threads. The JSON output as well as all
+   warnings and errors are captured and printed as a single line once
+   the file has been handled. Returns the exit code the identification
+   of this file alone would have resulted in.
+*/
+static int
+identify_in_batch(std::string const &filename) {
+  static std::mutex s_output_mutex;
+
+  json_output_capture_c capture;
+  auto exit_code = 0;
+
+  try {
+    try {
+      filelist_t file;
+      identify_file(file, filename);
+
+    } catch (mtx::exit_requested_x &) {
+      throw;
+
+    } catch (std::exception &ex) {
+      mxerror(fmt::format(FY("The file '{0}' could not be identified: {1}\n"), filename, ex.what()));
+
+    } catch (...) {
+      mxerror(fmt::format(FY("The file '{0}' could not be identified.\n"), filename));
+    }
+
+  } catch (mtx::exit_requested_x &ex) {
+    exit_code = ex.code();
+  }
+
+  // The lines are output in the order the files are finished in. Each
+  // one must therefore name its file, even if identifying it failed.
+  auto output = capture.get_output({
+    { "identification_format_version", ID_JSON_FORMAT_VERSION },
+    { "file_name",                     filename               },
+  });
+
+  // mtx::json::dump() changes the process-wide locale temporarily.
+  std::lock_guard<std::mutex> lock{s_output_mutex};
+  mxinfo(fmt::format("{0}\n", mtx::json::dump(output, -1)));
+
+  return exit_code;
+}
+
+static std::vector<std::string>
+read_file_names_from_stdin() {
+  std::string content;
+  mm_stdio_c in;
+  auto buffer = memory_c::alloc(64 * 1024);
+
+  while (true) {
+    auto num_read = in.read(buffer->get_buffer(), buffer->get_size());
+    if (!num_read)
+      break;
+    content.append(reinterpret_cast<char const *>(buffer->get_buffer()), num_read);
+  }
+
+  std::vector<std::string> file_names;
+
+  for (auto &line : mtx::string::split(content, "\n")) {
+    mtx::string::strip_back(line, true);
+    if (!line.empty())
+      file_names.emplace_back(line);
+  }
+
+  return file_names;
+}
+
+/** \brief Identify several files in parallel
+
+   This function called for \c --identify-batch. Each file is handled
+   by a worker thread. The results are output in JSON, one line per
+   file, in the order in which the files are finished.
+*/
+static void
+identify_batch(std::vector<std::string> const &args) {
+  std::vector<std::string> file_names;
+  std::size_t num_threads = 0;
+
+  for (auto sit = args.cbegin(), sit_end = args.cend(); sit != sit_end; sit++) {
+    auto const &this_arg = *sit;
+
+    if (this_arg == "--identify-batch")
+      continue;
+
+    if (mtx::included_in(this_arg, "-F", "--identification-format")) {
+      if (((sit + 1) != sit_end) && !balg::iequals(*(sit + 1), "json"))
+        mxerror(fmt::format(FY("Only the JSON identification format is supported with '{0}'.\n"), "--identify-batch"));
+      parse_arg_identification_format(sit, sit_end);
+
+    } else if (this_arg == "--identification-threads") {
+      if ((sit + 1) == sit_end)
+        mxerror(fmt::format(FY("'{0}' lacks its argument.\n"), this_arg));
+
+      ++sit;
+      if (!mtx::string::parse_number(*sit, num_threads) || !num_threads)
+        mxerror(fmt::format(FY("Invalid number of threads in '{0} {1}'.\n"), this_arg, *sit));
+
+    } else if (this_arg == "-") {
+      auto names_from_stdin = read_file_names_from_stdin();
+      std::copy(names_from_stdin.begin(), names_from_stdin.end(), std::back_inserter(file_names));
+
+    } else if ((this_arg.size() > 1) && (this_arg[0] == '-'))
+      mxerror(fmt::format(FY("The argument '{0}' is not allowed in identification mode.\n"), this_arg));
+
+    else
+      file_names.emplace_back(this_arg);
+  }
+
+  g_identification_output_format = identification_output_format_e::json;
+  redirect_warnings_and_errors_to_json();
+
+  verbose             = 0;
+  g_suppress_warnings = true;
+  g_identifying       = true;
+
+  mtx::thread_pool_c pool{num_threads};
+  std::vector<std::future<int>> results;
+
+  for (auto const &file_name : file_names)
+    results.emplace_back(pool.submit([file_name]() { return identify_in_batch(file_name); }));
+
+  auto exit_code = 0;
+  for (auto &result : results)
+    exit_code = std::max(exit_code, result.get());
+
+  mxexit(exit_code);
+}
+
 static void
 handle_identification_args(std::vector<std::string> &args) {
   auto identification_command = std::optional<std::string>{};
@@ -2147,6 +2346,9 @@ handle_identification_args(std::vector<std::string> &args) {
       ++this_arg_itr;
   }
 
+  if (std::find(args.begin(), args.end(), "--identify-batch") != args.end())
+    identify_batch(args);
+
   for (auto const &this_arg : args) {
     if (!mtx::included_in(this_arg, "-i", "--identify", "-J"))
       continue;
@@ -2402,7 +2604,20 @@ parse_args(std::vector<std::string> args) {
     else if (this_arg == "--stop-after-video-ends")
       g_stop_after_video_ends = true;
 
-    else if (this_arg == "--attachment-description") {
+    else if (this_arg == "--parallel-reading")
+      g_parallel_reading = true;
+
+    else if (this_arg == "--memory-mapped-reading")
+      g_memory_mapped_reading = true;
+
+    else if (this_arg == "--timing-statistics") {
+      if (!next_arg)
+        mxerror(fmt::format(FY("'{0}' lacks the file name.\n"), this_arg));
+
+      mtx::timing_statistics::enable(*next_arg);
+      sit++;
+
+    } else if (this_arg == "--attachment-description") {
       if (!next_arg)
         mxerror(Y("'--attachment-description' lacks the description.\n"));
 
@@ -3219,6 +3434,9 @@ main(int argc,
 
   check_for_unused_chapter_numbers_while_spliting_by_chapters();
 
+  mtx::mem::pool_c::get().dump_statistics();
+  mtx::timing_statistics::write_summary();
+
   mxinfo(fmt::format(FY("Multiplexing took {0}.\n"), mtx::string::create_minutes_seconds_time_string((mtx::sys::get_current_time_millis() - start + 500) / 1000, true)));
 
   cleanup();
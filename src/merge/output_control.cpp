@@ -15,12 +15,17 @@
 
 #include "common/common_pch.h"
 
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <mutex>
+#include <queue>
+#include <set>
 #if defined(SYS_UNIX) || defined(SYS_APPLE)
 # include <signal.h>
 #endif
 #include <typeinfo>
+#include <unordered_map>
 
 #include <QDateTime>
 #include <QRegularExpression>
@@ -55,6 +60,7 @@
 #include "common/fs_sys_helpers.h"
 #include "common/hacks.h"
 #include "common/list_utils.h"
+#include "common/mm_file_io.h"
 #include "common/mm_io_x.h"
 #include "common/mm_null_io.h"
 #include "common/mm_proxy_io.h"
@@ -63,6 +69,7 @@
 #include "common/qt.h"
 #include "common/strings/formatting.h"
 #include "common/tags/tags.h"
+#include "common/thread_pool.h"
 #include "common/translation.h"
 #include "common/unique_numbers.h"
 #include "common/version.h"
@@ -72,6 +79,7 @@
 #include "merge/generic_packetizer.h"
 #include "merge/generic_reader.h"
 #include "merge/output_control.h"
+#include "merge/timing_statistics.h"
 #include "merge/webm.h"
 
 using namespace mtx::construct;
@@ -111,6 +119,8 @@ bool g_use_durations                                          = false;
 bool g_no_track_statistics_tags                               = false;
 bool g_write_date                                             = true;
 bool g_stop_after_video_ends                                  = false;
+bool g_parallel_reading                                       = false;
+bool g_memory_mapped_reading                                  = false;
 
 double g_timestamp_scale                                      = TIMESTAMP_SCALE;
 timestamp_scale_mode_e g_timestamp_scale_mode                 = timestamp_scale_mode_e{TIMESTAMP_SCALE_MODE_NORMAL};
@@ -153,6 +163,48 @@ bool s_appending_files                      = false;
 auto s_debug_appending                      = debugging_option_c{"append|appending"};
 auto s_debug_rerender_track_headers         = debugging_option_c{"rerender|rerender_track_headers"};
 auto s_debug_splitting_chapters             = debugging_option_c{"splitting_chapters"};
+auto s_debug_parallel_reading               = debugging_option_c{"parallel_reading"};
+
+static std::unique_ptr<mtx::thread_pool_c> s_reader_thread_pool;
+static std::atomic<bool> s_pulling_in_parallel{};
+
+// Track header re-renderings requested by packetizers while they're
+// pulled in parallel. They're replayed in the order in which they
+// would have happened during sequential reading.
+struct deferred_track_headers_rerendering_t {
+  std::size_t ptzr_idx{}, sequence_number{};
+  std::vector<std::pair<libmatroska::KaxTrackEntry *, uint64_t>> entry_sizes_before, entry_sizes;
+};
+
+static std::mutex s_deferred_track_headers_rerenderings_mutex;
+static std::vector<deferred_track_headers_rerendering_t> s_deferred_track_headers_rerenderings;
+
+// The group of packetizers pulled on the current worker thread, the
+// packetizer currently being pulled & the number of re-renderings the
+// group has requested so far.
+static thread_local std::vector<packetizer_t *> const *s_group_being_pulled{};
+static thread_local packetizer_t const *s_packetizer_being_pulled{};
+static thread_local std::size_t s_num_rerenderings_requested_by_group{};
+
+// Bookkeeping for only touching those packetizers in the main loop
+// that actually need it. Entries are indexes into g_packetizers.
+struct packetizer_with_packet_t {
+  timestamp_c m_timestamp;
+  std::size_t m_idx;
+  packet_t *m_packet;
+
+  // Reversed for std::priority_queue: the lowest timestamp wins, and
+  // for equal timestamps the packetizer added first wins.
+  bool operator <(packetizer_with_packet_t const &other) const {
+    return (other.m_timestamp < m_timestamp)
+        || (!(m_timestamp < other.m_timestamp) && (other.m_idx < m_idx));
+  }
+};
+
+static bool s_packetizer_schedule_valid{};
+static std::set<std::size_t> s_packetizers_to_pull;
+static std::priority_queue<packetizer_with_packet_t> s_packetizers_with_packets;
+static std::unordered_map<generic_reader_c *, std::set<std::size_t>> s_dry_packetizers_by_reader;
 
 mtx::bcp47::language_c g_default_language;
 
@@ -429,6 +481,8 @@ add_packetizer_globally(generic_packetizer_c *packetizer) {
     mxerror(fmt::format(FY("filelist_t not found for generic_packetizer_c. {0}\n"), BUGMSG));
 
   g_packetizers.push_back(pack);
+
+  s_packetizer_schedule_valid = false;
 }
 
 void
@@ -872,6 +926,59 @@ shrink_void_and_rerender_track_headers(int64_t new_void_size) {
                          projected_new_void_pos));
 }
 
+/** \brief Makes sure that the track headers ending at the given position fit
+
+   Moves all data written after the track headers further back if
+   necessary. Returns the size of the void element to render after the
+   track headers; \c data_start_pos is updated to the new position of
+   the data.
+*/
+static int64_t
+make_room_for_track_headers(uint64_t new_tracks_end_pos,
+                            uint64_t &data_start_pos,
+                            bool have_data) {
+  int64_t new_void_size = data_start_pos >= (new_tracks_end_pos + 4) ? data_start_pos - new_tracks_end_pos : 1024;
+
+  if (have_data && (new_tracks_end_pos >= (data_start_pos - 3))) {
+    auto delta      = 1024 + new_tracks_end_pos - data_start_pos;
+    data_start_pos += delta;
+    new_void_size   = 1024;
+
+    relocate_written_data(data_start_pos - delta, delta);
+  }
+
+  return new_void_size;
+}
+
+/** \brief Records a request for re-rendering the track headers
+
+   Called on the worker threads pulling packetizers in parallel. Only
+   the sizes of the track entries of the group being pulled on this
+   thread are recorded; all other entries aren't touched by it.
+*/
+static void
+defer_track_headers_rerendering() {
+  deferred_track_headers_rerendering_t request;
+
+  request.ptzr_idx        = s_packetizer_being_pulled - g_packetizers.data();
+  request.sequence_number = s_num_rerenderings_requested_by_group++;
+
+  for (auto ptzr : *s_group_being_pulled) {
+    auto entry = ptzr->packetizer->get_track_entry();
+
+    // Up to now the entries' cached sizes are still the ones from the
+    // last time the track headers were rendered.
+    if (!request.sequence_number)
+      request.entry_sizes_before.emplace_back(entry, entry->ElementSize());
+
+    entry->UpdateSize(render_should_write_arg(false));
+    request.entry_sizes.emplace_back(entry, entry->ElementSize());
+  }
+
+  std::lock_guard<std::mutex> lock{s_deferred_track_headers_rerenderings_mutex};
+  s_deferred_track_headers_rerenderings.emplace_back(std::move(request));
+}
+
 /** \brief Overwrites the track headers with current values
 
    Can be used by packetizers that have to modify their headers
@@ -879,6 +986,13 @@ shrink_void_and_rerender_track_headers(int64_t new_void_size) {
 */
 void
 rerender_track_headers() {
+  // Packetizers being pulled on worker threads must not touch the
+  // output file. The request is replayed once all of them are done.
+  if (s_pulling_in_parallel) {
+    defer_track_headers_rerendering();
+    return;
+  }
+
   g_kax_tracks->UpdateSize(render_should_write_arg(false));
 
   auto position_before    = s_out->getFilePointer();
@@ -886,19 +1000,12 @@ rerender_track_headers() {
   auto new_tracks_end_pos = g_kax_tracks->GetElementPosition() + g_kax_tracks->ElementSize();
   auto data_start_pos     = s_void_after_track_headers->GetElementPosition() + s_void_after_track_headers->ElementSize(render_should_write_arg(true));
   auto data_size          = file_size_before - data_start_pos;
-  auto new_void_size      = data_start_pos >= (new_tracks_end_pos + 4) ? data_start_pos - new_tracks_end_pos : 1024;
 
   mxdebug_if(s_debug_rerender_track_headers,
-             fmt::format("[rerender] track_headers: new_tracks_end_pos {0} data_start_pos {1} data_size {2} old void at {3} size {4} new_void_size {5}\n",
-                         new_tracks_end_pos, data_start_pos, data_size, s_void_after_track_headers->GetElementPosition(), s_void_after_track_headers->ElementSize(render_should_write_arg(true)), new_void_size));
-
-  if (data_size  && (new_tracks_end_pos >= (data_start_pos - 3))) {
-    auto delta      = 1024 + new_tracks_end_pos - data_start_pos;
-    data_start_pos += delta;
-    new_void_size   = 1024;
+             fmt::format("[rerender] track_headers: new_tracks_end_pos {0} data_start_pos {1} data_size {2} old void at {3} size {4}\n",
+                         new_tracks_end_pos, data_start_pos, data_size, s_void_after_track_headers->GetElementPosition(), s_void_after_track_headers->ElementSize(render_should_write_arg(true))));
 
-    relocate_written_data(data_start_pos - delta, delta);
-  }
+  auto new_void_size = make_room_for_track_headers(new_tracks_end_pos, data_start_pos, 0 != data_size);
 
   shrink_void_and_rerender_track_headers(new_void_size);
 
@@ -908,6 +1015,71 @@ rerender_track_headers() {
                          s_void_after_track_headers->GetElementPosition(), s_void_after_track_headers->ElementSize(render_should_write_arg(true))));
 }
 
+/** \brief Replays the re-renderings requested while pulling in parallel
+
+   Sequential reading would have re-rendered the track headers once
+   for each request, each time with the entries' sizes at that point,
+   and might have moved the data following them several times. Only
+   the sizes matter for where the data ends up as each re-rendering
+   overwrites the previous one completely. Therefore the requests are
+   processed in the order of the packetizers being pulled, the track
+   headers' size is determined from the recorded entry sizes, and the
+   data is moved exactly as it would have been. The current track
+   headers are rendered only once at the end.
+*/
+static void
+replay_deferred_track_headers_rerenderings() {
+  auto requests = std::move(s_deferred_track_headers_rerenderings);
+  s_deferred_track_headers_rerenderings.clear();
+
+  if (requests.empty())
+    return;
+
+  std::sort(requests.begin(), requests.end(), [](auto const &a, auto const &b) {
+    return std::make_pair(a.ptzr_idx, a.sequence_number) < std::make_pair(b.ptzr_idx, b.sequence_number);
+  });
+
+  g_kax_tracks->UpdateSize(render_should_write_arg(false));
+
+  // Differences between the entries' sizes at the point of the
+  // request being replayed and their current sizes.
+  std::unordered_map<libmatroska::KaxTrackEntry *, int64_t> size_differences;
+
+  for (auto const &request : requests)
+    for (auto const &[entry, size] : request.entry_sizes_before)
+      size_differences[entry] = static_cast<int64_t>(size) - static_cast<int64_t>(entry->ElementSize());
+
+  auto tracks_end_pos = [](int64_t data_size) -> uint64_t {
+    return g_kax_tracks->GetElementPosition() + static_cast<libebml::EbmlId const &>(*g_kax_tracks).GetLength() + libebml::CodedSizeLength(data_size, g_kax_tracks->GetSizeLength(), true) + data_size;
+  };
+
+  auto data_start_pos = s_void_after_track_headers->GetElementPosition() + s_void_after_track_headers->ElementSize(render_should_write_arg(true));
+  auto have_data      = static_cast<uint64_t>(s_out->get_size()) > data_start_pos;
+
+  for (auto const &request : requests) {
+    for (auto const &[entry, size] : request.entry_sizes)
+      size_differences[entry] = static_cast<int64_t>(size) - static_cast<int64_t>(entry->ElementSize());
+
+    auto data_size = static_cast<int64_t>(g_kax_tracks->GetSize());
+    for (auto const &[entry, difference] : size_differences)
+      data_size += difference;
+
+    auto new_tracks_end_pos = tracks_end_pos(data_size);
+    auto new_void_size      = make_room_for_track_headers(new_tracks_end_pos, data_start_pos, have_data);
+    data_start_pos          = new_tracks_end_pos + new_void_size;
+
+    mxdebug_if(s_debug_rerender_track_headers,
+               fmt::format("[rerender] replaying request of packetizer {0} #{1}: new_tracks_end_pos {2} data_start_pos {3}\n",
+                           request.ptzr_idx, request.sequence_number, new_tracks_end_pos, data_start_pos));
+  }
+
+  // Normally the last request has seen the current sizes already.
+  auto new_tracks_end_pos = g_kax_tracks->GetElementPosition() + g_kax_tracks->ElementSize();
+  auto new_void_size      = make_room_for_track_headers(new_tracks_end_pos, data_start_pos, have_data);
+
+  shrink_void_and_rerender_track_headers(new_void_size);
+}
+
 /** \brief Render all attachments into the output file at the current position
 
    This function also makes sure that no duplicates are output. This might
@@ -1413,7 +1585,12 @@ create_next_output_file() {
 
   // Open the output file.
   try {
-    s_out = !g_cluster_helper->discarding() ? mm_write_buffer_io_c::open(this_outfile, 20 * 1024 * 1024) : mm_io_cptr{ new mm_null_io_c{this_outfile} };
+    if (g_cluster_helper->discarding())
+      s_out = std::make_shared<mm_null_io_c>(this_outfile);
+    else {
+      auto file = mtx::timing_statistics::wrap_output_file(std::make_shared<mm_file_io_c>(this_outfile, libebml::MODE_CREATE));
+      s_out     = std::make_shared<mm_write_buffer_io_c>(file, 5 * 1024 * 1024, 4);
+    }
   } catch (mtx::mm_io::exception &ex) {
     mxerror(fmt::format(FY("The file '{0}' could not be opened for writing: {1}.\n"), this_outfile, ex));
   }
@@ -2132,6 +2309,11 @@ check_and_handle_end_of_input_after_pulling(packetizer_t &ptzr) {
 
 static std::pair<bool, bool>
 force_pull_packetizers_of_fully_held_files() {
+  // Holding packetizers are always scheduled for pulling.
+  if (   s_packetizer_schedule_valid
+      && std::none_of(s_packetizers_to_pull.begin(), s_packetizers_to_pull.end(), [](auto idx) { return FILE_STATUS_HOLDING == g_packetizers[idx].status; }))
+    return { false, false };
+
   std::unordered_map<generic_reader_c *, bool> fully_held_files;
   auto end_of_video_reached = false;
 
@@ -2160,40 +2342,267 @@ force_pull_packetizers_of_fully_held_files() {
         end_of_video_reached = true;
     }
 
+  if (force_pulled)
+    s_packetizer_schedule_valid = false;
+
   return { end_of_video_reached, force_pulled };
 }
 
+static void
+pull_packetizer_for_packet(packetizer_t &ptzr) {
+  if (FILE_STATUS_HOLDING == ptzr.status)
+    ptzr.status = FILE_STATUS_MOREDATA;
+
+  ptzr.old_status = ptzr.status;
+
+  while (   !ptzr.pack
+         && (FILE_STATUS_MOREDATA == ptzr.status)
+         && !ptzr.packetizer->packet_available())
+    ptzr.status = ptzr.packetizer->read(false);
+
+  if (   (FILE_STATUS_MOREDATA != ptzr.status)
+      && (FILE_STATUS_MOREDATA == ptzr.old_status))
+    ptzr.packetizer->force_duration_on_last_packet();
+
+  if (!ptzr.pack)
+    ptzr.pack = ptzr.packetizer->get_packet();
+}
+
+/** \brief Group the packetizers by the reader they're fed by
+
+   A reader may hand packets to any of its packetizers, no matter which
+   one requested data. Therefore only packetizers of different readers
+   can be pulled independently of each other. The order of the
+   packetizers within each group is the same as in \c g_packetizers.
+*/
+static std::vector<std::vector<packetizer_t *>>
+group_packetizers_by_reader() {
+  std::vector<std::vector<packetizer_t *>> groups;
+  std::unordered_map<generic_reader_c *, std::size_t> group_idx_by_reader;
+
+  for (auto &ptzr : g_packetizers) {
+    auto reader = ptzr.packetizer->m_reader;
+    auto itr    = group_idx_by_reader.find(reader);
+
+    if (itr == group_idx_by_reader.end()) {
+      itr = group_idx_by_reader.emplace(reader, groups.size()).first;
+      groups.emplace_back();
+    }
+
+    groups[itr->second].push_back(&ptzr);
+  }
+
+  return groups;
+}
+
 static bool
-pull_packetizers_for_packets() {
+pull_packetizers_in_parallel() {
+  if (!g_parallel_reading || s_appending_files)
+    return false;
+
+  auto groups = group_packetizers_by_reader();
+  if (groups.size() < 2)
+    return false;
+
+  if (!s_reader_thread_pool) {
+    s_reader_thread_pool = std::make_unique<mtx::thread_pool_c>(std::min(groups.size(), mtx::thread_pool_c::default_num_threads()));
+    mxdebug_if(s_debug_parallel_reading, fmt::format("pull_packetizers_in_parallel: {0} readers, {1} threads\n", groups.size(), s_reader_thread_pool->get_num_threads()));
+  }
+
+  std::vector<std::future<void>> pulls;
+  pulls.reserve(groups.size());
+
+  s_deferred_track_headers_rerenderings.clear();
+  s_pulling_in_parallel = true;
+
+  for (auto const &group : groups)
+    pulls.emplace_back(s_reader_thread_pool->submit([&group]() {
+      s_group_being_pulled                  = &group;
+      s_num_rerenderings_requested_by_group = 0;
+
+      for (auto ptzr : group) {
+        s_packetizer_being_pulled = ptzr;
+        pull_packetizer_for_packet(*ptzr);
+      }
+    }));
+
+  // Wait for all of them even if one fails so that none is still
+  // running while the error is handled.
+  std::exception_ptr first_exception;
+
+  for (auto &pull : pulls)
+    try {
+      pull.get();
+    } catch (...) {
+      if (!first_exception)
+        first_exception = std::current_exception();
+    }
+
+  s_pulling_in_parallel = false;
+
+  // A reader's own error handling may have swallowed the exception
+  // thrown by mxexit() on a worker thread, but the request is recorded
+  // nonetheless.
+  if (auto code = mxexit_requested())
+    mxexit(*code);
+
+  if (first_exception) {
+    try {
+      std::rethrow_exception(first_exception);
+    } catch (mtx::exit_requested_x &ex) {
+      mxexit(ex.code());
+    }
+  }
+
+  replay_deferred_track_headers_rerenderings();
+
+  return true;
+}
+
+static void
+add_packetizer_with_packet(std::size_t idx) {
+  auto &ptzr = g_packetizers[idx];
+  s_packetizers_with_packets.push({ ptzr.pack->output_order_timestamp, idx, ptzr.pack.get() });
+}
+
+static void
+update_packetizer_schedule(std::size_t idx) {
+  auto &ptzr = g_packetizers[idx];
+  auto &dry  = s_dry_packetizers_by_reader[ptzr.packetizer->m_reader];
+
+  if (!ptzr.pack && (FILE_STATUS_DONE_AND_DRY == ptzr.status))
+    dry.insert(idx);
+  else
+    dry.erase(idx);
+
+  if (FILE_STATUS_HOLDING == ptzr.status)
+    s_packetizers_to_pull.insert(idx);
+}
+
+static void
+reset_packetizer_schedule() {
+  s_packetizer_schedule_valid = false;
+  s_packetizers_to_pull.clear();
+  s_packetizers_with_packets  = {};
+  s_dry_packetizers_by_reader.clear();
+}
+
+static void
+rebuild_packetizer_schedule() {
+  reset_packetizer_schedule();
+
+  for (auto idx = 0u; idx < g_packetizers.size(); ++idx) {
+    auto &ptzr = g_packetizers[idx];
+
+    if (ptzr.pack)
+      add_packetizer_with_packet(idx);
+
+    else if ((FILE_STATUS_DONE_AND_DRY != ptzr.status) || ptzr.packetizer->packet_available())
+      s_packetizers_to_pull.insert(idx);
+
+    update_packetizer_schedule(idx);
+  }
+
+  // Appending replaces packetizers & parallel reading pulls all of
+  // them anyway.
+  s_packetizer_schedule_valid = !s_appending_files && !g_parallel_reading;
+}
+
+/** \brief Pull only those packetizers that need it
+
+   Pulling a packetizer that already has a packet is a no-op unless
+   its status is "holding". Therefore only the following packetizers
+   are pulled, in the same order as in \c g_packetizers: the ones whose
+   packet has been written, those without a packet that aren't
+   finished yet and those that are holding. A packetizer that has run
+   dry may still receive packets while another packetizer of the same
+   reader is pulled; it is checked whenever that happens.
+*/
+static bool
+pull_scheduled_packetizers_for_packets() {
   auto end_of_video_reached = false;
+  auto to_pull              = std::move(s_packetizers_to_pull);
 
-  for (auto &ptzr : g_packetizers) {
-    if (FILE_STATUS_HOLDING == ptzr.status)
-      ptzr.status = FILE_STATUS_MOREDATA;
+  s_packetizers_to_pull.clear();
 
-    ptzr.old_status = ptzr.status;
+  for (auto itr = to_pull.begin(); itr != to_pull.end(); ++itr) {
+    auto idx      = *itr;
+    auto &ptzr    = g_packetizers[idx];
+    auto had_pack = !!ptzr.pack;
 
-    while (   !ptzr.pack
-           && (FILE_STATUS_MOREDATA == ptzr.status)
-           && !ptzr.packetizer->packet_available())
-      ptzr.status = ptzr.packetizer->read(false);
+    pull_packetizer_for_packet(ptzr);
 
-    if (   (FILE_STATUS_MOREDATA != ptzr.status)
-        && (FILE_STATUS_MOREDATA == ptzr.old_status))
-      ptzr.packetizer->force_duration_on_last_packet();
+    if (check_and_handle_end_of_input_after_pulling(ptzr))
+      end_of_video_reached = true;
 
-    if (!ptzr.pack)
-      ptzr.pack = ptzr.packetizer->get_packet();
+    if (!had_pack && ptzr.pack)
+      add_packetizer_with_packet(idx);
+
+    update_packetizer_schedule(idx);
+
+    auto &dry = s_dry_packetizers_by_reader[ptzr.packetizer->m_reader];
+
+    for (auto dry_itr = dry.begin(); dry_itr != dry.end();) {
+      auto dry_idx = *dry_itr;
+
+      if ((dry_idx == idx) || !g_packetizers[dry_idx].packetizer->packet_available()) {
+        ++dry_itr;
+        continue;
+      }
+
+      // Packetizers following the current one would have been pulled
+      // during this pass, the others during the next one.
+      if (dry_idx > idx)
+        to_pull.insert(dry_idx);
+      else
+        s_packetizers_to_pull.insert(dry_idx);
+
+      dry_itr = dry.erase(dry_itr);
+    }
+  }
+
+  return end_of_video_reached;
+}
+
+static bool
+pull_packetizers_for_packets() {
+  if (s_packetizer_schedule_valid)
+    return pull_scheduled_packetizers_for_packets();
+
+  auto end_of_video_reached = false;
+  auto pulled_in_parallel   = pull_packetizers_in_parallel();
+
+  // The bookkeeping for finished files is always done in the original
+  // order so that the output is identical to the sequential one.
+  for (auto &ptzr : g_packetizers) {
+    if (!pulled_in_parallel)
+      pull_packetizer_for_packet(ptzr);
 
     if (check_and_handle_end_of_input_after_pulling(ptzr))
       end_of_video_reached = true;
   }
 
+  rebuild_packetizer_schedule();
+
   return end_of_video_reached;
 }
 
 static packetizer_t *
 select_winning_packetizer() {
+  if (s_packetizer_schedule_valid) {
+    while (!s_packetizers_with_packets.empty()) {
+      auto const &top = s_packetizers_with_packets.top();
+      auto &ptzr      = g_packetizers[top.m_idx];
+
+      if (ptzr.pack.get() == top.m_packet)
+        return &ptzr;
+
+      s_packetizers_with_packets.pop();
+    }
+
+    return nullptr;
+  }
+
   packetizer_t *winner = nullptr;
 
   for (auto &ptzr : g_packetizers) {
@@ -2250,6 +2659,11 @@ main_loop() {
 
       winner->pack.reset();
 
+      if (s_packetizer_schedule_valid) {
+        s_packetizers_with_packets.pop();
+        s_packetizers_to_pull.insert(winner - &g_packetizers[0]);
+      }
+
       add_split_points_from_remainig_chapter_numbers();
 
       // If splitting by parts is active and the last part has been
@@ -2281,6 +2695,7 @@ static void
 destroy_readers() {
   g_files.clear();
   g_packetizers.clear();
+  reset_packetizer_schedule();
 }
 
 /** \brief Uninitialization
@@ -2289,6 +2704,8 @@ destroy_readers() {
 */
 void
 cleanup() {
+  s_reader_thread_pool.reset();
+
   if (s_out) {
     // If cleanup was called as a result of an exception during
     // writing due to the file system being full, the destructor would
@@ -2326,6 +2743,7 @@ cleanup() {
   s_void_after_track_headers.reset();
 
   g_packetizers.clear();
+  reset_packetizer_schedule();
   g_files.clear();
   g_attachments.clear();
   g_track_order.clear();
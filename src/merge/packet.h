@@ -15,6 +15,8 @@
 
 #include "common/common_pch.h"
 
+#include <future>
+
 #include "common/timestamp.h"
 
 namespace libmatroska {
@@ -87,6 +89,9 @@ struct packet_t {
 
   std::vector<packet_extension_cptr> extensions;
 
+  // Set while data & data_adds are being compressed on another thread.
+  std::shared_future<void> pending_compression;
+
   packet_t()
     : group{}
     , block{}
@@ -164,6 +169,11 @@ struct packet_t {
   }
 
   ~packet_t() {
+    // The compression task only refers to the packet, it doesn't keep
+    // it alive. Packets that are dropped without having been output
+    // (e.g. discarded ones) must not go away while it's running.
+    if (pending_compression.valid())
+      pending_compression.wait();
   }
 
   bool
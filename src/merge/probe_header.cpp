@@ -0,0 +1,179 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   the shared file header buffer used while probing
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/dirac.h"
+#include "common/endian.h"
+#include "common/list_utils.h"
+#include "common/mm_io.h"
+#include "common/vc1.h"
+#include "merge/probe_header.h"
+
+probe_header_c::probe_header_c(mm_io_c &in,
+                               std::size_t size) {
+  m_data = memory_c::alloc(size);
+
+  in.setFilePointer(0);
+  auto num_read = in.read(m_data->get_buffer(), size);
+  in.setFilePointer(0);
+
+  m_data->set_size(num_read);
+  m_complete_file = num_read < size;
+}
+
+probe_header_c::probe_header_c(memory_cptr const &data,
+                               bool complete_file)
+  : m_data{data}
+  , m_complete_file{complete_file}
+{
+}
+
+memory_c const &
+probe_header_c::get_data()
+  const {
+  return *m_data;
+}
+
+std::optional<bool>
+probe_header_c::matches_at(std::size_t offset,
+                           std::string const &signature,
+                           bool case_insensitive)
+  const {
+  if ((offset + signature.size()) > m_data->get_size())
+    return m_complete_file ? std::optional<bool>{false} : std::nullopt;
+
+  auto actual = std::string{reinterpret_cast<char const *>(m_data->get_buffer() + offset), signature.size()};
+
+  return case_insensitive ? balg::iequals(actual, signature) : (actual == signature);
+}
+
+std::optional<bool>
+probe_header_c::matches_at(std::size_t offset,
+                           uint32_t signature)
+  const {
+  if ((offset + 4) > m_data->get_size())
+    return m_complete_file ? std::optional<bool>{false} : std::nullopt;
+
+  return get_uint32_be(m_data->get_buffer() + offset) == signature;
+}
+
+// Mirrors mtx::id3::skip_v2_tag(). Returns the offset following the
+// tag, or nothing if it cannot be determined from the header alone.
+std::optional<std::size_t>
+probe_header_c::skip_id3v2_tag()
+  const {
+  auto buffer = m_data->get_buffer();
+
+  if (m_data->get_size() < 10)
+    return m_complete_file ? std::optional<std::size_t>{0} : std::nullopt;
+
+  if (   std::memcmp(buffer, "ID3", 3)
+      || (buffer[3] == 0xff) || (buffer[4] == 0xff)
+      || (buffer[6] >= 0x80) || (buffer[7] >= 0x80) || (buffer[8] >= 0x80))
+    return 0;
+
+  std::size_t tag_size = (buffer[6] << 21) | (buffer[7] << 14) | (buffer[8] << 7) | buffer[9];
+  tag_size            += 10;
+  if ((buffer[5] & 0x10) != 0)
+    tag_size += 10;
+
+  return tag_size;
+}
+
+// Mirrors qtmp4_reader_c::probe_file(): a chain of "wide" & "skip"
+// atoms followed by one of the top-level atoms.
+bool
+probe_header_c::may_be_qtmp4()
+  const {
+  std::size_t pos = 0;
+
+  while (true) {
+    if ((pos + 8) > m_data->get_size())
+      return !m_complete_file;
+
+    uint64_t atom_size = get_uint32_be(m_data->get_buffer() + pos);
+    auto atom          = std::string{reinterpret_cast<char const *>(m_data->get_buffer() + pos + 4), 4};
+
+    if (mtx::included_in(atom, "moov", "ftyp", "mdat", "pnot"))
+      return true;
+
+    if ((atom != "wide") && (atom != "skip"))
+      return false;
+
+    if (1 == atom_size) {
+      if ((pos + 16) > m_data->get_size())
+        return !m_complete_file;
+      atom_size = get_uint64_be(m_data->get_buffer() + pos + 8);
+    }
+
+    // Leave degenerate cases to the reader itself.
+    if (8 > atom_size)
+      return true;
+
+    pos += atom_size;
+  }
+}
+
+bool
+probe_header_c::may_be(mtx::file_type_e type)
+  const {
+  using ft = mtx::file_type_e;
+
+  std::optional<bool> result;
+
+  switch (type) {
+    case ft::avi:
+      result = matches_at(0, "riff", true);
+      if (result.value_or(true))
+        result = matches_at(8, "avi ", true);
+      break;
+
+    case ft::coreaudio:   result = matches_at(0, "caff", true);                                 break;
+    case ft::dirac:       result = matches_at(0, mtx::dirac::SYNC_WORD);                        break;
+    case ft::flv:         result = matches_at(0, "FLV");                                        break;
+    case ft::hdmv_textst: result = matches_at(0, "TextST");                                     break;
+    case ft::ivf:         result = matches_at(0, "DKIF");                                       break;
+    case ft::matroska:    result = matches_at(0, 0x1a45dfa3);                                   break;
+    case ft::ogm:         result = matches_at(0, "OggS");                                       break;
+    case ft::pgssup:      result = matches_at(0, "PG");                                         break;
+    case ft::qtmp4:       result = may_be_qtmp4();                                              break;
+    case ft::real:        result = matches_at(0, ".RMF");                                       break;
+    case ft::wavpack4:    result = matches_at(0, "wvpk");                                       break;
+
+    case ft::flac:
+    case ft::tta: {
+      auto offset = skip_id3v2_tag();
+      if (offset)
+        result = matches_at(*offset, ft::flac == type ? "fLaC" : "TTA1");
+      break;
+    }
+
+    case ft::vc1:
+      if (m_data->get_size() >= 4)
+        result = mtx::included_in(get_uint32_be(m_data->get_buffer()), mtx::vc1::MARKER_SEQHDR, mtx::vc1::MARKER_ENTRYPOINT, mtx::vc1::MARKER_FRAME);
+      else if (m_complete_file)
+        result = false;
+      break;
+
+    case ft::wav:
+      // Wave64's RIFF GUID starts with "riff".
+      result = matches_at(0, "RIFF").value_or(true) || matches_at(0, "RF64").value_or(true) || matches_at(0, "riff").value_or(true);
+      break;
+
+    default:
+      break;
+  }
+
+  return result.value_or(true);
+}
@@ -0,0 +1,47 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   class definition for the shared file header buffer used while probing
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include "common/file_types.h"
+
+// Holds the start of a file so that the signatures of all file types
+// that can be identified by them can be checked without any further
+// I/O.
+class probe_header_c {
+public:
+  static constexpr std::size_t default_size = 64 * 1024;
+
+protected:
+  memory_cptr m_data;
+  bool m_complete_file{};
+
+public:
+  probe_header_c(mm_io_c &in, std::size_t size = default_size);
+  probe_header_c(memory_cptr const &data, bool complete_file);
+
+  memory_c const &get_data() const;
+
+  // Returns false only if the file cannot possibly be of the given
+  // type. Types without a known signature always yield true, as do
+  // signatures lying beyond the end of the buffered header.
+  bool may_be(mtx::file_type_e type) const;
+
+protected:
+  std::optional<bool> matches_at(std::size_t offset, std::string const &signature, bool case_insensitive = false) const;
+  std::optional<bool> matches_at(std::size_t offset, uint32_t signature) const;
+  std::optional<std::size_t> skip_id3v2_tag() const;
+  bool may_be_qtmp4() const;
+};
@@ -12,9 +12,11 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
 #include <typeinfo>
 
 #include "common/mm_file_io.h"
+#include "common/mm_mmap_io.h"
 #include "common/mm_mpls_multi_file_io.h"
 #include "common/mm_proxy_io.h"
 #include "common/mm_read_buffer_io.h"
@@ -60,6 +62,7 @@
 #include "input/unsupported_types_signature_prober.h"
 #include "merge/filelist.h"
 #include "merge/input_x.h"
+#include "merge/probe_header.h"
 #include "merge/probe_range_info.h"
 #include "merge/reader_detection_and_creation.h"
 
@@ -75,6 +78,9 @@ file_names_to_paths(const std::vector<std::string> &file_names) {
 static mm_io_cptr
 open_input_file(filelist_t &file) {
   try {
+    if ((file.all_names.size() == 1) && g_memory_mapped_reading)
+      return mm_mmap_io_c::open(file.name);
+
     if (file.all_names.size() == 1)
       return std::make_shared<mm_read_buffer_io_c>(std::make_shared<mm_file_io_c>(file.name));
 
@@ -87,6 +93,9 @@ open_input_file(filelist_t &file) {
     mxerror(fmt::format(FY("The file '{0}' could not be opened for reading: {1}.\n"), file.name, ex));
     return mm_io_cptr{};
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxerror(fmt::format(FY("The source file '{0}' could not be opened successfully, or retrieving its size by seeking to the end did not work.\n"), file.name));
     return mm_io_cptr{};
@@ -135,6 +144,9 @@ do_probe(mm_io_cptr const &io,
     probed_ok = reader->probe_file();
   } catch (mtx::exception &ex) {
     mxdebug_if(s_debug_probe, fmt::format("do_probe<{}>: mtx::exception caught: {}\n", typeid(Treader).name(), ex.what()));
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxdebug_if(s_debug_probe, fmt::format("do_probe<{}>: generic exception caught\n", typeid(Treader).name()));
   }
@@ -168,6 +180,9 @@ using prober_t = std::function<std::unique_ptr<generic_reader_c>(mm_io_cptr cons
 static prober_t
 prober_for_type(mtx::file_type_e type) {
   static std::map<mtx::file_type_e, prober_t> type_probe_map;
+  static std::mutex s_mutex;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
 
   if (type_probe_map.empty()) {
     type_probe_map[mtx::file_type_e::avc_es]      = &do_probe<avc_es_reader_c>;
@@ -206,9 +221,10 @@ prober_for_type(mtx::file_type_e type) {
 }
 
 std::unique_ptr<generic_reader_c>
-detect_text_file_formats(filelist_t const &file) {
+detect_text_file_formats(filelist_t const &file,
+                         mm_io_cptr const &io) {
   try {
-    auto text_io = std::make_shared<mm_text_io_c>(std::make_shared<mm_read_buffer_io_c>(std::make_shared<mm_file_io_c>(file.name)));
+    auto text_io = std::make_shared<mm_text_io_c>(io);
     std::unique_ptr<generic_reader_c> reader;
 
     if ((reader = do_probe<webvtt_reader_c>(text_io)))
@@ -238,6 +254,9 @@ detect_text_file_formats(filelist_t const &file) {
   } catch (mtx::mm_io::exception &ex) {
     mxerror(fmt::format(FY("The file '{0}' could not be opened for reading: {1}.\n"), file.name, ex));
 
+  } catch (mtx::exit_requested_x &) {
+    throw;
+
   } catch (...) {
     mxerror(fmt::format(FY("The source file '{0}' could not be opened successfully, or retrieving its size by seeking to the end did not work.\n"), file.name));
   }
@@ -249,6 +268,10 @@ detect_text_file_formats(filelist_t const &file) {
 
    Opens the input file and calls the \c probe_file function for each known
    file reader class. Uses \c mm_text_io_c for subtitle probing.
+
+   The start of the file is read only once. File types that can be
+   recognized by a signature are only probed if their signature is
+   present in that header.
 */
 std::unique_ptr<generic_reader_c>
 probe_file_format(filelist_t &file) {
@@ -260,56 +283,54 @@ probe_file_format(filelist_t &file) {
   if (is_playlist)
     io = std::make_shared<mm_read_buffer_io_c>(file.playlist_mpls_in);
 
+  probe_header_c header{*io};
+
+  auto may_be = [&header](mtx::file_type_e type) {
+    auto result = header.may_be(type);
+    mxdebug_if(s_debug_probe && !result, fmt::format("probe_file_format: skipping {0}: signature not found in header\n", mtx::file_type_t::get_name(type).get_untranslated()));
+    return result;
+  };
+
   // File types that can be detected unambiguously but are not
   // supported. The prober does not return if it detects the type.
   do_probe<unsupported_types_signature_prober_c>(io);
 
   // File types that can be detected unambiguously
-  if ((reader = do_probe<avi_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<flv_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<kax_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<wav_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<ogm_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<hdmv_textst_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<flac_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<hdmv_pgs_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<real_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<qtmp4_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<tta_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<vc1_es_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<wavpack_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<ivf_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<coreaudio_reader_c>(io)))
-    return reader;
-  if ((reader = do_probe<dirac_es_reader_c>(io)))
-    return reader;
+  static std::vector<mtx::file_type_e> const s_unambiguous_types{
+    mtx::file_type_e::avi,
+    mtx::file_type_e::flv,
+    mtx::file_type_e::matroska,
+    mtx::file_type_e::wav,
+    mtx::file_type_e::ogm,
+    mtx::file_type_e::hdmv_textst,
+    mtx::file_type_e::flac,
+    mtx::file_type_e::pgssup,
+    mtx::file_type_e::real,
+    mtx::file_type_e::qtmp4,
+    mtx::file_type_e::tta,
+    mtx::file_type_e::vc1,
+    mtx::file_type_e::wavpack4,
+    mtx::file_type_e::ivf,
+    mtx::file_type_e::coreaudio,
+    mtx::file_type_e::dirac,
+  };
+
+  for (auto type : s_unambiguous_types)
+    if (may_be(type) && (reader = prober_for_type(type)(io, {})))
+      return reader;
 
   // Prefer types hinted by extension
   auto extension = mtx::fs::to_path(file.name).extension().string();
   if (!extension.empty()) {
     for (auto type : mtx::file_type_t::by_extension(extension.substr(1))) {
       auto p = prober_for_type(type);
-      if (p && (reader = p(io, {})))
+      if (p && may_be(type) && (reader = p(io, {})))
         return reader;
     }
   }
 
   // All text file types (subtitles).
-  if ((reader = detect_text_file_formats(file)))
+  if ((reader = detect_text_file_formats(file, io)))
     return reader;
 
   // AVC & HEVC, even though often mis-detected, have a very high
@@ -399,40 +420,45 @@ probe_file_format(filelist_t &file) {
 }
 
 void
-read_file_headers() {
+read_file_headers(filelist_t &file) {
   static auto s_debug_timestamp_restrictions = debugging_option_c{"timestamp_restrictions"};
 
-  g_file_sizes = 0;
+  try {
+    file.reader->m_appending = file.appending;
+    file.reader->set_track_info(*file.ti);
+    file.reader->set_timestamp_restrictions(file.restricted_timestamp_min, file.restricted_timestamp_max);
+    file.reader->read_headers();
 
-  for (auto &file : g_files) {
-    try {
-      file->reader->m_appending = file->appending;
-      file->reader->set_track_info(*file->ti);
-      file->reader->set_timestamp_restrictions(file->restricted_timestamp_min, file->restricted_timestamp_max);
-      file->reader->read_headers();
+    // Re-calculate file size because the reader might switch to a
+    // multi I/O reader in read_headers().
+    file.size = file.reader->get_file_size();
 
-      // Re-calculate file size because the reader might switch to a
-      // multi I/O reader in read_headers().
-      file->size    = file->reader->get_file_size();
-      g_file_sizes += file->size;
+    mxdebug_if(s_debug_timestamp_restrictions,
+               fmt::format("Timestamp restrictions for {2}: min {0} max {1}\n", file.restricted_timestamp_min, file.restricted_timestamp_max, file.ti->m_fname));
 
-      mxdebug_if(s_debug_timestamp_restrictions,
-                 fmt::format("Timestamp restrictions for {2}: min {0} max {1}\n", file->restricted_timestamp_min, file->restricted_timestamp_max, file->ti->m_fname));
+  } catch (mtx::mm_io::open_x &error) {
+    mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file.ti->m_fname, Y("The file could not be opened for reading, or there was not enough data to parse its headers.")));
 
-    } catch (mtx::mm_io::open_x &error) {
-      mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file->ti->m_fname, Y("The file could not be opened for reading, or there was not enough data to parse its headers.")));
+  } catch (mtx::input::open_x &error) {
+    mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file.ti->m_fname, Y("The file could not be opened for reading, or there was not enough data to parse its headers.")));
 
-    } catch (mtx::input::open_x &error) {
-      mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file->ti->m_fname, Y("The file could not be opened for reading, or there was not enough data to parse its headers.")));
+  } catch (mtx::input::invalid_format_x &error) {
+    mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file.ti->m_fname, Y("The file content does not match its format type and was not recognized.")));
 
-    } catch (mtx::input::invalid_format_x &error) {
-      mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file->ti->m_fname, Y("The file content does not match its format type and was not recognized.")));
+  } catch (mtx::input::header_parsing_x &error) {
+    mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file.ti->m_fname, Y("The file headers could not be parsed, e.g. because they're incomplete, invalid or damaged.")));
 
-    } catch (mtx::input::header_parsing_x &error) {
-      mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file->ti->m_fname, Y("The file headers could not be parsed, e.g. because they're incomplete, invalid or damaged.")));
+  } catch (mtx::input::exception &error) {
+    mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file.ti->m_fname, error.error()));
+  }
+}
 
-    } catch (mtx::input::exception &error) {
-      mxerror(fmt::format(FY("The demultiplexer for the file '{0}' failed to initialize:\n{1}\n"), file->ti->m_fname, error.error()));
-    }
+void
+read_file_headers() {
+  g_file_sizes = 0;
+
+  for (auto &file : g_files) {
+    read_file_headers(*file);
+    g_file_sizes += file->size;
   }
 }
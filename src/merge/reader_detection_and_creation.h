@@ -20,3 +20,4 @@ struct filelist_t;
 
 std::unique_ptr<generic_reader_c> probe_file_format(filelist_t &file);
 void read_file_headers();
+void read_file_headers(filelist_t &file);
@@ -0,0 +1,262 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   measuring the time spent in the stages of multiplexing
+
+   Written by agent <agent@local>.
+*/
+
+#include "common/common_pch.h"
+
+#include <mutex>
+
+#include "common/json.h"
+#include "common/mm_file_io.h"
+#include "common/mm_io_x.h"
+#include "common/mm_proxy_io.h"
+#include "common/version.h"
+#include "merge/timing_statistics.h"
+
+namespace mtx::timing_statistics {
+
+namespace {
+
+class timed_io_c: public mm_proxy_io_c {
+public:
+  timed_io_c(mm_io_cptr const &proxy_io)
+    : mm_proxy_io_c{proxy_io}
+  {
+  }
+
+protected:
+  virtual uint32_t
+  _read(void *buffer,
+        size_t size)
+    override {
+    timer_c timer{get_stage(global_stage_e::output_io)};
+
+    auto num_read = mm_proxy_io_c::_read(buffer, size);
+    timer.add_bytes(num_read);
+
+    return num_read;
+  }
+
+  virtual size_t
+  _write(const void *buffer,
+         size_t size)
+    override {
+    timer_c timer{get_stage(global_stage_e::output_io)};
+
+    auto num_written = mm_proxy_io_c::_write(buffer, size);
+    timer.add_bytes(num_written);
+
+    return num_written;
+  }
+};
+
+bool s_enabled{};
+std::string s_file_name;
+std::chrono::steady_clock::time_point s_start;
+
+std::mutex s_mutex;
+std::vector<stage_cptr> s_stages;
+std::vector<stage_cptr> s_global_stages;
+
+thread_local timer_c *tl_current_timer{};
+
+double
+bytes_per_second(uint64_t bytes,
+                 uint64_t ns) {
+  return ns ? bytes * 1'000'000'000.0 / ns : 0.0;
+}
+
+nlohmann::json
+stage_to_json(stage_c const &stage) {
+  auto bytes    = stage.m_bytes.load();
+  auto total_ns = stage.m_total_ns.load();
+
+  auto json = nlohmann::json{
+    { "type",             stage.m_type                      },
+    { "calls",            stage.m_calls.load()              },
+    { "packets",          stage.m_packets.load()            },
+    { "bytes",            bytes                             },
+    { "total_time_ns",    total_ns                          },
+    { "self_time_ns",     stage.m_self_ns.load()            },
+    { "bytes_per_second", bytes_per_second(bytes, total_ns) },
+  };
+
+  if (!stage.m_file_name.empty())
+    json["file_name"] = stage.m_file_name;
+  if (!stage.m_format.empty())
+    json["format"] = stage.m_format;
+  if (!stage.m_codec_id.empty())
+    json["codec_id"] = stage.m_codec_id;
+  if (stage.m_track_id >= 0)
+    json["track_id"] = stage.m_track_id;
+
+  return json;
+}
+
+nlohmann::json
+summarize_by_codec() {
+  struct codec_summary_t {
+    uint64_t m_packets{}, m_bytes{}, m_process_self_ns{}, m_add_packet_self_ns{};
+  };
+
+  std::map<std::string, codec_summary_t> summaries;
+
+  for (auto const &stage : s_stages) {
+    if (stage->m_codec_id.empty())
+      continue;
+
+    auto &summary = summaries[stage->m_codec_id];
+
+    if (stage->m_type == "packetizer_process") {
+      summary.m_packets         += stage->m_packets.load();
+      summary.m_bytes           += stage->m_bytes.load();
+      summary.m_process_self_ns += stage->m_self_ns.load();
+
+    } else if (stage->m_type == "packetizer_add_packet")
+      summary.m_add_packet_self_ns += stage->m_self_ns.load();
+  }
+
+  auto json = nlohmann::json::object();
+
+  for (auto const &[codec_id, summary] : summaries) {
+    auto ns = summary.m_process_self_ns + summary.m_add_packet_self_ns;
+
+    json[codec_id] = nlohmann::json{
+      { "packets",          summary.m_packets                       },
+      { "bytes",            summary.m_bytes                         },
+      { "self_time_ns",     ns                                      },
+      { "bytes_per_second", bytes_per_second(summary.m_bytes, ns)   },
+    };
+  }
+
+  return json;
+}
+
+} // anonymous namespace
+
+stage_c::stage_c(std::string type,
+                 std::string file_name,
+                 std::string format,
+                 std::string codec_id,
+                 int64_t track_id)
+  : m_type{std::move(type)}
+  , m_file_name{std::move(file_name)}
+  , m_format{std::move(format)}
+  , m_codec_id{std::move(codec_id)}
+  , m_track_id{track_id}
+{
+}
+
+void
+enable(std::string const &file_name) {
+  s_enabled   = true;
+  s_file_name = file_name;
+  s_start     = std::chrono::steady_clock::now();
+
+  s_global_stages.clear();
+  s_global_stages.emplace_back(create_stage("cluster_rendering"));
+  s_global_stages.emplace_back(create_stage("cue_writing"));
+  s_global_stages.emplace_back(create_stage("output_io"));
+}
+
+bool
+is_enabled() {
+  return s_enabled;
+}
+
+stage_cptr
+create_stage(std::string const &type,
+             std::string const &file_name,
+             std::string const &format,
+             std::string const &codec_id,
+             int64_t track_id) {
+  if (!s_enabled)
+    return {};
+
+  auto stage = std::make_shared<stage_c>(type, file_name, format, codec_id, track_id);
+
+  std::lock_guard<std::mutex> lock{s_mutex};
+  s_stages.push_back(stage);
+
+  return stage;
+}
+
+stage_c *
+get_stage(global_stage_e stage) {
+  auto idx = static_cast<std::size_t>(stage);
+  return idx < s_global_stages.size() ? s_global_stages[idx].get() : nullptr;
+}
+
+mm_io_cptr
+wrap_output_file(mm_io_cptr const &file) {
+  if (!s_enabled)
+    return file;
+
+  return std::make_shared<timed_io_c>(file);
+}
+
+void
+write_summary() {
+  if (!s_enabled)
+    return;
+
+  auto total_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_start).count());
+  auto stages   = nlohmann::json::array();
+
+  std::lock_guard<std::mutex> lock{s_mutex};
+
+  for (auto const &stage : s_stages)
+    stages.push_back(stage_to_json(*stage));
+
+  auto json = nlohmann::json{
+    { "version",       get_version_info("mkvmerge", vif_full) },
+    { "total_time_ns", total_ns                               },
+    { "stages",        stages                                 },
+    { "codecs",        summarize_by_codec()                   },
+  };
+
+  try {
+    mm_file_io_c out{s_file_name, libebml::MODE_CREATE};
+    out.puts(mtx::json::dump(json, 2) + "\n");
+
+  } catch (mtx::mm_io::exception &ex) {
+    mxerror(fmt::format(FY("The file '{0}' could not be opened for writing: {1}.\n"), s_file_name, ex));
+  }
+}
+
+timer_c::timer_c(stage_c *stage)
+  : m_stage{stage}
+{
+  if (!m_stage)
+    return;
+
+  m_parent         = tl_current_timer;
+  tl_current_timer = this;
+  m_start          = std::chrono::steady_clock::now();
+}
+
+timer_c::~timer_c() {
+  if (!m_stage)
+    return;
+
+  auto elapsed_ns  = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+  tl_current_timer = m_parent;
+
+  if (m_parent)
+    m_parent->m_children_ns += elapsed_ns;
+
+  m_stage->m_calls.fetch_add(1, std::memory_order_relaxed);
+  m_stage->m_total_ns.fetch_add(elapsed_ns, std::memory_order_relaxed);
+  m_stage->m_self_ns.fetch_add(elapsed_ns - std::min(elapsed_ns, m_children_ns), std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit https://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+
+   definitions for measuring the time spent in the stages of multiplexing
+
+   Written by agent <agent@local>.
+*/
+
+#pragma once
+
+#include "common/common_pch.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace mtx::timing_statistics {
+
+// One instrumented stage, e.g. a single reader's read() function or
+// the output file's I/O. The counters may be updated from several
+// threads at once.
+class stage_c {
+public:
+  std::string const m_type, m_file_name, m_format, m_codec_id;
+  int64_t const m_track_id;
+
+  std::atomic<uint64_t> m_calls{}, m_packets{}, m_bytes{}, m_total_ns{}, m_self_ns{};
+
+public:
+  stage_c(std::string type, std::string file_name = {}, std::string format = {}, std::string codec_id = {}, int64_t track_id = -1);
+};
+using stage_cptr = std::shared_ptr<stage_c>;
+
+enum class global_stage_e {
+  cluster_rendering,
+  cue_writing,
+  output_io,
+};
+
+// Enables collecting the statistics. The summary is written to the
+// given file in JSON format by write_summary().
+void enable(std::string const &file_name);
+bool is_enabled();
+
+// Returns nullptr if collecting the statistics is not enabled.
+stage_cptr create_stage(std::string const &type, std::string const &file_name = {}, std::string const &format = {}, std::string const &codec_id = {}, int64_t track_id = -1);
+stage_c *get_stage(global_stage_e stage);
+
+// Wraps the output file so that all reads & writes are attributed to
+// the output I/O stage. Returns the file itself if not enabled.
+mm_io_cptr wrap_output_file(mm_io_cptr const &file);
+
+void write_summary();
+
+// Measures the time from its construction to its destruction and
+// attributes it to the stage. Timers active on the same thread are
+// nested: the time spent in inner timers counts towards the outer
+// stages' total time but not towards their self time. Does nothing
+// if the stage is nullptr.
+class timer_c {
+protected:
+  stage_c *m_stage;
+  timer_c *m_parent{};
+  std::chrono::steady_clock::time_point m_start;
+  uint64_t m_children_ns{};
+
+public:
+  explicit timer_c(stage_c *stage);
+  ~timer_c();
+
+  timer_c(timer_c const &) = delete;
+  timer_c &operator =(timer_c const &) = delete;
+
+  void add_bytes(uint64_t bytes) {
+    if (m_stage)
+      m_stage->m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void add_packets(uint64_t packets) {
+    if (m_stage)
+      m_stage->m_packets.fetch_add(packets, std::memory_order_relaxed);
+  }
+};
+
+}
@@ -117,6 +117,8 @@ track_info_c::operator =(const track_info_c &src) {
 
   m_compression_list                 = src.m_compression_list;
   m_compression                      = src.m_compression;
+  m_compression_parameters_list      = src.m_compression_parameters_list;
+  m_compression_parameters           = src.m_compression_parameters;
 
   m_track_names                      = src.m_track_names;
   m_track_name                       = src.m_track_name;
@@ -231,6 +231,8 @@ public:
 
   std::map<int64_t, compression_method_e> m_compression_list; // As given on the cmd line
   compression_method_e m_compression; // For this very track
+  std::map<int64_t, compression_parameters_t> m_compression_parameters_list; // As given on the cmd line
+  compression_parameters_t m_compression_parameters; // For this very track
 
   std::map<int64_t, std::string> m_track_names; // As given on the command line
   std::string m_track_name;            // For this very track
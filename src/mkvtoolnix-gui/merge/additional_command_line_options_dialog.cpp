@@ -53,6 +53,14 @@ AdditionalCommandLineOptionsDialog::AdditionalCommandLineOptionsDialog(QWidget *
 
   add(Q("--stop-after-video-ends"), false, global, { QY("Stops processing after the primary video track ends, discarding any remaining packets of other tracks.") });
 
+  add(Q("--parallel-reading"), false, global,
+      { QY("Reads from several source files at the same time using multiple threads."),
+        QY("This can speed up multiplexing when several source files have to be parsed. The resulting file is the same as without this option.") });
+
+  add(Q("--memory-mapped-reading"), false, global,
+      { QY("Reads source files via memory-mapped I/O, avoiding copying the data read."),
+        QY("Only use this for files on local drives that aren't modified while multiplexing: if a source file is truncated, mkvmerge will be terminated by the operating system.") });
+
   add(Q("--no-cues"), false, global,
       { QY("Tells mkvmerge not to create and write the cue data which can be compared to an index in an AVI."),
         QY("Matroska files can be played back without the cue data, but seeking will probably be imprecise and slower."),
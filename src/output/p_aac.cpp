@@ -117,7 +117,7 @@ aac_packetizer_c::process_impl(packet_cptr const &packet) {
   while (m_parser.frames_available()) {
     auto frame = m_parser.get_frame();
 
-    process_headerless(std::make_shared<packet_t>(frame.m_data));
+    process_headerless(mtx::mem::make_pooled<packet_t>(frame.m_data));
 
     if (verbose && frame.m_garbage_size)
       mxwarn_tid(m_ti.m_fname, m_ti.m_id, fmt::format(FY("Skipping {0} bytes (no valid AAC header found). This might cause audio/video desynchronisation.\n"), frame.m_garbage_size));
@@ -13,6 +13,8 @@
 
 #include "common/common_pch.h"
 
+#include <atomic>
+
 #include "common/ac3.h"
 #include "common/codec.h"
 #include "common/hacks.h"
@@ -166,7 +168,7 @@ ac3_packetizer_c::flush_packets() {
     auto frame = get_frame();
     adjust_header_values(frame);
 
-    auto packet = std::make_shared<packet_t>(frame.m_data);
+    auto packet = mtx::mem::make_pooled<packet_t>(frame.m_data);
     packet->add_extensions(m_packet_extensions);
     packet->discard_padding = m_discard_padding.get_next(frame.m_stream_position).value_or(timestamp_c{});
 
@@ -230,17 +232,15 @@ ac3_bs_packetizer_c::ac3_bs_packetizer_c(generic_reader_c *p_reader,
 {
 }
 
-static bool s_warning_printed = false;
+static std::atomic<bool> s_warning_printed{};
 
 void
 ac3_bs_packetizer_c::add_to_buffer(uint8_t *const buf,
                                    int size) {
-  if (((size % 2) == 1) && !s_warning_printed) {
+  if (((size % 2) == 1) && !s_warning_printed.exchange(true))
     mxwarn(Y("ac3_bs_packetizer::add_to_buffer(): Untested code ('size' is odd). "
              "If mkvmerge crashes or if the resulting file does not contain the complete and correct audio track, "
              "then please contact the author Moritz Bunkus at moritz@bunkus.org.\n"));
-    s_warning_printed = true;
-  }
 
   uint8_t *sendptr;
   int size_add;
@@ -100,7 +100,7 @@ dirac_video_packetizer_c::flush_frames() {
   while (m_parser.is_frame_available()) {
     mtx::dirac::frame_cptr frame = m_parser.get_frame();
 
-    add_packet(std::make_shared<packet_t>(frame->data, frame->timestamp, frame->duration, frame->contains_sequence_header ? -1 : m_previous_timestamp));
+    add_packet(mtx::mem::make_pooled<packet_t>(frame->data, frame->timestamp, frame->duration, frame->contains_sequence_header ? -1 : m_previous_timestamp));
 
     m_previous_timestamp = frame->timestamp;
   }
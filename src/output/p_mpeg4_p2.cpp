@@ -269,7 +269,7 @@ mpeg4_p2_video_packetizer_c::flush_frames(bool end_of_file) {
     // The first frame in the file. Only apply the timestamp, nothing else.
     if (-1 == frame.timestamp) {
       get_next_timestamp_and_duration(frame.timestamp, frame.duration);
-      add_packet(std::make_shared<packet_t>(memory_c::take_ownership(frame.data, frame.size), frame.timestamp, frame.duration));
+      add_packet(mtx::mem::make_pooled<packet_t>(memory_c::take_ownership(frame.data, frame.size), frame.timestamp, frame.duration));
     }
     return;
   }
@@ -281,9 +281,9 @@ mpeg4_p2_video_packetizer_c::flush_frames(bool end_of_file) {
     get_next_timestamp_and_duration(frame.timestamp, frame.duration);
   get_next_timestamp_and_duration(fref_frame.timestamp, fref_frame.duration);
 
-  add_packet(std::make_shared<packet_t>(memory_c::take_ownership(fref_frame.data, fref_frame.size), fref_frame.timestamp, fref_frame.duration, mtx::mpeg4_p2::FRAME_TYPE_P == fref_frame.type ? bref_frame.timestamp : VFT_IFRAME));
+  add_packet(mtx::mem::make_pooled<packet_t>(memory_c::take_ownership(fref_frame.data, fref_frame.size), fref_frame.timestamp, fref_frame.duration, mtx::mpeg4_p2::FRAME_TYPE_P == fref_frame.type ? bref_frame.timestamp : VFT_IFRAME));
   for (auto &frame : m_b_frames)
-    add_packet(std::make_shared<packet_t>(memory_c::take_ownership(frame.data, frame.size), frame.timestamp, frame.duration, bref_frame.timestamp, fref_frame.timestamp));
+    add_packet(mtx::mem::make_pooled<packet_t>(memory_c::take_ownership(frame.data, frame.size), frame.timestamp, frame.duration, bref_frame.timestamp, fref_frame.timestamp));
 
   m_ref_frames.pop_front();
   m_b_frames.clear();
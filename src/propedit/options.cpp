@@ -18,6 +18,7 @@
 
 options_c::options_c()
   : m_show_progress(false)
+  , m_use_analysis_cache(false)
   , m_parse_mode(kax_analyzer_c::parse_mode_fast)
 {
 }
@@ -144,10 +145,12 @@ options_c::dump_info()
   mxinfo(fmt::format("options:\n"
                      "  file_name:     {0}\n"
                      "  show_progress: {1}\n"
-                     "  parse_mode:    {2}\n",
+                     "  parse_mode:    {2}\n"
+                     "  use_cache:     {3}\n",
                      m_file_name,
                      m_show_progress,
-                     static_cast<int>(m_parse_mode)));
+                     static_cast<int>(m_parse_mode),
+                     m_use_analysis_cache));
 
   for (auto &target : m_targets)
     target->dump_info();
@@ -22,7 +22,7 @@ class options_c {
 public:
   std::string m_file_name, m_chapter_charset;
   std::vector<target_cptr> m_targets;
-  bool m_show_progress;
+  bool m_show_progress, m_use_analysis_cache;
   kax_analyzer_c::parse_mode_e m_parse_mode;
 
 public:
@@ -13,6 +13,7 @@
 #include <matroska/KaxTracks.h>
 
 #include "common/command_line.h"
+#include "common/kax_analyzer_cache.h"
 #include "common/list_utils.h"
 #include "common/mm_io_x.h"
 #include "common/unique_numbers.h"
@@ -133,6 +134,7 @@ run(options_cptr &options) {
   mxinfo(fmt::format("{0}\n", Y("The file is being analyzed.")));
 
   analyzer->set_show_progress(options->m_show_progress);
+  mtx::kax_analyzer_cache::enable_persistent_storage(options->m_use_analysis_cache);
 
   bool ok = false;
   try {
@@ -141,6 +143,7 @@ run(options_cptr &options) {
       .set_open_mode(libebml::MODE_READ)
       .set_throw_on_error(true)
       .set_doc_type_version_handler(g_doc_type_version_handler.get())
+      .set_use_cache(options->m_use_analysis_cache)
       .process();
   } catch (mtx::exception &ex) {
     mxerror(fmt::format(FY("The file '{0}' could not be opened for reading and writing, or a read/write operation on it failed: {1}.\n"), options->m_file_name, ex));
@@ -171,6 +174,9 @@ run(options_cptr &options) {
         display_update_element_result(EBML_INFO(libmatroska::KaxTracks).GetName(), result);
 
       update_ebml_head(analyzer->get_file());
+
+      // Updates the cached layout now that all changes have been written.
+      analyzer->close_file();
     } catch (mtx::exception &ex) {
       mxerror(fmt::format(FY("The file '{0}' could not be opened for reading and writing, or a read/write operation on it failed: {1}.\n"), options->m_file_name, ex));
     } catch (...) {
@@ -41,6 +41,11 @@ propedit_cli_parser_c::set_parse_mode() {
   }
 }
 
+void
+propedit_cli_parser_c::set_cache_analysis() {
+  m_options->m_use_analysis_cache = true;
+}
+
 void
 propedit_cli_parser_c::add_target() {
   try {
@@ -243,6 +248,7 @@ propedit_cli_parser_c::init_parser() {
   add_option("l|list-property-names",         std::bind(&propedit_cli_parser_c::list_property_names,           this), YT("List all valid property names and exit"));
   add_option("p|parse-mode=<mode>",           std::bind(&propedit_cli_parser_c::set_parse_mode,                this), YT("Sets the Matroska parser mode to 'fast' (default) or 'full'"));
   add_option("enable-legacy-font-mime-types", std::bind(&propedit_cli_parser_c::enable_legacy_font_mime_types, this), YT("Use legacy font MIME types when adding new attachments or replacing existing ones"));
+  add_option("cache-analysis",                std::bind(&propedit_cli_parser_c::set_cache_analysis,            this), YT("Keep the layout of the file's top-level elements in a cache in the application data folder and re-use it on later runs if the file hasn't changed"));
 
   add_section_header(YT("Actions for handling properties"));
   add_option("e|edit=<selector>",  std::bind(&propedit_cli_parser_c::add_target, this), YT("Sets the Matroska file section that all following add/set/delete actions operate on (see below and man page for syntax)"));
@@ -37,6 +37,7 @@ protected:
   void add_chapters();
   void set_chapter_charset();
   void set_parse_mode();
+  void set_cache_analysis();
   void set_file_name();
   void disable_language_ietf();
   void enable_legacy_font_mime_types();
@@ -11,27 +11,29 @@
 #include "common/common_pch.h"
 
 #include "common/bswap.h"
+#include "common/checksums/batch.h"
 #include "common/checksums/crc.h"
 #include "common/command_line.h"
 #include "common/endian.h"
 #include "common/mm_io_x.h"
 #include "common/mm_file_io.h"
 #include "common/strings/parsing.h"
+#include "common/thread_pool.h"
 
 class cli_options_c {
 public:
-  std::string m_file_name;
+  std::vector<std::string> m_file_names;
   mtx::checksum::algorithm_e m_algorithm{mtx::checksum::algorithm_e::adler32};
-  size_t m_chunk_size{4096};
+  size_t m_chunk_size{4096}, m_num_threads{1};
   uint64_t m_initial_value{}, m_xor_result{};
-  bool m_result_in_le{};
+  bool m_result_in_le{}, m_per_chunk{};
 };
 
 static void
 setup_help() {
-  mtx::cli::g_usage_text = "checksum [options] file_name\n"
+  mtx::cli::g_usage_text = "checksum [options] file_name [file_name ...]\n"
                            "\n"
-                           "Calculates a checksum of a file. Used for testing MKVToolNix' checksumming\n"
+                           "Calculates a checksum of each file. Used for testing MKVToolNix' checksumming\n"
                            "algorithms. The defaults are:\n"
                            "- Algorithm: Adler-32\n"
                            "- Chunk size 4096\n"
@@ -58,6 +60,11 @@ setup_help() {
                            "                         (default: 0)\n"
                            "  --result-in-le         Output the result in Little Endian (default:\n"
                            "                         Big Endian)\n"
+                           "  --per-chunk            Output one checksum for each chunk of \"size\" bytes\n"
+                           "                         instead of one for the whole file\n"
+                           "  --threads n            Checksum up to n files in parallel, or up to n\n"
+                           "                         chunks with --per-chunk; the results are still\n"
+                           "                         output in order (default: 1)\n"
                            "\n"
                            "General options:\n"
                            "\n"
@@ -128,37 +135,69 @@ parse_args(std::vector<std::string> &args) {
 
       ++current;
 
+    } else if (arg == "--threads") {
+      if (next_arg.empty())
+        mxerror(fmt::format("Missing argument to {0}\n", arg));
+
+      if (!mtx::string::parse_number(next_arg, options.m_num_threads) || !options.m_num_threads)
+        mxerror(fmt::format("Invalid argument to {0}: {1}\n", arg, next_arg));
+
+      ++current;
+
     } else if (arg == "--result-in-le")
       options.m_result_in_le = true;
 
-    else if (!options.m_file_name.empty())
-      mxerror("More than one source file was given.\n");
+    else if (arg == "--per-chunk")
+      options.m_per_chunk = true;
 
     else
-      options.m_file_name = arg;
+      options.m_file_names.emplace_back(arg);
   }
 
-  if (options.m_file_name.empty())
+  if (options.m_file_names.empty())
     mxerror("No file name given\n");
 
   return options;
 }
 
 static void
-parse_file(cli_options_c const &options) {
-  mm_file_io_c in{options.m_file_name};
+setup_worker(cli_options_c const &options,
+             mtx::checksum::base_c &worker) {
+  auto crc_worker = dynamic_cast<mtx::checksum::crc_base_c *>(&worker);
+  if (!crc_worker)
+    return;
+
+  crc_worker->set_initial_value(options.m_initial_value);
+  crc_worker->set_xor_result(options.m_xor_result);
+  crc_worker->set_result_in_le(options.m_result_in_le);
+}
+
+static std::string
+format_result(memory_c const &result) {
+  auto ptr      = result.get_buffer();
+  auto res_size = result.get_size();
+  std::string output;
+
+  for (auto idx = 0u; idx < res_size; idx++)
+    output += fmt::format("{0:02x}", static_cast<unsigned int>(ptr[idx]));
+
+  return output;
+}
+
+// Runs on a worker thread if more than one thread is used. Errors are
+// therefore reported by throwing exceptions which the main thread turns
+// into error messages.
+static std::string
+parse_file(cli_options_c const &options,
+           std::string const &file_name) {
+  mm_file_io_c in{file_name};
   auto file_size  = in.get_size();
   auto chunk_size = !options.m_chunk_size ? file_size : std::min<int64_t>(file_size, options.m_chunk_size);
   auto total_read = 0ll;
   auto buffer     = memory_c::alloc(chunk_size);
   auto worker     = mtx::checksum::for_algorithm(options.m_algorithm);
-  auto crc_worker = dynamic_cast<mtx::checksum::crc_base_c *>(worker.get());
 
-  if (crc_worker) {
-    crc_worker->set_initial_value(options.m_initial_value);
-    crc_worker->set_xor_result(options.m_xor_result);
-    crc_worker->set_result_in_le(options.m_result_in_le);
-  }
+  setup_worker(options, *worker);
 
   while (total_read < file_size) {
     auto remaining = file_size - total_read;
@@ -167,22 +206,111 @@ parse_file(cli_options_c const &options) {
     total_read    += num_read;
 
     if (num_read != chunk_size)
-      mxerror("Could not read the file.\n");
+      throw std::runtime_error{"Could not read the file.\n"};
 
     worker->add(buffer->get_buffer(), chunk_size);
   }
 
   worker->finish();
 
-  auto result   = worker->get_result();
-  auto ptr      = result->get_buffer();
-  auto res_size = result->get_size();
-  std::string output;
+  return fmt::format("{0}  {1}\n", format_result(*worker->get_result()), file_name);
+}
 
-  for (auto idx = 0u; idx < res_size; idx++)
-    output += fmt::format("{0:02x}", static_cast<unsigned int>(ptr[idx]));
+// The chunks are read on the main thread and handed to the batch engine
+// which spreads them across the pool. Only a limited number of chunks is
+// kept in memory at the same time.
+static void
+parse_file_per_chunk(cli_options_c const &options,
+                     std::string const &file_name,
+                     mtx::thread_pool_c *pool) {
+  mm_file_io_c in{file_name};
+  auto file_size        = in.get_size();
+  auto chunk_size       = !options.m_chunk_size ? file_size : std::min<int64_t>(file_size, options.m_chunk_size);
+  auto chunks_per_round = std::max<std::size_t>(options.m_num_threads, 2 * options.m_num_threads * mtx::checksum::batch_c::s_default_batch_size / std::max<int64_t>(chunk_size, 1));
+  auto position         = 0ll;
+
+  mtx::checksum::batch_c batch{options.m_algorithm, pool, options.m_initial_value};
+  batch.set_worker_setup([&options](mtx::checksum::base_c &worker) { setup_worker(options, worker); });
+
+  std::vector<memory_cptr> chunks;
+
+  while (position < file_size) {
+    auto round_start = position;
+
+    chunks.clear();
 
-  mxinfo(fmt::format("{0}  {1}\n", output, options.m_file_name));
+    while ((position < file_size) && (chunks.size() < chunks_per_round)) {
+      auto size   = std::min<int64_t>(chunk_size, file_size - position);
+      auto buffer = memory_c::alloc(size);
+
+      if (in.read(buffer, size) != static_cast<uint64_t>(size))
+        throw std::runtime_error{"Could not read the file.\n"};
+
+      batch.add(*buffer);
+      chunks.emplace_back(buffer);
+      position += size;
+    }
+
+    auto results = batch.get_results();
+
+    for (auto idx = 0u; idx < results.size(); ++idx)
+      mxinfo(fmt::format("{0}  {1} @ {2}\n", format_result(*results[idx]), file_name, round_start + idx * chunk_size));
+  }
+}
+
+static void
+parse_files_per_chunk(cli_options_c const &options) {
+  std::unique_ptr<mtx::thread_pool_c> pool;
+
+  if (1 < options.m_num_threads)
+    pool = std::make_unique<mtx::thread_pool_c>(options.m_num_threads);
+
+  for (auto const &file_name : options.m_file_names) {
+    try {
+      parse_file_per_chunk(options, file_name, pool.get());
+
+    } catch (mtx::mm_io::exception &) {
+      mxerror("File not found\n");
+
+    } catch (std::runtime_error &ex) {
+      mxerror(ex.what());
+    }
+  }
+}
+
+static void
+parse_files(cli_options_c const &options) {
+  if (options.m_per_chunk) {
+    parse_files_per_chunk(options);
+    return;
+  }
+
+  std::unique_ptr<mtx::thread_pool_c> pool;
+  std::vector<std::future<std::string>> results;
+
+  if (1 < options.m_num_threads)
+    pool = std::make_unique<mtx::thread_pool_c>(std::min(options.m_num_threads, options.m_file_names.size()));
+
+  // Without a pool each file is only checksummed when its result is
+  // output.
+  for (auto const &file_name : options.m_file_names) {
+    auto task = [&options, &file_name]() { return parse_file(options, file_name); };
+    results.emplace_back(pool ? pool->submit(task) : std::async(std::launch::deferred, task));
+  }
+
+  // Output the results in the order the files were given in,
+  // independent of the order in which they were finished.
+  for (auto &result : results) {
+    try {
+      mxinfo(result.get());
+
+    } catch (mtx::mm_io::exception &) {
+      mxerror("File not found\n");
+
+    } catch (std::runtime_error &ex) {
+      mxerror(ex.what());
+    }
+  }
 }
 
 int
@@ -197,11 +325,7 @@ main(int argc,
 
   auto options = parse_args(args);
 
-  try {
-    parse_file(options);
-  } catch (mtx::mm_io::exception &) {
-    mxerror("File not found\n");
-  }
+  parse_files(options);
 
   mxexit();
 }
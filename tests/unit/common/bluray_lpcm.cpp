@@ -0,0 +1,73 @@
+#include "common/common_pch.h"
+
+#include "common/bluray/lpcm.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+std::vector<uint8_t>
+create_random_data(std::size_t size,
+                   uint32_t state) {
+  std::vector<uint8_t> buffer(size);
+
+  for (auto &byte : buffer) {
+    state = state * 1103515245u + 12345u;
+    byte  = static_cast<uint8_t>(state >> 16);
+  }
+
+  return buffer;
+}
+
+TEST(BlurayLPCM, RemapChannels) {
+  // Two frames with 16-bit samples; each sample contains its channel
+  // number in both bytes.
+  std::vector<uint8_t> buffer;
+  for (auto frame = 0; frame < 2; ++frame)
+    for (uint8_t channel = 0; channel < 8; ++channel)
+      buffer.insert(buffer.end(), { channel, channel });
+
+  mtx::bluray::lpcm::remap_channels(buffer.data(), buffer.size(), 2, 8);
+
+  std::vector<uint8_t> expected;
+  for (auto frame = 0; frame < 2; ++frame)
+    for (uint8_t channel : { 0, 1, 2, 7, 4, 5, 3, 6 })
+      expected.insert(expected.end(), { channel, channel });
+
+  EXPECT_EQ(expected, buffer);
+}
+
+TEST(BlurayLPCM, RemapChannelsMatchesScalarImplementation) {
+  for (auto bytes_per_channel : { 2u, 3u, 4u })
+    for (auto num_channels : { 2u, 6u, 7u, 8u })
+      for (auto num_frames : { 0u, 1u, 2u, 3u, 5u, 100u }) {
+        auto size     = bytes_per_channel * num_channels * num_frames;
+        auto expected = create_random_data(size, size + num_channels);
+        auto actual   = expected;
+
+        mtx::bluray::lpcm::remap_channels_scalar(expected.data(), size, bytes_per_channel, num_channels);
+        mtx::bluray::lpcm::remap_channels(actual.data(), size, bytes_per_channel, num_channels);
+
+        EXPECT_EQ(expected, actual) << "bytes per channel " << bytes_per_channel << " channels " << num_channels << " frames " << num_frames;
+      }
+}
+
+TEST(BlurayLPCM, RemoveChannelsMatchesScalarImplementation) {
+  for (auto bytes_per_channel : { 2u, 3u, 4u })
+    for (auto num_input_channels : { 2u, 4u, 6u, 8u })
+      for (auto num_output_channels : { num_input_channels - 1, num_input_channels / 2 })
+        for (auto num_bytes : { 0u, 7u, 96u, 100u, 4800u }) {
+          auto expected = create_random_data(num_bytes, num_bytes + num_input_channels);
+          auto actual   = expected;
+
+          auto expected_size = mtx::bluray::lpcm::remove_channels_scalar(expected.data(), num_bytes, bytes_per_channel, num_input_channels, num_output_channels);
+          auto actual_size   = mtx::bluray::lpcm::remove_channels(actual.data(), num_bytes, bytes_per_channel, num_input_channels, num_output_channels);
+
+          expected.resize(expected_size);
+          actual.resize(actual_size);
+
+          EXPECT_EQ(expected, actual) << "bytes per channel " << bytes_per_channel << " channels " << num_input_channels << " -> " << num_output_channels << " bytes " << num_bytes;
+        }
+}
+
+}
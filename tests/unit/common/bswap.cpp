@@ -0,0 +1,56 @@
+#include "common/common_pch.h"
+
+#include "common/bswap.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+std::vector<uint8_t>
+create_random_data(std::size_t size,
+                   uint32_t state) {
+  std::vector<uint8_t> buffer(size);
+
+  for (auto &byte : buffer) {
+    state = state * 1103515245u + 12345u;
+    byte  = static_cast<uint8_t>(state >> 16);
+  }
+
+  return buffer;
+}
+
+TEST(ByteSwapping, SwapBuffer) {
+  std::vector<uint8_t> buffer{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 }, dst(6);
+
+  mtx::bytes::swap_buffer(buffer.data(), dst.data(), 6, 2);
+  EXPECT_EQ((std::vector<uint8_t>{ 0x02, 0x01, 0x04, 0x03, 0x06, 0x05 }), dst);
+
+  mtx::bytes::swap_buffer(buffer.data(), dst.data(), 6, 3);
+  EXPECT_EQ((std::vector<uint8_t>{ 0x03, 0x02, 0x01, 0x06, 0x05, 0x04 }), dst);
+
+  mtx::bytes::swap_buffer(buffer.data(), buffer.data(), 4, 4);
+  EXPECT_EQ((std::vector<uint8_t>{ 0x04, 0x03, 0x02, 0x01, 0x05, 0x06 }), buffer);
+
+  EXPECT_THROW(mtx::bytes::swap_buffer(buffer.data(), dst.data(), 5, 2), std::invalid_argument);
+}
+
+TEST(ByteSwapping, SwapBufferMatchesScalarImplementation) {
+  for (auto word_length : { 1u, 2u, 3u, 4u, 5u, 8u })
+    for (auto num_words : { 0u, 1u, 4u, 5u, 6u, 7u, 8u, 9u, 15u, 16u, 17u, 33u, 1000u }) {
+      auto size     = word_length * num_words;
+      auto src      = create_random_data(size, size + word_length);
+      auto expected = std::vector<uint8_t>(size);
+      auto actual   = std::vector<uint8_t>(size);
+
+      mtx::bytes::swap_buffer_scalar(src.data(), expected.data(), size, word_length);
+      mtx::bytes::swap_buffer(src.data(), actual.data(), size, word_length);
+
+      EXPECT_EQ(expected, actual) << "word length " << word_length << " number of words " << num_words;
+
+      mtx::bytes::swap_buffer(src.data(), src.data(), size, word_length);
+
+      EXPECT_EQ(expected, src) << "in place; word length " << word_length << " number of words " << num_words;
+    }
+}
+
+}
@@ -74,4 +74,51 @@ TEST(ByteBuffer, Prepend) {
   ASSERT_EQ("Hello world"s, s);
 }
 
+TEST(ByteBuffer, Detach) {
+  mtx::bytes::buffer_c b;
+
+  b.add(reinterpret_cast<unsigned char const *>("PES: Hello world"), 16);
+  b.remove(2);
+
+  auto buffer = b.get_buffer();
+  auto data   = b.detach(3);
+
+  ASSERT_EQ(0,              b.get_size());
+  ASSERT_EQ(11,             data->get_size());
+  ASSERT_EQ(buffer + 3,     data->get_buffer());
+  ASSERT_EQ("Hello world"s, data->to_string());
+
+  data->add(reinterpret_cast<unsigned char const *>("!"), 1);
+
+  ASSERT_EQ("Hello world!"s, data->to_string());
+
+  b.add(reinterpret_cast<unsigned char const *>("meow"), 4);
+
+  ASSERT_EQ("Hello world!"s, data->to_string());
+  ASSERT_EQ("meow"s, std::string(reinterpret_cast<char *>(b.get_buffer()), b.get_size()));
+}
+
+TEST(ByteBuffer, DetachSetOffsetAndSize) {
+  mtx::bytes::buffer_c b;
+
+  b.add(reinterpret_cast<unsigned char const *>("PES: Hello world"), 16);
+  b.remove(2);
+
+  auto data = b.detach(3);
+
+  data->set_offset(6);
+  data->set_size(10);
+
+  ASSERT_EQ(4,       data->get_size());
+  ASSERT_EQ("worl"s, data->to_string());
+
+  b.add(reinterpret_cast<unsigned char const *>("0123456789"), 10);
+  b.remove(4);
+
+  data = b.detach();
+  data->set_size(data->get_size() - 2);
+
+  ASSERT_EQ("4567"s, data->to_string());
+}
+
 }
@@ -1,9 +1,12 @@
 #include "common/common_pch.h"
 
 #include "common/checksums/base.h"
+#include "common/checksums/batch.h"
+#include "common/checksums/crc.h"
 #include "common/mm_file_io.h"
 #include "common/mm_proxy_io.h"
 #include "common/mm_text_io.h"
+#include "common/thread_pool.h"
 
 #include "tests/unit/init.h"
 #include "tests/unit/util.h"
@@ -136,4 +139,208 @@ TEST_F(ChecksumTest, FileChunked1000) {
   EXPECT_EQ(*m_data_md5, *calculate_bin(mtx::checksum::algorithm_e::md5,                       1000));
 }
 
+// Bit-by-bit reference implementations working on the same register
+// layout as crc_base_c: reflected CRCs directly, all others
+// byte-swapped within 32 bits.
+uint32_t
+reference_crc(mtx::checksum::algorithm_e algorithm,
+              uint32_t crc,
+              std::vector<uint8_t> const &data) {
+  using algorithm_e = mtx::checksum::algorithm_e;
+
+  if (algorithm == algorithm_e::crc32_ieee_le) {
+    for (auto byte : data) {
+      crc ^= byte;
+      for (auto bit = 0; bit < 8; ++bit)
+        crc = (crc >> 1) ^ (crc & 1 ? 0xedb88320u : 0u);
+    }
+
+    return crc;
+  }
+
+  auto [bits, poly] = algorithm == algorithm_e::crc8_atm    ? std::pair{  8u,       0x07u }
+                    : algorithm == algorithm_e::crc16_ansi  ? std::pair{ 16u,     0x8005u }
+                    : algorithm == algorithm_e::crc16_ccitt ? std::pair{ 16u,     0x1021u }
+                    : algorithm == algorithm_e::crc16_002d  ? std::pair{ 16u,     0x002du }
+                    :                                         std::pair{ 32u, 0x04c11db7u };
+
+  auto swap_32 = [](uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+  };
+
+  for (auto byte : data) {
+    // Undo the byte swapping: the lowest byte of the register enters the division next.
+    auto value = swap_32(crc);
+    value     ^= static_cast<uint32_t>(byte) << 24;
+
+    for (auto bit = 0; bit < 8; ++bit)
+      value = (value << 1) ^ (value & 0x80000000u ? poly << (32 - bits) : 0u);
+
+    crc = swap_32(value);
+  }
+
+  return crc;
+}
+
+TEST(Checksum, CrcMatchesReferenceImplementation) {
+  using algorithm_e = mtx::checksum::algorithm_e;
+
+  std::vector<uint8_t> data(5000);
+  uint32_t state = 0x2468ace0;
+
+  for (auto &byte : data) {
+    state = state * 1103515245u + 12345u;
+    byte  = state >> 16;
+  }
+
+  for (auto algorithm : { algorithm_e::crc8_atm, algorithm_e::crc16_ansi, algorithm_e::crc16_ccitt, algorithm_e::crc16_002d, algorithm_e::crc32_ieee, algorithm_e::crc32_ieee_le }) {
+    auto initial_value = algorithm == algorithm_e::crc32_ieee_le ? 0xffffffffu : algorithm == algorithm_e::crc32_ieee ? 0xffffffffu : 0u;
+
+    for (auto size : { 0u, 1u, 7u, 8u, 15u, 16u, 17u, 63u, 64u, 65u, 79u, 80u, 127u, 128u, 1000u, 4999u }) {
+      std::vector<uint8_t> piece{ data.begin(), data.begin() + size };
+
+      EXPECT_EQ(reference_crc(algorithm, initial_value, piece), mtx::checksum::calculate_as_uint(algorithm, piece.data(), piece.size(), initial_value))
+        << "algorithm " << static_cast<int>(algorithm) << " size " << size;
+    }
+  }
+}
+
+TEST(Checksum, Adler32MatchesReferenceImplementation) {
+  auto reference_adler32 = [](std::vector<uint8_t> const &data) {
+    uint32_t a = 1, b = 0;
+
+    for (auto byte : data) {
+      a = (a + byte) % 65521;
+      b = (b + a)    % 65521;
+    }
+
+    return (b << 16) | a;
+  };
+
+  std::vector<uint8_t> data(20000);
+  uint32_t state = 0x1234567;
+
+  for (auto &byte : data) {
+    state = state * 1103515245u + 12345u;
+    byte  = state >> 16;
+  }
+
+  // All bytes set to 0xff maximize the intermediate sums.
+  for (auto fill : { false, true }) {
+    if (fill)
+      std::fill(data.begin(), data.end(), 0xff);
+
+    for (auto size : { 0u, 1u, 100u, 5551u, 5552u, 5553u, 11104u, 11105u, 20000u }) {
+      std::vector<uint8_t> piece{ data.begin(), data.begin() + size };
+
+      EXPECT_EQ(reference_adler32(piece), mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, piece.data(), piece.size())) << "fill " << fill << " size " << size;
+    }
+  }
+}
+
+TEST(Checksum, CrcParallelMatchesSequential) {
+  using algorithm_e = mtx::checksum::algorithm_e;
+
+  auto data = memory_c::alloc(3 * 1024 * 1024 + 11);
+  auto ptr  = data->get_buffer();
+  uint32_t state = 0x13579bdf;
+
+  for (auto idx = 0u; idx < data->get_size(); ++idx) {
+    state    = state * 1103515245u + 12345u;
+    ptr[idx] = state >> 16;
+  }
+
+  mtx::thread_pool_c pool{3};
+
+  for (auto algorithm : { algorithm_e::crc8_atm, algorithm_e::crc16_ansi, algorithm_e::crc16_ccitt, algorithm_e::crc16_002d, algorithm_e::crc32_ieee, algorithm_e::crc32_ieee_le, algorithm_e::adler32 }) {
+    auto sequential = mtx::checksum::for_algorithm(algorithm, 0xffffffffu);
+    auto parallel   = mtx::checksum::for_algorithm(algorithm, 0xffffffffu);
+
+    sequential->add(ptr, 1000).add(ptr + 1000, data->get_size() - 1000).finish();
+    parallel->add(ptr, 1000).add_parallel(ptr + 1000, data->get_size() - 1000, pool).finish();
+
+    EXPECT_EQ(*sequential->get_result(), *parallel->get_result()) << "algorithm " << static_cast<int>(algorithm);
+  }
+}
+
+TEST(Checksum, BatchMatchesIndividualCalculation) {
+  using algorithm_e = mtx::checksum::algorithm_e;
+
+  auto data = memory_c::alloc(200 * 1024);
+  auto ptr  = data->get_buffer();
+  uint32_t state = 0x0badf00d;
+
+  for (auto idx = 0u; idx < data->get_size(); ++idx) {
+    state    = state * 1103515245u + 12345u;
+    ptr[idx] = state >> 16;
+  }
+
+  // Frame-like buffers of varying sizes including empty ones.
+  std::vector<std::pair<std::size_t, std::size_t>> buffers;
+  for (auto pos = 0u, size = 0u; (pos + size) <= data->get_size(); pos += size, size = (size * 7 + 13) % 9000)
+    buffers.emplace_back(pos, size);
+
+  mtx::thread_pool_c pool{3};
+
+  for (auto algorithm : { algorithm_e::adler32, algorithm_e::crc32_ieee_le, algorithm_e::md5 }) {
+    for (auto use_pool : { false, true }) {
+      for (auto batch_size : { std::size_t{1}, std::size_t{10000}, mtx::checksum::batch_c::s_default_batch_size }) {
+        mtx::checksum::batch_c batch{algorithm, use_pool ? &pool : nullptr, 0, batch_size};
+
+        // Re-using the batch after retrieving the results must work.
+        for (auto round = 0; round < 2; ++round) {
+          for (auto idx = 0u; idx < buffers.size(); ++idx)
+            EXPECT_EQ(idx, batch.add(ptr + buffers[idx].first, buffers[idx].second));
+
+          auto results = batch.get_results();
+          ASSERT_EQ(buffers.size(), results.size());
+
+          for (auto idx = 0u; idx < buffers.size(); ++idx)
+            EXPECT_EQ(*mtx::checksum::calculate(algorithm, ptr + buffers[idx].first, buffers[idx].second), *results[idx])
+              << "algorithm " << static_cast<int>(algorithm) << " pool " << use_pool << " batch size " << batch_size << " buffer " << idx;
+        }
+      }
+    }
+  }
+
+  mtx::checksum::batch_c batch{algorithm_e::adler32, &pool};
+  batch.add(ptr, 1000);
+  batch.add(ptr + 1000, 0);
+
+  EXPECT_EQ((std::vector<uint64_t>{ mtx::checksum::calculate_as_uint(algorithm_e::adler32, ptr, 1000), 1u }), batch.get_results_as_uint());
+  EXPECT_TRUE(batch.get_results().empty());
+}
+
+TEST(Checksum, BatchAppliesWorkerSetup) {
+  auto setup = [](mtx::checksum::base_c &worker) {
+    auto &crc = dynamic_cast<mtx::checksum::crc_base_c &>(worker);
+    crc.set_xor_result(0xffffffffu);
+    crc.set_result_in_le(true);
+  };
+
+  std::string data{"Hello, world! 0123456789"};
+  auto ptr = reinterpret_cast<uint8_t const *>(data.c_str());
+
+  mtx::thread_pool_c pool{2};
+
+  for (auto use_pool : { false, true }) {
+    mtx::checksum::batch_c batch{mtx::checksum::algorithm_e::crc32_ieee_le, use_pool ? &pool : nullptr, 0xffffffffu, 8};
+    batch.set_worker_setup(setup);
+
+    batch.add(ptr, 10);
+    batch.add(ptr + 10, data.size() - 10);
+
+    auto results = batch.get_results();
+    ASSERT_EQ(2u, results.size());
+
+    for (auto idx = 0u; idx < 2; ++idx) {
+      auto worker = mtx::checksum::for_algorithm(mtx::checksum::algorithm_e::crc32_ieee_le, 0xffffffffu);
+      setup(*worker);
+      worker->add(ptr + idx * 10, !idx ? 10 : data.size() - 10).finish();
+
+      EXPECT_EQ(*worker->get_result(), *results[idx]) << "pool " << use_pool << " buffer " << idx;
+    }
+  }
+}
+
 }
@@ -0,0 +1,143 @@
+#include "common/common_pch.h"
+
+#include "common/compression.h"
+#include "common/thread_pool.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+memory_cptr
+create_frame(unsigned int idx) {
+  auto frame = memory_c::alloc(1000 + idx * 37);
+  auto ptr   = frame->get_buffer();
+
+  for (auto pos = 0u; pos < frame->get_size(); ++pos)
+    ptr[pos] = (pos / (idx + 3)) & 0xff;
+
+  return frame;
+}
+
+TEST(Compression, ZlibIsThreadSafe) {
+  EXPECT_TRUE(compressor_c::create(COMPRESSION_ZLIB)->is_thread_safe());
+  EXPECT_FALSE(compressor_c::create(COMPRESSION_MPEG4_P2)->is_thread_safe());
+}
+
+TEST(Compression, ZlibRoundTripInParallel) {
+  auto compressor = compressor_c::create(COMPRESSION_ZLIB);
+  mtx::thread_pool_c pool{4};
+  std::vector<std::future<memory_cptr>> results;
+
+  for (auto idx = 0u; idx < 64; ++idx)
+    results.emplace_back(pool.submit([compressor, idx]() {
+      return compressor->decompress(compressor->compress(create_frame(idx)));
+    }));
+
+  for (auto idx = 0u; idx < results.size(); ++idx)
+    EXPECT_TRUE(*create_frame(idx) == *results[idx].get());
+}
+
+#if defined(HAVE_ZSTD)
+
+TEST(Compression, ZstdRoundTrip) {
+  auto compressor = compressor_c::create(COMPRESSION_ZSTD);
+  compressor->set_parameters({ 19, false });
+
+  EXPECT_TRUE(compressor->is_thread_safe());
+
+  for (auto idx = 0u; idx < 16; ++idx) {
+    auto frame      = create_frame(idx);
+    auto compressed = compressor->compress(frame);
+
+    EXPECT_LT(compressed->get_size(), frame->get_size());
+    EXPECT_TRUE(*frame == *compressor->decompress(compressed));
+  }
+
+  EXPECT_FALSE(compressor->track_headers_changed());
+}
+
+TEST(Compression, ZstdDictionary) {
+  zstd_compressor_c compressor;
+  compressor.set_parameters({ {}, true });
+
+  EXPECT_FALSE(compressor.is_thread_safe());
+
+  std::vector<memory_cptr> frames, compressed;
+
+  for (auto idx = 0u; idx < 200; ++idx) {
+    auto line = fmt::format("Dialogue: 0,0:{0:02}:{1:02}.00,0:{0:02}:{1:02}.50,Default,,0,0,0,,Line number {2}", idx / 60, idx % 60, idx);
+
+    frames.emplace_back(memory_c::clone(line.data(), line.size()));
+    compressed.emplace_back(compressor.compress(frames.back()));
+  }
+
+  ASSERT_TRUE(!!compressor.get_dictionary());
+  EXPECT_TRUE(compressor.track_headers_changed());
+  EXPECT_FALSE(compressor.track_headers_changed());
+  EXPECT_TRUE(compressor.is_thread_safe());
+
+  // Frames compressed with the dictionary are smaller.
+  EXPECT_LT(compressed.back()->get_size(), compressed.front()->get_size());
+
+  // A decoder only knows the dictionary from the track headers.
+  zstd_compressor_c decompressor;
+  decompressor.set_dictionary(compressor.get_dictionary()->clone());
+
+  for (auto idx = 0u; idx < frames.size(); ++idx)
+    EXPECT_TRUE(*frames[idx] == *decompressor.decompress(compressed[idx]));
+}
+
+TEST(Compression, ZstdInvalidData) {
+  auto compressor = compressor_c::create(COMPRESSION_ZSTD);
+
+  EXPECT_THROW(compressor->decompress(create_frame(0)), mtx::compression_x);
+}
+
+// Like frames written by other applications in streaming mode.
+memory_cptr
+compress_without_content_size(memory_c const &frame) {
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  ZSTD_CCtx_setParameter(context.get(), ZSTD_c_contentSizeFlag, 0);
+
+  auto dst    = memory_c::alloc(ZSTD_compressBound(frame.get_size()));
+  auto result = ZSTD_compress2(context.get(), dst->get_buffer(), dst->get_size(), frame.get_buffer(), frame.get_size());
+
+  EXPECT_FALSE(ZSTD_isError(result));
+  dst->resize(result);
+
+  return dst;
+}
+
+TEST(Compression, ZstdWithoutContentSize) {
+  auto compressor = compressor_c::create(COMPRESSION_ZSTD);
+  auto frame      = create_frame(5);
+  auto compressed = compress_without_content_size(*frame);
+
+  EXPECT_EQ(ZSTD_CONTENTSIZE_UNKNOWN, ZSTD_getFrameContentSize(compressed->get_buffer(), compressed->get_size()));
+  EXPECT_TRUE(*frame == *compressor->decompress(compressed));
+
+  auto truncated = memory_c::clone(compressed->get_buffer(), compressed->get_size() - 1);
+
+  EXPECT_THROW(compressor->decompress(truncated), mtx::compression_x);
+}
+
+TEST(Compression, ZstdConcatenatedFrames) {
+  auto compressor = compressor_c::create(COMPRESSION_ZSTD);
+
+  for (auto with_content_size : { true, false }) {
+    auto first  = create_frame(1);
+    auto second = create_frame(2);
+    auto joined = with_content_size ? compressor->compress(first)->clone() : compress_without_content_size(*first);
+
+    joined->add(*(with_content_size ? compressor->compress(second) : compress_without_content_size(*second)));
+
+    auto expected = first->clone();
+    expected->add(*second);
+
+    EXPECT_TRUE(*expected == *compressor->decompress(joined)) << "content size " << with_content_size;
+  }
+}
+
+#endif  // HAVE_ZSTD
+
+}
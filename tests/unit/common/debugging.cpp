@@ -0,0 +1,31 @@
+#include "common/common_pch.h"
+
+#include "common/debugging.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+TEST(DebuggingOption, CachedValueFollowsRequests) {
+  debugging_option_c option{"unit_test_option"}, copy{option};
+
+  EXPECT_FALSE(option);
+  EXPECT_FALSE(copy);
+
+  debugging_c::request("unit_test_option");
+
+  EXPECT_TRUE(option);
+  EXPECT_TRUE(copy);
+
+  option.set(false);
+
+  EXPECT_FALSE(option);
+  EXPECT_FALSE(copy);
+
+  debugging_c::request("unit_test_option", false);
+  option.set(std::nullopt);
+
+  EXPECT_FALSE(option);
+}
+
+}
@@ -0,0 +1,91 @@
+#include "common/common_pch.h"
+
+#include "common/thread_pool.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+TEST(JsonOutputCapture, CapturesOutput) {
+  json_output_capture_c capture;
+
+  display_json_output(nlohmann::json{ { "file_name", "a.mkv" } });
+
+  ASSERT_TRUE(!!capture.m_output);
+  EXPECT_EQ("a.mkv"s, (*capture.m_output)["file_name"].get<std::string>());
+  EXPECT_TRUE((*capture.m_output)["warnings"].empty());
+  EXPECT_TRUE((*capture.m_output)["errors"].empty());
+}
+
+TEST(JsonOutputCapture, CapturesAreNested) {
+  json_output_capture_c outer;
+
+  {
+    json_output_capture_c inner;
+    display_json_output(nlohmann::json{ { "file_name", "inner.mkv" } });
+    EXPECT_TRUE(!!inner.m_output);
+  }
+
+  EXPECT_FALSE(!!outer.m_output);
+
+  display_json_output(nlohmann::json{ { "file_name", "outer.mkv" } });
+  ASSERT_TRUE(!!outer.m_output);
+  EXPECT_EQ("outer.mkv"s, (*outer.m_output)["file_name"].get<std::string>());
+}
+
+TEST(JsonOutputCapture, CapturesArePerThread) {
+  mtx::thread_pool_c threads{4};
+  std::vector<std::future<std::string>> results;
+
+  for (auto idx = 0; idx < 8; ++idx)
+    results.emplace_back(threads.submit([idx]() {
+      json_output_capture_c capture;
+      display_json_output(nlohmann::json{ { "file_name", fmt::format("{0}.mkv", idx) } });
+
+      return (*capture.m_output)["file_name"].get<std::string>();
+    }));
+
+  for (auto idx = 0; idx < 8; ++idx)
+    EXPECT_EQ(fmt::format("{0}.mkv", idx), results[idx].get());
+}
+
+TEST(JsonOutputCapture, OutputNamesFailedFiles) {
+  mtx::thread_pool_c threads{2};
+  std::vector<std::future<nlohmann::json>> results;
+
+  for (auto idx = 0; idx < 2; ++idx)
+    results.emplace_back(threads.submit([idx]() {
+      json_output_capture_c capture;
+      auto file_name = fmt::format("{0}.mkv", idx);
+
+      // The second file cannot be identified. The JSON error handler
+      // only outputs the warnings & errors.
+      if (idx == 0)
+        display_json_output(nlohmann::json{ { "container", { { "recognized", true } } } });
+
+      else {
+        capture.m_errors.emplace_back("unknown file type");
+        display_json_output(nlohmann::json{});
+      }
+
+      return capture.get_output({
+        { "identification_format_version", 42        },
+        { "file_name",                     file_name },
+      });
+    }));
+
+  auto identified = results[0].get();
+  auto failed     = results[1].get();
+
+  EXPECT_EQ("0.mkv"s, identified["file_name"].get<std::string>());
+  EXPECT_EQ(42,       identified["identification_format_version"].get<int>());
+  EXPECT_TRUE(identified["container"]["recognized"].get<bool>());
+  EXPECT_TRUE(identified["errors"].empty());
+
+  EXPECT_EQ("1.mkv"s, failed["file_name"].get<std::string>());
+  EXPECT_EQ(42,       failed["identification_format_version"].get<int>());
+  ASSERT_EQ(1u,       failed["errors"].size());
+  EXPECT_EQ("unknown file type"s, failed["errors"][0].get<std::string>());
+}
+
+}
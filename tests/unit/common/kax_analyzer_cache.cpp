@@ -0,0 +1,82 @@
+#include "common/common_pch.h"
+
+#include <cstdio>
+
+#include <matroska/KaxCluster.h>
+#include <matroska/KaxInfo.h>
+
+#include "common/kax_analyzer_cache.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+namespace cache = mtx::kax_analyzer_cache;
+
+class KaxAnalyzerCache: public ::testing::Test {
+protected:
+  std::string m_file_name;
+
+  virtual void
+  SetUp() override {
+    m_file_name = fmt::format("{0}/mtx_unit_kax_analyzer_cache_{1}", ::testing::TempDir(), reinterpret_cast<uintptr_t>(this));
+    write("some content");
+  }
+
+  virtual void
+  TearDown() override {
+    cache::forget(m_file_name);
+    std::remove(m_file_name.c_str());
+  }
+
+  void
+  write(std::string const &content) {
+    auto out = std::fopen(m_file_name.c_str(), "wb");
+    ASSERT_NE(nullptr, out);
+    ASSERT_EQ(content.size(), std::fwrite(content.c_str(), 1, content.size(), out));
+    std::fclose(out);
+  }
+
+  cache::entry_t
+  create_entry() {
+    cache::entry_t entry;
+
+    entry.m_segment_end = 1234;
+    entry.m_elements.emplace_back(kax_analyzer_data_c::create(EBML_ID(libmatroska::KaxInfo),    40,  100));
+    entry.m_elements.emplace_back(kax_analyzer_data_c::create(EBML_ID(libmatroska::KaxCluster), 140, -1, false));
+
+    return entry;
+  }
+};
+
+TEST_F(KaxAnalyzerCache, FindsStoredEntries) {
+  EXPECT_FALSE(cache::find(m_file_name));
+
+  cache::store(m_file_name, create_entry());
+
+  auto entry = cache::find(m_file_name);
+  ASSERT_TRUE(!!entry);
+  EXPECT_EQ(1234u, entry->m_segment_end);
+  EXPECT_EQ(12u,   entry->m_file_size);
+  ASSERT_EQ(2u,    entry->m_elements.size());
+  EXPECT_EQ(140u,  entry->m_elements[1]->m_pos);
+  EXPECT_FALSE(entry->m_elements[1]->m_size_known);
+}
+
+TEST_F(KaxAnalyzerCache, EntriesAreCopies) {
+  cache::store(m_file_name, create_entry());
+
+  cache::find(m_file_name)->m_elements[0]->m_pos = 99;
+
+  EXPECT_EQ(40u, cache::find(m_file_name)->m_elements[0]->m_pos);
+}
+
+TEST_F(KaxAnalyzerCache, ModifiedFilesAreNotFound) {
+  cache::store(m_file_name, create_entry());
+
+  write("other content");
+
+  EXPECT_FALSE(cache::find(m_file_name));
+}
+
+}
@@ -214,6 +214,21 @@ TEST(Memory, AddNothing) {
   ASSERT_EQ("0123456"s, buffer->to_string());
 }
 
+TEST(Memory, ResizeWithOffset) {
+  auto buffer = memory_c::clone("0123456789");
+
+  buffer->set_offset(3);
+  buffer->resize(10);
+
+  ASSERT_EQ(10,         buffer->get_size());
+  ASSERT_EQ("3456789"s, buffer->to_string().substr(0, 7));
+
+  buffer->resize(4);
+
+  ASSERT_EQ(4,       buffer->get_size());
+  ASSERT_EQ("3456"s, buffer->to_string());
+}
+
 TEST(Memory, Prepend) {
   auto buffer1 = memory_c::clone("0123456");
   auto buffer2 = memory_c::clone("789");
@@ -0,0 +1,133 @@
+#include "common/common_pch.h"
+
+#include "common/memory.h"
+#include "common/memory_pool.h"
+#include "common/thread_pool.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+using pool_c = mtx::mem::pool_c;
+
+TEST(MemoryPool, SizeClasses) {
+  EXPECT_EQ(0u,  pool_c::size_class_for(0).value());
+  EXPECT_EQ(0u,  pool_c::size_class_for(1).value());
+  EXPECT_EQ(0u,  pool_c::size_class_for(64).value());
+  EXPECT_EQ(1u,  pool_c::size_class_for(65).value());
+  EXPECT_EQ(4u,  pool_c::size_class_for(1024).value());
+  EXPECT_EQ(5u,  pool_c::size_class_for(1025).value());
+  EXPECT_EQ(15u, pool_c::size_class_for(pool_c::max_block_size).value());
+  EXPECT_FALSE(pool_c::size_class_for(pool_c::max_block_size + 1));
+
+  EXPECT_EQ(pool_c::min_block_size, pool_c::block_size_for(0));
+  EXPECT_EQ(pool_c::max_block_size, pool_c::block_size_for(pool_c::num_size_classes - 1));
+}
+
+TEST(MemoryPool, BlocksAreReused) {
+  pool_c pool;
+  std::size_t capacity{};
+
+  auto block = pool.allocate(3000, capacity);
+  EXPECT_EQ(4096u, capacity);
+  EXPECT_EQ(1u, pool.get_statistics(6).misses);
+
+  pool.release(block, capacity);
+  EXPECT_EQ(1u, pool.get_statistics(6).returned);
+
+  EXPECT_EQ(block, pool.allocate(2049, capacity));
+  EXPECT_EQ(1u, pool.get_statistics(6).hits);
+
+  pool.release(block, capacity);
+}
+
+TEST(MemoryPool, OversizedBlocks) {
+  pool_c pool;
+  std::size_t capacity{1};
+
+  auto block = pool.allocate(pool_c::max_block_size + 1, capacity);
+  EXPECT_EQ(0u, capacity);
+  EXPECT_EQ(1u, pool.get_num_oversized());
+
+  pool.release(block, capacity);
+
+  for (auto idx = 0u; idx < pool_c::num_size_classes; ++idx)
+    EXPECT_EQ(0u, pool.get_statistics(idx).returned);
+}
+
+TEST(MemoryPool, NumberOfCachedBlocksIsLimited) {
+  pool_c pool;
+  std::size_t capacity{};
+  std::vector<void *> blocks;
+
+  for (auto idx = 0; idx < 10; ++idx)
+    blocks.push_back(pool.allocate(pool_c::max_block_size, capacity));
+
+  for (auto block : blocks)
+    pool.release(block, capacity);
+
+  auto stats = pool.get_statistics(pool_c::num_size_classes - 1);
+
+  EXPECT_EQ(10u, stats.misses);
+  EXPECT_EQ(2u,  stats.returned);
+  EXPECT_EQ(8u,  stats.discarded);
+}
+
+TEST(MemoryPool, MemoryResizingWithinCapacity) {
+  auto mem    = memory_c::alloc(100);
+  auto buffer = mem->get_buffer();
+
+  std::memset(buffer, 'x', 100);
+
+  mem->resize(128);
+  EXPECT_EQ(buffer, mem->get_buffer());
+  EXPECT_EQ(128u, mem->get_size());
+
+  mem->resize(129);
+  EXPECT_EQ(129u, mem->get_size());
+  EXPECT_EQ(std::string(100, 'x'), mem->to_string().substr(0, 100));
+
+  mem->set_offset(10);
+  mem->resize(200000);
+  EXPECT_EQ(200000u, mem->get_size());
+  EXPECT_EQ(std::string(90, 'x'), mem->to_string().substr(0, 90));
+}
+
+TEST(MemoryPool, LockedBuffersCanBeFreed) {
+  auto mem    = memory_c::clone("hello world");
+  auto buffer = mem->get_buffer();
+
+  mem->lock();
+  mem.reset();
+
+  EXPECT_EQ(std::string{"hello world"}, std::string(reinterpret_cast<char *>(buffer), 11));
+
+  free(buffer);
+}
+
+TEST(MemoryPool, ConcurrentUse) {
+  mtx::thread_pool_c threads{4};
+  std::vector<std::future<bool>> results;
+
+  for (auto thread_idx = 0; thread_idx < 4; ++thread_idx)
+    results.emplace_back(threads.submit([thread_idx]() {
+      auto ok = true;
+
+      for (auto idx = 0; idx < 2000; ++idx) {
+        auto size = static_cast<std::size_t>((idx * 37 + thread_idx * 101) % 20000);
+        auto mem  = memory_c::alloc(size);
+
+        std::memset(mem->get_buffer(), thread_idx, size);
+        auto copy = mem->clone();
+
+        ok = ok && (*copy == *mem);
+      }
+
+      return ok;
+    }));
+
+  for (auto &result : results)
+    EXPECT_TRUE(result.get());
+}
+
+}
@@ -0,0 +1,120 @@
+#include "common/common_pch.h"
+
+#include <cstdio>
+
+#include "common/mm_io_x.h"
+#include "common/mm_mmap_io.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+class MmMmapIo: public ::testing::Test {
+protected:
+  std::string m_file_name, m_content;
+
+  virtual void
+  SetUp() override {
+    if (!mm_mmap_io_c::is_supported())
+      GTEST_SKIP();
+
+    m_file_name = fmt::format("{0}/mtx_unit_mm_mmap_io_{1}", ::testing::TempDir(), reinterpret_cast<uintptr_t>(this));
+
+    for (auto idx = 0; idx < 1000; ++idx)
+      m_content += fmt::format("line {0}\n", idx);
+
+    auto out = std::fopen(m_file_name.c_str(), "wb");
+    ASSERT_NE(nullptr, out);
+    ASSERT_EQ(m_content.size(), std::fwrite(m_content.c_str(), 1, m_content.size(), out));
+    std::fclose(out);
+  }
+
+  virtual void
+  TearDown() override {
+    if (!m_file_name.empty())
+      std::remove(m_file_name.c_str());
+  }
+};
+
+TEST_F(MmMmapIo, ReadingAndSeeking) {
+  mm_mmap_io_c in{m_file_name};
+
+  EXPECT_EQ(static_cast<int64_t>(m_content.size()), in.get_size());
+  EXPECT_EQ(m_file_name, in.get_file_name());
+
+  std::string buffer(17, '\0');
+  EXPECT_EQ(17u, in.read(buffer.data(), 17));
+  EXPECT_EQ(m_content.substr(0, 17), buffer);
+  EXPECT_EQ(17u, in.getFilePointer());
+
+  in.setFilePointer(-10, libebml::seek_end);
+  EXPECT_EQ(m_content.size() - 10, in.getFilePointer());
+  EXPECT_FALSE(in.eof());
+
+  EXPECT_EQ(10u, in.read(buffer.data(), 17));
+  EXPECT_EQ(m_content.substr(m_content.size() - 10), buffer.substr(0, 10));
+  EXPECT_TRUE(in.eof());
+
+  in.clear_eof();
+  in.setFilePointer(-20, libebml::seek_current);
+  EXPECT_EQ(m_content.size() - 20, in.getFilePointer());
+  EXPECT_FALSE(in.eof());
+
+  EXPECT_THROW(in.setFilePointer(-1), mtx::mm_io::seek_x);
+  EXPECT_THROW(in.write("x", 1), mtx::mm_io::wrong_read_write_access_x);
+}
+
+TEST_F(MmMmapIo, ZeroCopyReading) {
+  memory_cptr chunk;
+
+  {
+    mm_mmap_io_c in{m_file_name};
+
+    in.setFilePointer(100);
+    chunk = in.read_zero_copy(200);
+
+    EXPECT_FALSE(chunk->is_owned());
+    EXPECT_EQ(300u, in.getFilePointer());
+
+    in.setFilePointer(-5, libebml::seek_end);
+    EXPECT_THROW(in.read_zero_copy(6), mtx::mm_io::end_of_file_x);
+    EXPECT_TRUE(in.eof());
+
+    in.close();
+  }
+
+  // The mapping must stay alive as long as slices refer to it.
+  EXPECT_EQ(m_content.substr(100, 200), chunk->to_string());
+
+  // Modifying a slice must never reach the file.
+  chunk->get_buffer()[0] = 'X';
+
+  // The mapping is kept alive by the slice; taking ownership doesn't
+  // have to copy it.
+  auto buffer = chunk->get_buffer();
+  chunk->take_ownership();
+  EXPECT_FALSE(chunk->is_owned());
+  EXPECT_EQ(buffer, chunk->get_buffer());
+  EXPECT_EQ('X', chunk->get_buffer()[0]);
+
+  mm_mmap_io_c in{m_file_name};
+  EXPECT_EQ(m_content.substr(100, 200), in.read_zero_copy(200 + 100)->to_string().substr(100));
+}
+
+TEST_F(MmMmapIo, FallsBackForUnmappableFiles) {
+  auto empty_file_name = m_file_name + ".empty";
+  std::fclose(std::fopen(empty_file_name.c_str(), "wb"));
+
+  EXPECT_THROW(mm_mmap_io_c{empty_file_name}, mtx::mm_io::open_x);
+
+  auto in = mm_mmap_io_c::open(empty_file_name);
+  EXPECT_EQ(nullptr, dynamic_cast<mm_mmap_io_c *>(in.get()));
+  EXPECT_EQ(0, in->get_size());
+
+  in.reset();
+  std::remove(empty_file_name.c_str());
+
+  EXPECT_NE(nullptr, dynamic_cast<mm_mmap_io_c *>(mm_mmap_io_c::open(m_file_name).get()));
+}
+
+}
@@ -0,0 +1,112 @@
+#include "common/common_pch.h"
+
+#include "common/mm_io_x.h"
+#include "common/mm_mem_io.h"
+#include "common/mm_write_buffer_io.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+std::string
+write_test_data(std::size_t buffer_size,
+                std::size_t num_async_buffers) {
+  auto mem_io = std::make_shared<mm_mem_io_c>(nullptr, 0, 1024);
+  auto data   = std::string{};
+
+  mm_write_buffer_io_c out{mem_io, buffer_size, num_async_buffers};
+
+  for (auto idx = 0; idx < 1000; ++idx)
+    data += fmt::format("line {0}\n", idx);
+
+  out.write(data.c_str(), 17);
+  EXPECT_EQ(17u, out.getFilePointer());
+
+  out.write(data.c_str() + 17, data.size() - 17);
+  EXPECT_EQ(data.size(), out.getFilePointer());
+
+  // Overwrite something that has already been handed over.
+  out.setFilePointer(5);
+  out.write("ABCDEFGH", 8);
+  EXPECT_EQ(13u, out.getFilePointer());
+
+  out.setFilePointer(0, libebml::seek_end);
+  EXPECT_EQ(data.size(), out.getFilePointer());
+
+  out.write(data.c_str(), 100);
+  out.setFilePointer(-50, libebml::seek_current);
+  out.write("ijklmnop", 8);
+
+  out.flush();
+
+  return mem_io->get_content();
+}
+
+// Fails the second write only.
+class failing_mem_io_c: public mm_mem_io_c {
+public:
+  unsigned int m_num_writes{};
+
+  failing_mem_io_c()
+    : mm_mem_io_c{nullptr, 0, 1024}
+  {
+  }
+
+protected:
+  virtual size_t
+  _write(const void *buffer,
+         size_t size) override {
+    if (++m_num_writes == 2)
+      throw mtx::mm_io::insufficient_space_x();
+
+    return mm_mem_io_c::_write(buffer, size);
+  }
+};
+
+TEST(MmWriteBufferIo, AsynchronousWritingIsIdentical) {
+  auto expected = write_test_data(64, 0);
+
+  EXPECT_EQ(expected, write_test_data(64,   2));
+  EXPECT_EQ(expected, write_test_data(64,   4));
+  EXPECT_EQ(expected, write_test_data(1,    3));
+  EXPECT_EQ(expected, write_test_data(7,    2));
+  EXPECT_EQ(expected, write_test_data(4096, 2));
+  EXPECT_EQ(expected, write_test_data(7,    1));
+}
+
+TEST(MmWriteBufferIo, AsynchronousWritingStopsAfterError) {
+  auto mem_io = std::make_shared<failing_mem_io_c>();
+  auto data   = std::string(64 * 10, 'x');
+
+  mm_write_buffer_io_c out{mem_io, 64, 3};
+
+  EXPECT_THROW({
+    out.write(data.c_str(), data.size());
+    out.flush();
+  }, mtx::mm_io::exception);
+
+  // Nothing after the failed buffer has been written.
+  EXPECT_EQ(std::string(64, 'x'), mem_io->get_content());
+
+  // The error is reported again.
+  EXPECT_THROW(out.write(data.c_str(), 64), mtx::mm_io::exception);
+  EXPECT_THROW(out.flush(),                 mtx::mm_io::exception);
+}
+
+TEST(MmWriteBufferIo, DestructorDoesNotThrowWriteErrors) {
+  auto mem_io = std::make_shared<failing_mem_io_c>();
+  auto data   = std::string(64 * 10, 'x');
+
+  {
+    mm_write_buffer_io_c out{mem_io, 64, 3};
+
+    try {
+      out.write(data.c_str(), data.size());
+    } catch (mtx::mm_io::exception &) {
+    }
+  }
+
+  EXPECT_EQ(2u, mem_io->m_num_writes);
+}
+
+}
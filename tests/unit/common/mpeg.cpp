@@ -0,0 +1,151 @@
+#include "common/common_pch.h"
+
+#include "common/mpeg.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+// Byte-by-byte reference implementations of the conversion functions.
+std::vector<uint8_t>
+nalu_to_rbsp_reference(std::vector<uint8_t> const &src) {
+  std::vector<uint8_t> dest;
+
+  for (std::size_t pos = 0; pos < src.size(); ++pos) {
+    dest.push_back(src[pos]);
+
+    if (((pos + 2) < src.size()) && !src[pos] && !src[pos + 1] && (src[pos + 2] == 3)) {
+      dest.push_back(0);
+      pos += 2;
+    }
+  }
+
+  return dest;
+}
+
+std::vector<uint8_t>
+rbsp_to_nalu_reference(std::vector<uint8_t> const &src) {
+  std::vector<uint8_t> dest;
+
+  for (std::size_t pos = 0; pos < src.size(); ++pos) {
+    if (((pos + 2) < src.size()) && !src[pos] && !src[pos + 1] && (src[pos + 2] <= 3)) {
+      dest.insert(dest.end(), { 0, 0, 3 });
+      ++pos;
+
+    } else
+      dest.push_back(src[pos]);
+  }
+
+  return dest;
+}
+
+std::vector<uint8_t>
+to_vector(memory_cptr const &mem) {
+  return { mem->get_buffer(), mem->get_buffer() + mem->get_size() };
+}
+
+std::vector<uint8_t>
+create_random_data(std::size_t size,
+                   uint32_t state) {
+  std::vector<uint8_t> buffer(size);
+
+  for (auto &byte : buffer) {
+    state = state * 1103515245u + 12345u;
+    auto r = (state >> 16) % 8;
+    byte   = r < 4 ? 0x00 : r < 6 ? static_cast<uint8_t>((state >> 8) & 0x03) : static_cast<uint8_t>(state >> 8);
+  }
+
+  return buffer;
+}
+
+TEST(MPEG, FindStartCode) {
+  std::vector<uint8_t> buffer(100, 0xff);
+
+  EXPECT_EQ(buffer.data() + buffer.size(), mtx::mpeg::find_start_code(buffer.data(), buffer.data() + buffer.size()));
+  EXPECT_EQ(buffer.data(),                 mtx::mpeg::find_start_code(buffer.data(), buffer.data()));
+
+  buffer[40] = 0x00;
+  buffer[41] = 0x00;
+  buffer[42] = 0x01;
+
+  EXPECT_EQ(buffer.data() + 40, mtx::mpeg::find_start_code(buffer.data(),      buffer.data() + buffer.size()));
+  EXPECT_EQ(buffer.data() + 40, mtx::mpeg::find_start_code(buffer.data() + 40, buffer.data() + 43));
+  EXPECT_EQ(buffer.data() + 42, mtx::mpeg::find_start_code(buffer.data() + 40, buffer.data() + 42));
+  EXPECT_EQ(buffer.data() + 99, mtx::mpeg::find_start_code(buffer.data() + 41, buffer.data() + 99));
+
+  buffer[39] = 0x00;
+
+  EXPECT_EQ(buffer.data() + 40, mtx::mpeg::find_start_code(buffer.data(), buffer.data() + buffer.size()));
+
+  buffer[97] = 0x00;
+  buffer[98] = 0x00;
+  buffer[99] = 0x01;
+
+  EXPECT_EQ(buffer.data() + 97, mtx::mpeg::find_start_code(buffer.data() + 41, buffer.data() + buffer.size()));
+}
+
+TEST(MPEG, FindStartCodeMatchesScalarImplementation) {
+  std::vector<uint8_t> buffer(1000);
+  uint32_t state = 0x12345678;
+
+  for (auto &byte : buffer) {
+    state = state * 1103515245u + 12345u;
+    auto r = (state >> 16) % 8;
+    byte   = r < 3 ? 0x00 : r < 5 ? 0x01 : static_cast<uint8_t>(state >> 8);
+  }
+
+  auto const end = buffer.data() + buffer.size();
+
+  for (auto start = buffer.data(); start < end; ++start)
+    for (auto stop = start; stop <= std::min(start + 70, end); ++stop)
+      ASSERT_EQ(mtx::mpeg::find_start_code_scalar(start, stop), mtx::mpeg::find_start_code(start, stop));
+}
+
+TEST(MPEG, NaluToRbsp) {
+  std::vector<uint8_t> nalu{ 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03 };
+  std::vector<uint8_t> rbsp{ 0x01, 0x00, 0x00,       0x00, 0x00,       0x01, 0x00, 0x00, 0x00,       0x03, 0x00, 0x00       };
+
+  EXPECT_EQ(rbsp, to_vector(mtx::mpeg::nalu_to_rbsp(memory_c::clone(nalu.data(), nalu.size()))));
+
+  auto clean = memory_c::clone(rbsp.data(), 5);
+  EXPECT_EQ(clean, mtx::mpeg::nalu_to_rbsp(clean));
+}
+
+TEST(MPEG, NaluToRbspPrefix) {
+  std::vector<uint8_t> nalu{ 0x01, 0x00, 0x00, 0x03, 0x02, 0x00, 0x00, 0x03, 0x04 };
+  auto mem = memory_c::clone(nalu.data(), nalu.size());
+
+  EXPECT_EQ((std::vector<uint8_t>{ 0x01, 0x00 }),                   to_vector(mtx::mpeg::nalu_to_rbsp(mem, 2)));
+  EXPECT_EQ((std::vector<uint8_t>{ 0x01, 0x00, 0x00 }),             to_vector(mtx::mpeg::nalu_to_rbsp(mem, 3)));
+  EXPECT_EQ((std::vector<uint8_t>{ 0x01, 0x00, 0x00 }),             to_vector(mtx::mpeg::nalu_to_rbsp(mem, 4)));
+  EXPECT_EQ((std::vector<uint8_t>{ 0x01, 0x00, 0x00, 0x02, 0x00 }), to_vector(mtx::mpeg::nalu_to_rbsp(mem, 6)));
+  EXPECT_EQ(nalu_to_rbsp_reference(nalu),                           to_vector(mtx::mpeg::nalu_to_rbsp(mem, 100)));
+
+  // A prefix without emulation prevention bytes refers to the original data.
+  EXPECT_EQ(mem->get_buffer(), mtx::mpeg::nalu_to_rbsp(mem, 3)->get_buffer());
+}
+
+TEST(MPEG, RbspToNalu) {
+  std::vector<uint8_t> rbsp{ 0x01, 0x00, 0x00,       0x00, 0x00,       0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 };
+  std::vector<uint8_t> nalu{ 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x03, 0x00 };
+
+  EXPECT_EQ(nalu, to_vector(mtx::mpeg::rbsp_to_nalu(memory_c::clone(rbsp.data(), rbsp.size()))));
+  EXPECT_EQ(0u,   mtx::mpeg::rbsp_to_nalu(memory_c::alloc(0))->get_size());
+}
+
+TEST(MPEG, ConversionsMatchReferenceImplementations) {
+  for (auto size : { 1u, 2u, 3u, 17u, 33u, 100u, 1000u, 10000u }) {
+    for (auto seed = 1u; seed <= 20; ++seed) {
+      auto data = create_random_data(size, seed * 4711);
+      auto mem  = memory_c::clone(data.data(), data.size());
+
+      ASSERT_EQ(nalu_to_rbsp_reference(data), to_vector(mtx::mpeg::nalu_to_rbsp(mem)));
+      ASSERT_EQ(rbsp_to_nalu_reference(data), to_vector(mtx::mpeg::rbsp_to_nalu(mem)));
+
+      auto prefix_size = std::min<std::size_t>(size, seed * 7);
+      ASSERT_EQ(nalu_to_rbsp_reference({ data.begin(), data.begin() + prefix_size }), to_vector(mtx::mpeg::nalu_to_rbsp(mem, prefix_size)));
+    }
+  }
+}
+
+}
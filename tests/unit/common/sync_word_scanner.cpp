@@ -0,0 +1,100 @@
+#include "common/common_pch.h"
+
+#include "common/sync_word_scanner.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+using pattern_t = mtx::sync_word_scanner_c::pattern_t;
+auto const npos = mtx::sync_word_scanner_c::npos;
+
+// Random data with a high density of bytes that match parts of the
+// sync words used below so that the verification of candidates is
+// exercised, too.
+std::vector<uint8_t>
+create_random_data(std::size_t size,
+                   uint32_t state) {
+  static uint8_t const s_interesting_bytes[] = { 0x0b, 0x77, 0x01, 0x10, 0xff, 0xf1, 0x56, 0xe0, 0x7f, 0xfe, 0x80, 0xf8, 0x72, 0x6f, 0xba, 'I', 'D', '3' };
+
+  std::vector<uint8_t> buffer(size);
+
+  for (auto &byte : buffer) {
+    state = state * 1103515245u + 12345u;
+    auto r = (state >> 16) % 4;
+    byte   = r < 3 ? s_interesting_bytes[(state >> 8) % sizeof(s_interesting_bytes)] : static_cast<uint8_t>(state >> 8);
+  }
+
+  return buffer;
+}
+
+TEST(SyncWordScanner, Find) {
+  std::vector<uint8_t> buffer(100, 0x00);
+  auto scanner = mtx::sync_word_scanner_c{ { 0x0b77, 0xffff, 2, 0 } };
+
+  EXPECT_EQ(npos, scanner.find(buffer.data(), buffer.size()));
+
+  buffer[57] = 0x0b;
+  buffer[58] = 0x77;
+  buffer[93] = 0x0b;
+  buffer[94] = 0x77;
+
+  EXPECT_EQ(57u,  scanner.find(buffer.data(), buffer.size()));
+  EXPECT_EQ(57u,  scanner.find(buffer.data(), buffer.size(), 57));
+  EXPECT_EQ(93u,  scanner.find(buffer.data(), buffer.size(), 58));
+  EXPECT_EQ(npos, scanner.find(buffer.data(), buffer.size(), 94));
+
+  // The pattern must fit into the buffer completely.
+  EXPECT_EQ(npos, scanner.find(buffer.data(), 94, 58));
+  EXPECT_EQ(npos, scanner.find(buffer.data(), 0));
+}
+
+TEST(SyncWordScanner, FindWithMasksAndOffsets) {
+  std::vector<uint8_t> buffer(200, 0x00);
+  auto scanner = mtx::sync_word_scanner_c{
+    { 0xfff000,   0xfff000,   3, 0 },
+    { 0xf8726fba, 0xfffffffe, 4, 4 },
+  };
+
+  buffer[150] = 0xff;
+  buffer[151] = 0xf1;
+  buffer[152] = 0x23;
+
+  EXPECT_EQ(150u, scanner.find(buffer.data(), buffer.size()));
+
+  buffer[44] = 0xf8;
+  buffer[45] = 0x72;
+  buffer[46] = 0x6f;
+  buffer[47] = 0xbb;
+
+  EXPECT_EQ(40u,  scanner.find(buffer.data(), buffer.size()));
+  EXPECT_EQ(150u, scanner.find(buffer.data(), buffer.size(), 41));
+
+  // Only the first two bytes match.
+  buffer[47] = 0xab;
+
+  EXPECT_EQ(150u, scanner.find(buffer.data(), buffer.size()));
+  EXPECT_FALSE(scanner.matches_at(buffer.data(), buffer.size(), 40));
+  EXPECT_TRUE(scanner.matches_at(buffer.data(), buffer.size(), 150));
+}
+
+TEST(SyncWordScanner, FindMatchesScalarImplementation) {
+  std::vector<mtx::sync_word_scanner_c> scanners{
+    { { 0x0b77,     0xffff,     2, 0 }, { 0x770b,     0xffff,     2, 0 }, { 0x0110,     0xffff,     2, 0 } },
+    { { 0x7ffe8001, 0xffffffff, 4, 0 }, { 0x64582025, 0xffffffff, 4, 0 } },
+    { { 0xfff000,   0xfff000,   3, 0 }, { 0x56e000,   0xffe000,   3, 0 } },
+    { { 0x494433,   0xffffff,   3, 0 }, { 0x544147,   0xffffff,   3, 0 }, { 0xffe0,     0xffe0,     2, 0 } },
+    { { 0x0b77,     0xffff,     2, 0 }, { 0xf8726fba, 0xffffffff, 4, 4 }, { 0xf8726fbb, 0xffffffff, 4, 4 } },
+    { { 0xff,       0xff,       1, 0 } },
+  };
+
+  for (auto const &scanner : scanners)
+    for (auto size : { 0u, 1u, 3u, 15u, 16u, 17u, 31u, 32u, 33u, 100u, 1000u }) {
+      auto buffer = create_random_data(size, size * 7 + 1);
+
+      for (auto start = 0u; start <= size; ++start)
+        EXPECT_EQ(scanner.find_scalar(buffer.data(), size, start), scanner.find(buffer.data(), size, start)) << "size " << size << " start " << start;
+    }
+}
+
+}
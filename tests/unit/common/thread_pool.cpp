@@ -0,0 +1,49 @@
+#include "common/common_pch.h"
+
+#include <atomic>
+
+#include "common/thread_pool.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+TEST(ThreadPool, NumThreads) {
+  EXPECT_EQ(3u, mtx::thread_pool_c{3}.get_num_threads());
+  EXPECT_EQ(mtx::thread_pool_c::default_num_threads(), mtx::thread_pool_c{}.get_num_threads());
+  EXPECT_LE(1u, mtx::thread_pool_c::default_num_threads());
+}
+
+TEST(ThreadPool, Results) {
+  mtx::thread_pool_c pool{4};
+  std::vector<std::future<int>> results;
+
+  for (auto idx = 0; idx < 100; ++idx)
+    results.emplace_back(pool.submit([idx]() { return idx * 2; }));
+
+  for (auto idx = 0; idx < 100; ++idx)
+    EXPECT_EQ(idx * 2, results[idx].get());
+}
+
+TEST(ThreadPool, Exceptions) {
+  mtx::thread_pool_c pool{2};
+
+  auto result = pool.submit([]() -> int { throw mtx::invalid_parameter_x{}; });
+
+  EXPECT_THROW(result.get(), mtx::invalid_parameter_x);
+}
+
+TEST(ThreadPool, RemainingTasksRunOnDestruction) {
+  std::atomic<int> num_run{};
+
+  {
+    mtx::thread_pool_c pool{1};
+
+    for (auto idx = 0; idx < 50; ++idx)
+      pool.submit([&num_run]() { ++num_run; });
+  }
+
+  EXPECT_EQ(50, num_run);
+}
+
+}
@@ -0,0 +1,136 @@
+#include "common/common_pch.h"
+
+#include "merge/cue_store.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+cue_point_t
+point(uint64_t timestamp,
+      uint32_t track_num,
+      uint64_t cluster_position,
+      uint64_t duration = 0) {
+  cue_point_t p;
+
+  p.timestamp         = timestamp;
+  p.track_num         = track_num;
+  p.cluster_position  = cluster_position;
+  p.duration          = duration;
+  p.relative_position = cluster_position % 1000;
+
+  return p;
+}
+
+std::vector<cue_point_t>
+read_all(cue_store_c &store) {
+  std::vector<cue_point_t> points;
+
+  store.seal_open_points();
+  store.for_each([&points](cue_point_t const &p) { points.push_back(p); });
+
+  return points;
+}
+
+void
+add_unsorted_points(cue_store_c &store) {
+  store.add(point(40, 1, 4000));
+  store.add(point(10, 2, 1100));
+  store.add(point(10, 1, 1000, 20));
+  store.seal_open_points_if_full();
+  store.add(point(30, 1, 3000));
+  store.add(point(20, 1, 2000));
+  store.add(point(10, 1, 1200));
+  store.seal_open_points_if_full();
+  store.add(point(50, 1, 500));
+}
+
+void
+expect_sorted_points(std::vector<cue_point_t> const &points) {
+  ASSERT_EQ(7u, points.size());
+
+  std::vector<std::pair<uint64_t, uint32_t>> expected_keys{ { 10, 1 }, { 10, 1 }, { 10, 2 }, { 20, 1 }, { 30, 1 }, { 40, 1 }, { 50, 1 } };
+  std::vector<uint64_t> expected_positions{ 1000, 1200, 1100, 2000, 3000, 4000, 500 };
+
+  for (auto idx = 0u; idx < points.size(); ++idx) {
+    EXPECT_EQ(expected_keys[idx].first,       points[idx].timestamp);
+    EXPECT_EQ(expected_keys[idx].second,      points[idx].track_num);
+    EXPECT_EQ(expected_positions[idx],        points[idx].cluster_position);
+    EXPECT_EQ(expected_positions[idx] % 1000, points[idx].relative_position);
+  }
+
+  EXPECT_EQ(20u, points[0].duration);
+  EXPECT_EQ(0u,  points[1].duration);
+}
+
+TEST(CueStore, SortsAndMergesRuns) {
+  cue_store_c store{3};
+
+  add_unsorted_points(store);
+
+  EXPECT_EQ(7u, store.size());
+  EXPECT_FALSE(store.has_spilled());
+
+  expect_sorted_points(read_all(store));
+}
+
+TEST(CueStore, SpillsToFile) {
+  cue_store_c store{3, 0};
+
+  add_unsorted_points(store);
+
+  EXPECT_TRUE(store.has_spilled());
+  EXPECT_EQ(0u, store.get_memory_usage());
+
+  expect_sorted_points(read_all(store));
+
+  // Reading twice must work as well.
+  expect_sorted_points(read_all(store));
+
+  store.clear();
+
+  EXPECT_TRUE(store.empty());
+  EXPECT_FALSE(store.has_spilled());
+}
+
+TEST(CueStore, LargeValues) {
+  cue_store_c store{2, 0};
+  auto big = std::numeric_limits<uint64_t>::max() - 1;
+
+  store.add(point(big, std::numeric_limits<uint32_t>::max(), big, big));
+  store.add(point(0, 0, 0));
+  store.add(point(1, 1, big));
+
+  auto points = read_all(store);
+
+  ASSERT_EQ(3u, points.size());
+  EXPECT_EQ(0u,                                   points[0].cluster_position);
+  EXPECT_EQ(big,                                  points[1].cluster_position);
+  EXPECT_EQ(big,                                  points[2].timestamp);
+  EXPECT_EQ(std::numeric_limits<uint32_t>::max(), points[2].track_num);
+  EXPECT_EQ(big,                                  points[2].duration);
+}
+
+TEST(CueStore, AdjustsPositions) {
+  cue_store_c store{2};
+
+  store.add(point(10, 1, 100));
+  store.add(point(20, 1, 200));
+  store.seal_open_points_if_full();
+
+  store.add(point(30, 1, 300));
+  store.adjust_positions(150, 10);
+
+  store.add(point(40, 1, 150));
+  store.adjust_positions(300, 5);
+
+  auto points = read_all(store);
+
+  ASSERT_EQ(4u, points.size());
+  EXPECT_EQ(100u, points[0].cluster_position);
+  EXPECT_EQ(210u, points[1].cluster_position);
+  EXPECT_EQ(315u, points[2].cluster_position);
+  EXPECT_EQ(150u, points[3].cluster_position);
+}
+
+}
@@ -0,0 +1,82 @@
+#include "common/common_pch.h"
+
+#include "common/mm_mem_io.h"
+#include "merge/probe_header.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+using ft = mtx::file_type_e;
+
+probe_header_c
+header_for(std::string const &content,
+           std::size_t size = probe_header_c::default_size) {
+  mm_mem_io_c in{reinterpret_cast<uint8_t const *>(content.c_str()), content.size()};
+  return probe_header_c{in, size};
+}
+
+TEST(ProbeHeader, Signatures) {
+  EXPECT_TRUE(header_for("\x1a\x45\xdf\xa3 rest"s).may_be(ft::matroska));
+  EXPECT_FALSE(header_for("\x1a\x45\xdf\xa4 rest"s).may_be(ft::matroska));
+
+  EXPECT_TRUE(header_for("RIFF\x10\x00\x00\x00" "AVI LIST"s).may_be(ft::avi));
+  EXPECT_TRUE(header_for("riff\x10\x00\x00\x00" "avi LIST"s).may_be(ft::avi));
+  EXPECT_FALSE(header_for("RIFF\x10\x00\x00\x00" "WAVEfmt "s).may_be(ft::avi));
+  EXPECT_TRUE(header_for("RIFF\x10\x00\x00\x00" "WAVEfmt "s).may_be(ft::wav));
+  EXPECT_TRUE(header_for("RF64\x10\x00\x00\x00" "WAVEfmt "s).may_be(ft::wav));
+  EXPECT_FALSE(header_for("OggS\x00\x02\x00\x00"s).may_be(ft::wav));
+
+  EXPECT_TRUE(header_for("CAFF\x00\x01"s).may_be(ft::coreaudio));
+  EXPECT_TRUE(header_for("OggS\x00\x02"s).may_be(ft::ogm));
+  EXPECT_TRUE(header_for("FLV\x01\x05"s).may_be(ft::flv));
+  EXPECT_TRUE(header_for("DKIF\x00\x00"s).may_be(ft::ivf));
+  EXPECT_TRUE(header_for(".RMF\x00\x00"s).may_be(ft::real));
+  EXPECT_TRUE(header_for("wvpk\x00\x00"s).may_be(ft::wavpack4));
+  EXPECT_TRUE(header_for("PG\x00\x00"s).may_be(ft::pgssup));
+  EXPECT_TRUE(header_for("TextST\x00\x00"s).may_be(ft::hdmv_textst));
+  EXPECT_TRUE(header_for("BBCD\x00\x00"s).may_be(ft::dirac));
+  EXPECT_TRUE(header_for("\x00\x00\x01\x0f\x00\x00"s).may_be(ft::vc1));
+  EXPECT_FALSE(header_for("\x00\x00\x01\xb3\x00\x00"s).may_be(ft::vc1));
+
+  for (auto type : { ft::avi, ft::coreaudio, ft::dirac, ft::flac, ft::flv, ft::hdmv_textst, ft::ivf, ft::matroska, ft::ogm, ft::pgssup, ft::qtmp4, ft::real, ft::tta, ft::vc1, ft::wav, ft::wavpack4 })
+    EXPECT_FALSE(header_for("\x47\x40\x00\x10\x00\x00\xb0\x0d"s).may_be(type));
+}
+
+TEST(ProbeHeader, TypesWithoutSignatures) {
+  for (auto type : { ft::aac, ft::ac3, ft::avc_es, ft::dts, ft::hevc_es, ft::mp3, ft::mpeg_es, ft::mpeg_ps, ft::mpeg_ts, ft::srt })
+    EXPECT_TRUE(header_for("\x47\x40\x00\x10\x00\x00\xb0\x0d"s).may_be(type));
+}
+
+TEST(ProbeHeader, Id3v2Tags) {
+  auto tag = "ID3\x04\x00\x00\x00\x00\x00\x05" "abcde"s;
+
+  EXPECT_TRUE(header_for(tag + "fLaC\x00\x00"s).may_be(ft::flac));
+  EXPECT_FALSE(header_for(tag + "fLaC\x00\x00"s).may_be(ft::tta));
+  EXPECT_TRUE(header_for(tag + "TTA1\x00\x00"s).may_be(ft::tta));
+  EXPECT_FALSE(header_for("fLaC"s).may_be(ft::tta));
+
+  // The tag reaches beyond the header: cannot be decided.
+  EXPECT_TRUE(header_for(tag + "ABCD\x00\x00"s, 12).may_be(ft::flac));
+}
+
+TEST(ProbeHeader, QuickTimeAtoms) {
+  EXPECT_TRUE(header_for("\x00\x00\x00\x18" "ftypisom"s).may_be(ft::qtmp4));
+  EXPECT_TRUE(header_for("\x00\x00\x00\x08" "wide" "\x00\x00\x00\x10" "mdat"s).may_be(ft::qtmp4));
+  EXPECT_FALSE(header_for("\x00\x00\x00\x08" "wide" "\x00\x00\x00\x10" "junk"s).may_be(ft::qtmp4));
+  EXPECT_FALSE(header_for("\x00\x00\x00\x08" "wide"s).may_be(ft::qtmp4));
+
+  // The atom chain leaves the header: cannot be decided.
+  EXPECT_TRUE(header_for("\x00\x00\x00\x08" "wide" "\x00\x00\x00\x10" "skip"s, 12).may_be(ft::qtmp4));
+}
+
+TEST(ProbeHeader, TruncatedHeaders) {
+  // Too short for the signature but more data in the file.
+  EXPECT_TRUE(header_for("\x1a\x45\xdf\xa3"s, 2).may_be(ft::matroska));
+
+  // The whole file is too short for the signature.
+  EXPECT_FALSE(header_for("\x1a\x45"s).may_be(ft::matroska));
+  EXPECT_FALSE(header_for(""s).may_be(ft::avi));
+}
+
+}
@@ -0,0 +1,51 @@
+#include "common/common_pch.h"
+
+#include <thread>
+
+#include "merge/timing_statistics.h"
+
+#include "tests/unit/init.h"
+
+namespace {
+
+namespace timing = mtx::timing_statistics;
+
+TEST(TimingStatistics, NestedTimers) {
+  timing::enable(fmt::format("{0}/mtx_unit_timing_statistics.json", ::testing::TempDir()));
+
+  auto outer = timing::create_stage("outer");
+  auto inner = timing::create_stage("inner", "file.mkv", "Matroska", "A_AAC", 2);
+
+  ASSERT_TRUE(!!outer);
+  ASSERT_TRUE(!!inner);
+
+  {
+    timing::timer_c outer_timer{outer.get()};
+    outer_timer.add_bytes(100);
+
+    for (int idx = 0; idx < 2; ++idx) {
+      timing::timer_c inner_timer{inner.get()};
+      inner_timer.add_packets(1);
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+  }
+
+  EXPECT_EQ(1u,   outer->m_calls.load());
+  EXPECT_EQ(100u, outer->m_bytes.load());
+  EXPECT_EQ(2u,   inner->m_calls.load());
+  EXPECT_EQ(2u,   inner->m_packets.load());
+
+  EXPECT_EQ(inner->m_total_ns.load(), inner->m_self_ns.load());
+  EXPECT_GE(inner->m_total_ns.load(), 4'000'000u);
+  EXPECT_GE(outer->m_total_ns.load(), inner->m_total_ns.load());
+  EXPECT_EQ(outer->m_total_ns.load() - inner->m_total_ns.load(), outer->m_self_ns.load());
+}
+
+TEST(TimingStatistics, NullStageDoesNothing) {
+  timing::timer_c timer{nullptr};
+
+  timer.add_bytes(1);
+  timer.add_packets(1);
+}
+
+}